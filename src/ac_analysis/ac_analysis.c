@@ -0,0 +1,168 @@
+/*
+ * Implementation for:
+ * Small-signal AC analysis for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "ac_analysis.h"
+#include <complex.h>
+#include <string.h>
+/*
+ * Locally used helper functions:
+ */
+
+void mcs_ac_values(mcs_spmat* G, mcs_spmat* C, double w,
+                   double _Complex* vals);
+long mcs_ac_fail(double _Complex* x, long dim);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Write the coordinate values of G + j*w*C, with the entries of G first.
+ */
+void mcs_ac_values(mcs_spmat* G, mcs_spmat* C, double w,
+                   double _Complex* vals){
+    long j;
+    for(j=0;j<G->nnz;j++){
+        vals[j] = G->dat[j];
+    }
+    for(j=0;j<C->nnz;j++){
+        vals[G->nnz+j] = I*w*C->dat[j];
+    }
+}
+
+/*
+ * Mark the solution x of a frequency which could not be solved by
+ * setting its dim entries to NaN. Returns 1.
+ */
+long mcs_ac_fail(double _Complex* x, long dim){
+    long i;
+    for(i=0;i<dim;i++){
+        x[i] = NAN;
+    }
+    return 1;
+}
+
+long mcs_ac_sweep(mcs_mna* M,
+                  double* x_op,
+                  long src,
+                  double f_start,
+                  double f_stop,
+                  long num_pts,
+                  double* freq,
+                  double _Complex* x_ac,
+                  mcs_status* st){
+    mcs_spmat *G, *C, *W;
+    mcs_splu_symbolic* S;
+    double* b;
+    double w_ref;
+    long j, k, nnz, num_fail = 0;
+    //the negated comparisons also reject NaN
+    if(!(f_start > 0.0) || !(f_stop >= f_start) || num_pts < 1
+       || src < 0 || src >= M->num_dev
+       || (M->dev[src]->elem.symbol != 'V'
+           && M->dev[src]->elem.symbol != 'I')){
+        mcs_raise(st,MCS_BAD_ARG);
+        return -1;
+    }
+    mcs_mna_alloc_G(M,&G);
+    mcs_mna_stamp_G(M,x_op,G->dat,NULL);
+    mcs_mna_alloc_C(M,&C);
+    b = (double*) malloc(sizeof(double)*(M->dim+1));
+    mcs_mna_unit_source(M,src,b);
+    for(k=0;k<num_pts;k++){
+        if(num_pts > 1){
+            freq[k] = f_start*pow(f_stop/f_start,((double) k)/(num_pts-1));
+        }else{
+            freq[k] = f_start;
+        }
+    }
+    //The pattern of G + j*w*C is G and C stacked together. Its pivot order
+    //is chosen with magnitudes at the geometric mean frequency.
+    nnz = G->nnz + C->nnz;
+    w_ref = 2.0*M_PI*sqrt(f_start*f_stop);
+    mcs_alloc_spmat(&W,nnz,M->dim,M->dim);
+    memcpy(W->r,G->r,sizeof(long)*G->nnz);
+    memcpy(W->c,G->c,sizeof(long)*G->nnz);
+    memcpy(&(W->r[G->nnz]),C->r,sizeof(long)*C->nnz);
+    memcpy(&(W->c[G->nnz]),C->c,sizeof(long)*C->nnz);
+    for(j=0;j<G->nnz;j++){
+        W->dat[j] = fabs(G->dat[j]);
+    }
+    for(j=0;j<C->nnz;j++){
+        W->dat[G->nnz+j] = w_ref*fabs(C->dat[j]);
+    }
+    if(mcs_splu_analyze_r(W,&S)){
+        //no pivot order exists at any frequency
+        for(k=0;k<num_pts;k++){
+            num_fail += mcs_ac_fail(&(x_ac[k*M->dim]),M->dim);
+        }
+        mcs_free_spmat(&W);
+        free(b);
+        mcs_free_spmat(&C);
+        mcs_free_spmat(&G);
+        return num_fail;
+    }
+    #pragma omp parallel private(j,k)
+    {
+        mcs_zsplu_numeric *N, *N_own;
+        mcs_splu_symbolic* S_own;
+        mcs_spmat* W_own;
+        mcs_zspmat* Y;
+        double _Complex* zb;
+        //Y = G + j*w*C on the pattern of W, one frequency at a time
+        mcs_alloc_zspmat(&Y,nnz,M->dim,M->dim);
+        memcpy(Y->r,W->r,sizeof(long)*nnz);
+        memcpy(Y->c,W->c,sizeof(long)*nnz);
+        zb = (double _Complex*) malloc(sizeof(double _Complex)*(M->dim+1));
+        for(j=0;j<M->dim;j++){
+            zb[j] = b[j];
+        }
+        mcs_alloc_zsplu(S,&N);
+        mcs_spmat_share(W,&W_own);
+        #pragma omp for schedule(dynamic) reduction(+:num_fail)
+        for(k=0;k<num_pts;k++){
+            mcs_ac_values(G,C,2.0*M_PI*freq[k],Y->dat);
+            if(mcs_zsplu_factor(N,Y->dat) == 0){
+                mcs_zsplu_solve(N,zb,&(x_ac[k*M->dim]));
+                continue;
+            }
+            //The shared pivot order is unstable at this frequency,
+            //so this frequency gets its own analysis.
+            for(j=0;j<nnz;j++){
+                W_own->dat[j] = cabs(Y->dat[j]);
+            }
+            if(mcs_splu_analyze_r(W_own,&S_own)){
+                num_fail += mcs_ac_fail(&(x_ac[k*M->dim]),M->dim);
+                continue;
+            }
+            mcs_alloc_zsplu(S_own,&N_own);
+            if(mcs_zsplu_factor(N_own,Y->dat) == 0){
+                mcs_zsplu_solve(N_own,zb,&(x_ac[k*M->dim]));
+            }else{
+                num_fail += mcs_ac_fail(&(x_ac[k*M->dim]),M->dim);
+            }
+            mcs_free_zsplu(&N_own);
+            mcs_free_splu_symbolic(&S_own);
+        }
+        mcs_free_spmat(&W_own);
+        mcs_free_zsplu(&N);
+        free(zb);
+        mcs_free_zspmat(&Y);
+    }
+    mcs_free_splu_symbolic(&S);
+    mcs_free_spmat(&W);
+    free(b);
+    mcs_free_spmat(&C);
+    mcs_free_spmat(&G);
+    return num_fail;
+}
@@ -0,0 +1,70 @@
+#ifndef MCS_AC_ANALYSIS_H
+#define MCS_AC_ANALYSIS_H
+
+/*
+ * Small-signal AC analysis for MicroCircSim by Bram Rodgers.
+ *
+ * The circuit is linearized at a DC operating point and the system
+ *      (G + j*w*C)*x = b
+ * is solved over a logarithmic sweep of frequencies, where b is a unit
+ * excitation of one voltage or current source.
+ *
+ * Every frequency has the same sparsity pattern, so one symbolic LU
+ * analysis is shared by all frequencies. Frequencies are split among
+ * OpenMP threads, each owning its own numeric factors.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../mna_system/mna_system.h"
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../sparse_lu/sparse_lu.h"
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Sweep num_pts frequencies spaced logarithmically from f_start to f_stop
+ * Hertz. The source at position src of M->dev is driven with a unit
+ * amplitude and all other sources are zeroed.
+ *
+ * x_op is the DC operating point at which nonlinear devices are linearized.
+ * If x_op is NULL then devices are linearized at x = 0.
+ *
+ * On exit freq[k] holds the k-th frequency and x_ac[k*M->dim + i] holds
+ * entry i of the complex solution at that frequency. freq has num_pts
+ * entries and x_ac has num_pts*M->dim entries.
+ *
+ * Returns the number of frequencies at which the system is singular.
+ * Their solutions are set to NaN, and the other frequencies are solved.
+ *
+ * If f_start is not positive, f_stop is below f_start, num_pts is less
+ * than 1, or src is not a voltage or current source of M, then nothing is
+ * solved, MCS_BAD_ARG is recorded in st, and -1 is returned. If st is
+ * NULL then mcs_error is called instead.
+ */
+long mcs_ac_sweep(mcs_mna* M,
+                  double* x_op,
+                  long src,
+                  double f_start,
+                  double f_stop,
+                  long num_pts,
+                  double* freq,
+                  double _Complex* x_ac,
+                  mcs_status* st);
+
+#endif
@@ -0,0 +1,235 @@
+/*
+ * Implementation for:
+ * Adjoint sensitivity analysis for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "adjoint_sens.h"
+#include <complex.h>
+#include <string.h>
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Return v[i], or 0 if i is ground.
+ */
+double mcs_adj_at(double* v, long i);
+
+/*
+ * Complex version of mcs_adj_at.
+ */
+double _Complex mcs_adj_zat(double _Complex* v, long i);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+double mcs_adj_at(double* v, long i){
+    if(i < 0){
+        return 0.0;
+    }
+    return v[i];
+}
+
+double _Complex mcs_adj_zat(double _Complex* v, long i){
+    if(i < 0){
+        return 0.0;
+    }
+    return v[i];
+}
+
+int mcs_alloc_adj(mcs_adj** A, mcs_mna* M, double* x, mcs_status* st){
+    mcs_adj* R;
+    mcs_spmat* J;
+    mcs_splu_symbolic* S;
+    mcs_mna_alloc_G(M,&J);
+    mcs_mna_stamp_G(M,x,J->dat,NULL);
+    if(mcs_splu_analyze_r(J,&S)){
+        mcs_free_spmat(&J);
+        return mcs_raise(st,MCS_SINGULAR_MATRIX);
+    }
+    R = (mcs_adj*) malloc(sizeof(mcs_adj));
+    R->M = M;
+    R->J = J;
+    R->S = S;
+    mcs_alloc_splu(S,&(R->N));
+    if(mcs_splu_factor(R->N,J->dat)){
+        //the pivot order was just chosen on these values
+        mcs_free_splu(&(R->N));
+        mcs_free_splu_symbolic(&S);
+        mcs_free_spmat(&J);
+        free(R);
+        return mcs_raise(st,MCS_SINGULAR_MATRIX);
+    }
+    R->x = (double*) malloc(sizeof(double)*(M->dim+1));
+    R->lambda = (double*) malloc(sizeof(double)*(M->dim+1));
+    memcpy(R->x,x,sizeof(double)*M->dim);
+    R->num_solve = 0;
+    *A = R;
+    return 0;
+}
+
+void mcs_free_adj(mcs_adj** A){
+    free((*A)->lambda);
+    free((*A)->x);
+    mcs_free_splu(&((*A)->N));
+    mcs_free_splu_symbolic(&((*A)->S));
+    mcs_free_spmat(&((*A)->J));
+    free(*A);
+    *A = NULL;
+}
+
+void mcs_adj_dc(mcs_adj* A, long out, double* sens){
+    mcs_mna* M = A->M;
+    double* lam = A->lambda;
+    double* x = A->x;
+    long k, p, n;
+    double dv, dl;
+    for(k=0;k<M->dim;k++){
+        lam[k] = 0.0;
+    }
+    lam[out] = 1.0;
+    mcs_splu_tsolve(A->N,lam,lam);
+    A->num_solve++;
+    //dF/dp only has entries at the nodes and branch of element k
+    for(k=0;k<M->num_dev;k++){
+        p = M->term[3*k];
+        n = M->term[3*k+1];
+        switch(M->dev[k]->elem.symbol){
+            case 'V'://F has -volt in the branch row
+                sens[k] = lam[M->branch[k]];
+                break;
+            case 'I'://F has +amp at node_pos and -amp at node_neg
+                sens[k] = mcs_adj_at(lam,n) - mcs_adj_at(lam,p);
+                break;
+            case 'R'://F has (v_pos - v_neg)/ohm at node_pos, minus at neg
+                dv = mcs_adj_at(x,p) - mcs_adj_at(x,n);
+                dl = mcs_adj_at(lam,p) - mcs_adj_at(lam,n);
+                sens[k] = dl*dv/(M->val[k]*M->val[k]);
+                break;
+            default://C, L, and devices without a value
+                sens[k] = 0.0;
+                break;
+        }
+    }
+}
+
+int mcs_adj_ac(mcs_mna* M,
+               double* x_op,
+               long src,
+               double f,
+               long num_out,
+               long* out,
+               double _Complex* sens,
+               mcs_status* st){
+    mcs_spmat *G, *C, *W;
+    mcs_splu_symbolic* S;
+    mcs_zsplu_numeric* N;
+    double _Complex *vals, *x, *lam, *row;
+    double _Complex dv, dl;
+    double* b;
+    double w = 2.0*M_PI*f;
+    long j, k, o, p, n, br, nnz;
+    mcs_mna_alloc_G(M,&G);
+    mcs_mna_stamp_G(M,x_op,G->dat,NULL);
+    mcs_mna_alloc_C(M,&C);
+    //G + j*w*C is G and C stacked together, as in mcs_ac_sweep.
+    nnz = G->nnz + C->nnz;
+    mcs_alloc_spmat(&W,nnz,M->dim,M->dim);
+    memcpy(W->r,G->r,sizeof(long)*G->nnz);
+    memcpy(W->c,G->c,sizeof(long)*G->nnz);
+    memcpy(&(W->r[G->nnz]),C->r,sizeof(long)*C->nnz);
+    memcpy(&(W->c[G->nnz]),C->c,sizeof(long)*C->nnz);
+    vals = (double _Complex*) malloc(sizeof(double _Complex)*(nnz+1));
+    for(j=0;j<G->nnz;j++){
+        vals[j] = G->dat[j];
+        W->dat[j] = fabs(G->dat[j]);
+    }
+    for(j=0;j<C->nnz;j++){
+        vals[G->nnz+j] = I*w*C->dat[j];
+        W->dat[G->nnz+j] = w*fabs(C->dat[j]);
+    }
+    mcs_free_spmat(&C);
+    mcs_free_spmat(&G);
+    if(mcs_splu_analyze_r(W,&S)){
+        mcs_free_spmat(&W);
+        free(vals);
+        return mcs_raise(st,MCS_SINGULAR_MATRIX);
+    }
+    mcs_alloc_zsplu(S,&N);
+    if(mcs_zsplu_factor(N,vals)){
+        //pick the pivot order again on the complex magnitudes, as the
+        //fallback of mcs_ac_sweep does
+        mcs_free_zsplu(&N);
+        mcs_free_splu_symbolic(&S);
+        for(j=0;j<nnz;j++){
+            W->dat[j] = cabs(vals[j]);
+        }
+        if(mcs_splu_analyze_r(W,&S)){
+            mcs_free_spmat(&W);
+            free(vals);
+            return mcs_raise(st,MCS_SINGULAR_MATRIX);
+        }
+        mcs_alloc_zsplu(S,&N);
+        if(mcs_zsplu_factor(N,vals)){
+            mcs_free_zsplu(&N);
+            mcs_free_splu_symbolic(&S);
+            mcs_free_spmat(&W);
+            free(vals);
+            return mcs_raise(st,MCS_SINGULAR_MATRIX);
+        }
+    }
+    b = (double*) malloc(sizeof(double)*(M->dim+1));
+    x = (double _Complex*) malloc(sizeof(double _Complex)*(M->dim+1));
+    lam = (double _Complex*) malloc(sizeof(double _Complex)*(M->dim+1));
+    mcs_mna_unit_source(M,src,b);
+    for(j=0;j<M->dim;j++){
+        x[j] = b[j];
+    }
+    mcs_zsplu_solve(N,x,x);
+    for(o=0;o<num_out;o++){
+        for(j=0;j<M->dim;j++){
+            lam[j] = 0.0;
+        }
+        lam[out[o]] = 1.0;
+        mcs_zsplu_tsolve(N,lam,lam);
+        row = &(sens[o*M->num_dev]);
+        for(k=0;k<M->num_dev;k++){
+            p = M->term[3*k];
+            n = M->term[3*k+1];
+            dv = mcs_adj_zat(x,p) - mcs_adj_zat(x,n);
+            dl = mcs_adj_zat(lam,p) - mcs_adj_zat(lam,n);
+            switch(M->dev[k]->elem.symbol){
+                case 'R':
+                    row[k] = dl*dv/(M->val[k]*M->val[k]);
+                    break;
+                case 'C':
+                    row[k] = -I*w*dl*dv;
+                    break;
+                case 'L'://the branch row has -j*w*henry on the diagonal
+                    br = M->branch[k];
+                    row[k] = I*w*lam[br]*x[br];
+                    break;
+                default:
+                    row[k] = 0.0;
+                    break;
+            }
+        }
+    }
+    free(lam);
+    free(x);
+    free(b);
+    mcs_free_zsplu(&N);
+    mcs_free_splu_symbolic(&S);
+    mcs_free_spmat(&W);
+    free(vals);
+    return 0;
+}
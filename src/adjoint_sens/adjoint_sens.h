@@ -0,0 +1,104 @@
+#ifndef MCS_ADJOINT_SENS_H
+#define MCS_ADJOINT_SENS_H
+
+/*
+ * Adjoint sensitivity analysis for MicroCircSim by Bram Rodgers.
+ * Based on ``The Generalized Adjoint Network and Network Sensitivities''
+ * by S. W. Director and R. A. Rohrer.
+ *
+ * At a DC operating point x the circuit equations F(x,p) = 0 hold for
+ * every element value p, so an output y = x[out] has the derivatives
+ *      dy/dp = -lambda^T * dF/dp,      where J^T * lambda = e_out,
+ * and J is the Jacobian of F at x. One transpose solve gives the
+ * derivative of y with respect to the value of every element at once,
+ * where finite differences would need one solve per element. Each
+ * element only touches the entries of lambda and x at its own nodes, so
+ * the derivatives cost time linear in the size of the circuit.
+ *
+ * The transpose solve reuses the LU factors of J, see mcs_splu_tsolve.
+ *
+ * The derivatives are with respect to the values in M->val, which are
+ * ohm, volt, amp, farad, or henry. At DC capacitors are open and
+ * inductors are shorts, so their derivatives are zero there. The small
+ * signal sensitivities of mcs_adj_ac give those, at one frequency.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../error_handling/error_handling.h"
+#include"../mna_system/mna_system.h"
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../sparse_lu/sparse_lu.h"
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * DC sensitivities of a circuit about one operating point.
+ */
+typedef struct _mcs_adj{
+    mcs_mna* M;                 /*The circuit*/
+    double* x;                  /*Operating point, M->dim entries*/
+    mcs_spmat* J;               /*Jacobian at x*/
+    mcs_splu_symbolic* S;       /*Symbolic analysis of J*/
+    mcs_splu_numeric* N;        /*Numeric factors of J*/
+    double* lambda;             /*Adjoint solution of the last output*/
+    long num_solve;             /*Transpose solves so far*/
+} mcs_adj;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Factor the Jacobian of M at the operating point x, which is copied,
+ * for the sensitivities of any number of outputs. Returns 0, or 1 after
+ * recording MCS_SINGULAR_MATRIX in st with nothing allocated.
+ */
+int mcs_alloc_adj(mcs_adj** A, mcs_mna* M, double* x, mcs_status* st);
+
+/*
+ * Free the factors and copies held by A. M is not freed.
+ */
+void mcs_free_adj(mcs_adj** A);
+
+/*
+ * Write into sens[k] the derivative of x[out] with respect to M->val[k],
+ * for every element k. sens has M->num_dev entries. Costs one transpose
+ * solve, and leaves the adjoint solution in A->lambda.
+ */
+void mcs_adj_dc(mcs_adj* A, long out, double* sens);
+
+/*
+ * Small signal sensitivities at f Hertz about the operating point x_op,
+ * with the source at position src of M->dev driven as in mcs_ac_sweep.
+ * x_op may be NULL as in mcs_ac_sweep.
+ *
+ * For each of the num_out unknowns out[o], sens[o*M->num_dev + k] gets
+ * the derivative of that entry of the complex solution with respect to
+ * M->val[k], with x_op held fixed. Source values are zero, since the
+ * driven source has a unit amplitude. Costs one factorization and solve,
+ * and one transpose solve per output.
+ *
+ * Returns 0, or 1 after recording MCS_SINGULAR_MATRIX in st.
+ */
+int mcs_adj_ac(mcs_mna* M,
+               double* x_op,
+               long src,
+               double f,
+               long num_out,
+               long* out,
+               double _Complex* sens,
+               mcs_status* st);
+
+#endif
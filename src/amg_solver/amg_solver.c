@@ -0,0 +1,623 @@
+/*
+ * Implementation for:
+ * Algebraic multigrid preconditioned conjugate gradients for symmetric
+ * positive definite circuit matrices by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "amg_solver.h"
+/*
+ * Locally used helper functions:
+ */
+
+void mcs_amg_transpose(mcs_csr* A, mcs_csr** T);
+void mcs_amg_matmul(mcs_csr* A, mcs_csr* B, mcs_csr** C);
+long mcs_amg_aggregate(mcs_csr* A, double* d, long* agg);
+void mcs_amg_setup_level(mcs_amg_level* lev, mcs_csr* A);
+void mcs_amg_matvec(mcs_csr* A, double* x, double* y);
+void mcs_amg_residual(mcs_csr* A, double* x, double* b, double* r);
+void mcs_amg_cycle(mcs_amg* H, long l);
+double mcs_amg_dot(long n, double* x, double* y);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+void mcs_amg_csr(mcs_spmat* A, mcs_csr** C){
+    long n = A->r_len;
+    long i, k, t, slot;
+    long* pos = (long*) malloc(sizeof(long)*(A->c_len+1));
+    long* cnt = (long*) malloc(sizeof(long)*(n+1));
+    long* ent = (long*) malloc(sizeof(long)*(A->nnz+1));
+    mcs_csr* B = (mcs_csr*) malloc(sizeof(mcs_csr));
+    B->n = n;
+    B->m = A->c_len;
+    B->p = (long*) malloc(sizeof(long)*(n+1));
+    B->j = (long*) malloc(sizeof(long)*(A->nnz+1));
+    B->x = (double*) malloc(sizeof(double)*(A->nnz+1));
+    //bucket the coordinate entries by row
+    for(i=0;i<=n;i++){
+        cnt[i] = 0;
+    }
+    for(k=0;k<A->nnz;k++){
+        cnt[A->r[k]+1]++;
+    }
+    for(i=0;i<n;i++){
+        cnt[i+1] += cnt[i];
+    }
+    for(k=0;k<A->nnz;k++){
+        ent[cnt[A->r[k]]++] = k;
+    }
+    for(i=0;i<B->m;i++){
+        pos[i] = -1;
+    }
+    //each row now ends at cnt[i]. Merge the duplicates of each row.
+    B->p[0] = 0;
+    slot = 0;
+    t = 0;
+    for(i=0;i<n;i++){
+        for(;t<cnt[i];t++){
+            k = ent[t];
+            if(pos[A->c[k]] < B->p[i]){
+                pos[A->c[k]] = slot;
+                B->j[slot] = A->c[k];
+                B->x[slot] = A->dat[k];
+                slot++;
+            }else{
+                B->x[pos[A->c[k]]] += A->dat[k];
+            }
+        }
+        B->p[i+1] = slot;
+    }
+    free(pos);
+    free(cnt);
+    free(ent);
+    *C = B;
+}
+
+void mcs_free_csr(mcs_csr** C){
+    free((*C)->p);
+    free((*C)->j);
+    free((*C)->x);
+    free(*C);
+    *C = NULL;
+}
+
+/*
+ * Write the transpose of A into a newly allocated matrix T.
+ */
+void mcs_amg_transpose(mcs_csr* A, mcs_csr** T){
+    long i, k, s;
+    long nnz = A->p[A->n];
+    long* cnt = (long*) malloc(sizeof(long)*(A->m+1));
+    mcs_csr* B = (mcs_csr*) malloc(sizeof(mcs_csr));
+    B->n = A->m;
+    B->m = A->n;
+    B->p = (long*) malloc(sizeof(long)*(B->n+1));
+    B->j = (long*) malloc(sizeof(long)*(nnz+1));
+    B->x = (double*) malloc(sizeof(double)*(nnz+1));
+    for(i=0;i<=B->n;i++){
+        B->p[i] = 0;
+    }
+    for(k=0;k<nnz;k++){
+        B->p[A->j[k]+1]++;
+    }
+    for(i=0;i<B->n;i++){
+        B->p[i+1] += B->p[i];
+        cnt[i] = B->p[i];
+    }
+    for(i=0;i<A->n;i++){
+        for(k=A->p[i];k<A->p[i+1];k++){
+            s = cnt[A->j[k]]++;
+            B->j[s] = i;
+            B->x[s] = A->x[k];
+        }
+    }
+    free(cnt);
+    *T = B;
+}
+
+/*
+ * Write the product A*B into a newly allocated matrix C. The pattern is
+ * counted first so that C is allocated once.
+ */
+void mcs_amg_matmul(mcs_csr* A, mcs_csr* B, mcs_csr** C){
+    long i, j, k, t, nnz;
+    long* mark = (long*) malloc(sizeof(long)*(B->m+1));
+    double* w = (double*) malloc(sizeof(double)*(B->m+1));
+    mcs_csr* P = (mcs_csr*) malloc(sizeof(mcs_csr));
+    P->n = A->n;
+    P->m = B->m;
+    P->p = (long*) malloc(sizeof(long)*(A->n+1));
+    for(j=0;j<B->m;j++){
+        mark[j] = -1;
+    }
+    //count the entries of each row of C
+    nnz = 0;
+    for(i=0;i<A->n;i++){
+        P->p[i] = nnz;
+        for(k=A->p[i];k<A->p[i+1];k++){
+            for(t=B->p[A->j[k]];t<B->p[A->j[k]+1];t++){
+                if(mark[B->j[t]] != i){
+                    mark[B->j[t]] = i;
+                    nnz++;
+                }
+            }
+        }
+    }
+    P->p[A->n] = nnz;
+    P->j = (long*) malloc(sizeof(long)*(nnz+1));
+    P->x = (double*) malloc(sizeof(double)*(nnz+1));
+    for(j=0;j<B->m;j++){
+        mark[j] = -1;
+    }
+    //accumulate each row of C in w
+    nnz = 0;
+    for(i=0;i<A->n;i++){
+        for(k=A->p[i];k<A->p[i+1];k++){
+            for(t=B->p[A->j[k]];t<B->p[A->j[k]+1];t++){
+                j = B->j[t];
+                if(mark[j] != i){
+                    mark[j] = i;
+                    P->j[nnz++] = j;
+                    w[j] = 0.0;
+                }
+                w[j] += A->x[k]*B->x[t];
+            }
+        }
+        for(t=P->p[i];t<nnz;t++){
+            P->x[t] = w[P->j[t]];
+        }
+    }
+    free(mark);
+    free(w);
+    *C = P;
+}
+
+int mcs_amg_is_spd(mcs_spmat* A){
+    mcs_csr* C;
+    mcs_csr* T;
+    long i, k;
+    long* mark;
+    double* w;
+    double diag, off;
+    int spd = 1;
+    if(A->r_len != A->c_len){
+        return 0;
+    }
+    mcs_amg_csr(A,&C);
+    mcs_amg_transpose(C,&T);
+    mark = (long*) malloc(sizeof(long)*(C->n+1));
+    w = (double*) malloc(sizeof(double)*(C->n+1));
+    for(i=0;i<C->n;i++){
+        mark[i] = -1;
+    }
+    for(i=0;i<C->n && spd;i++){
+        diag = 0.0;
+        off = 0.0;
+        for(k=C->p[i];k<C->p[i+1];k++){
+            mark[C->j[k]] = i;
+            w[C->j[k]] = C->x[k];
+            if(C->j[k] == i){
+                diag = C->x[k];
+            }else{
+                off += fabs(C->x[k]);
+            }
+        }
+        if(diag <= 0.0 || off > diag*(1.0+1.0e-12)){
+            spd = 0;
+        }
+        //row i of the transpose is column i of C
+        for(k=T->p[i];k<T->p[i+1];k++){
+            if(mark[T->j[k]] == i){
+                w[T->j[k]] -= T->x[k];
+            }else if(T->x[k] != 0.0){
+                spd = 0;
+            }
+        }
+        for(k=C->p[i];k<C->p[i+1];k++){
+            if(fabs(w[C->j[k]]) > 1.0e-12*fabs(C->x[k])){
+                spd = 0;
+            }
+        }
+    }
+    free(mark);
+    free(w);
+    mcs_free_csr(&C);
+    mcs_free_csr(&T);
+    return spd;
+}
+
+/*
+ * Group the unknowns of A into aggregates. d holds the diagonal of A.
+ * agg[i] gets the aggregate of unknown i. Returns the number of aggregates.
+ *
+ * Pass 1 makes an aggregate of each unknown whose strong neighbors are all
+ * free. Pass 2 attaches leftover unknowns to a neighboring pass 1
+ * aggregate. Pass 3 makes aggregates out of whatever remains.
+ */
+long mcs_amg_aggregate(mcs_csr* A, double* d, long* agg){
+    long i, j, k, na = 0;
+    long n = A->n;
+    long* first = (long*) malloc(sizeof(long)*(n+1));
+    char* strong = (char*) malloc(sizeof(char)*(A->p[n]+1));
+    int free_nbr;
+    for(i=0;i<n;i++){
+        agg[i] = -1;
+        for(k=A->p[i];k<A->p[i+1];k++){
+            j = A->j[k];
+            strong[k] = (j != i && fabs(A->x[k]) >=
+                            MCS_AMG_THETA*sqrt(fabs(d[i]*d[j])));
+        }
+    }
+    for(i=0;i<n;i++){
+        if(agg[i] >= 0){
+            continue;
+        }
+        free_nbr = 0;
+        for(k=A->p[i];k<A->p[i+1];k++){
+            if(strong[k]){
+                if(agg[A->j[k]] >= 0){
+                    break;
+                }
+                free_nbr = 1;
+            }
+        }
+        if(k < A->p[i+1] || !free_nbr){
+            continue;
+        }
+        agg[i] = na;
+        for(k=A->p[i];k<A->p[i+1];k++){
+            if(strong[k]){
+                agg[A->j[k]] = na;
+            }
+        }
+        na++;
+    }
+    //remember the pass 1 result so that pass 2 does not chain
+    for(i=0;i<n;i++){
+        first[i] = agg[i];
+    }
+    for(i=0;i<n;i++){
+        if(agg[i] >= 0){
+            continue;
+        }
+        for(k=A->p[i];k<A->p[i+1];k++){
+            if(strong[k] && first[A->j[k]] >= 0){
+                agg[i] = first[A->j[k]];
+                break;
+            }
+        }
+    }
+    for(i=0;i<n;i++){
+        if(agg[i] >= 0){
+            continue;
+        }
+        agg[i] = na;
+        for(k=A->p[i];k<A->p[i+1];k++){
+            if(strong[k] && agg[A->j[k]] < 0){
+                agg[A->j[k]] = na;
+            }
+        }
+        na++;
+    }
+    free(first);
+    free(strong);
+    return na;
+}
+
+/*
+ * Fill in the smoother and workspace of a level with the matrix A.
+ * The Jacobi weight 4/(3*rho) uses the Gershgorin bound rho of the
+ * spectral radius of inv(D)*A.
+ */
+void mcs_amg_setup_level(mcs_amg_level* lev, mcs_csr* A){
+    long i, k;
+    double rho = 0.0, s, d;
+    lev->A = A;
+    lev->P = NULL;
+    lev->R = NULL;
+    lev->dinv = (double*) malloc(sizeof(double)*(A->n+1));
+    lev->x = (double*) malloc(sizeof(double)*(A->n+1));
+    lev->b = (double*) malloc(sizeof(double)*(A->n+1));
+    lev->r = (double*) malloc(sizeof(double)*(A->n+1));
+    for(i=0;i<A->n;i++){
+        s = 0.0;
+        d = 0.0;
+        for(k=A->p[i];k<A->p[i+1];k++){
+            s += fabs(A->x[k]);
+            if(A->j[k] == i){
+                d = A->x[k];
+            }
+        }
+        lev->dinv[i] = 1.0/d;
+        if(s/d > rho){
+            rho = s/d;
+        }
+    }
+    for(i=0;i<A->n;i++){
+        lev->dinv[i] *= 4.0/(3.0*rho);
+    }
+}
+
+int mcs_alloc_amg(mcs_spmat* A, mcs_amg** H, mcs_status* st){
+    mcs_amg* G = (mcs_amg*) malloc(sizeof(mcs_amg));
+    mcs_amg_level* lev;
+    mcs_csr* T;
+    mcs_csr* AP;
+    mcs_csr* Ac;
+    long* agg;
+    double* d;
+    double* w;
+    long i, k, n, na;
+    G->lev = (mcs_amg_level*) malloc(sizeof(mcs_amg_level)*MCS_AMG_MAX_LEVEL);
+    G->num_level = 1;
+    mcs_amg_csr(A,&Ac);
+    mcs_amg_setup_level(&(G->lev[0]),Ac);
+    while(G->num_level < MCS_AMG_MAX_LEVEL){
+        lev = &(G->lev[G->num_level-1]);
+        n = lev->A->n;
+        if(n <= MCS_AMG_COARSE){
+            break;
+        }
+        agg = (long*) malloc(sizeof(long)*(n+1));
+        d = (double*) malloc(sizeof(double)*(n+1));
+        w = (double*) malloc(sizeof(double)*(n+1));
+        for(i=0;i<n;i++){
+            d[i] = 0.0;
+            for(k=lev->A->p[i];k<lev->A->p[i+1];k++){
+                if(lev->A->j[k] == i){
+                    d[i] = lev->A->x[k];
+                }
+            }
+        }
+        na = mcs_amg_aggregate(lev->A,d,agg);
+        if(na > 0.9*n){
+            //coarsening has stalled, so solve this level directly
+            free(agg);
+            free(d);
+            free(w);
+            break;
+        }
+        //tentative prolongation, constant on each aggregate
+        T = (mcs_csr*) malloc(sizeof(mcs_csr));
+        T->n = n;
+        T->m = na;
+        T->p = (long*) malloc(sizeof(long)*(n+1));
+        T->j = (long*) malloc(sizeof(long)*(n+1));
+        T->x = (double*) malloc(sizeof(double)*(n+1));
+        for(i=0;i<na;i++){
+            w[i] = 0.0;
+        }
+        for(i=0;i<n;i++){
+            w[agg[i]] += 1.0;
+        }
+        for(i=0;i<n;i++){
+            T->p[i] = i;
+            T->j[i] = agg[i];
+            T->x[i] = 1.0/sqrt(w[agg[i]]);
+        }
+        T->p[n] = n;
+        //smooth it: P = T - omega*inv(D)*A*T
+        mcs_amg_matmul(lev->A,T,&(lev->P));
+        for(i=0;i<n;i++){
+            for(k=lev->P->p[i];k<lev->P->p[i+1];k++){
+                lev->P->x[k] *= -lev->dinv[i];
+                if(lev->P->j[k] == agg[i]){
+                    lev->P->x[k] += T->x[i];
+                }
+            }
+        }
+        mcs_free_csr(&T);
+        mcs_amg_transpose(lev->P,&(lev->R));
+        mcs_amg_matmul(lev->A,lev->P,&AP);
+        mcs_amg_matmul(lev->R,AP,&Ac);
+        mcs_free_csr(&AP);
+        mcs_amg_setup_level(&(G->lev[G->num_level]),Ac);
+        G->num_level++;
+        free(agg);
+        free(d);
+        free(w);
+    }
+    //factor the coarsest level
+    Ac = G->lev[G->num_level-1].A;
+    mcs_alloc_spmat(&(G->A_c),Ac->p[Ac->n],Ac->n,Ac->n);
+    for(i=0;i<Ac->n;i++){
+        for(k=Ac->p[i];k<Ac->p[i+1];k++){
+            G->A_c->r[k] = i;
+            G->A_c->c[k] = Ac->j[k];
+            G->A_c->dat[k] = Ac->x[k];
+        }
+    }
+    G->N = NULL;
+    G->work = (double*) malloc(sizeof(double)*(3*G->lev[0].A->n+1));
+    if(mcs_splu_analyze_r(G->A_c,&(G->S)) == 0){
+        mcs_alloc_splu(G->S,&(G->N));
+        if(mcs_splu_factor(G->N,G->A_c->dat) == 0){
+            *H = G;
+            return 0;
+        }
+    }
+    //A was not positive definite after all
+    mcs_free_amg(&G);
+    *H = NULL;
+    return mcs_raise(st,MCS_SINGULAR_MATRIX);
+}
+
+void mcs_free_amg(mcs_amg** H){
+    long l;
+    mcs_amg_level* lev;
+    for(l=0;l<(*H)->num_level;l++){
+        lev = &((*H)->lev[l]);
+        mcs_free_csr(&(lev->A));
+        if(lev->P != NULL){
+            mcs_free_csr(&(lev->P));
+            mcs_free_csr(&(lev->R));
+        }
+        free(lev->dinv);
+        free(lev->x);
+        free(lev->b);
+        free(lev->r);
+    }
+    if((*H)->N != NULL){
+        mcs_free_splu(&((*H)->N));
+    }
+    if((*H)->S != NULL){
+        mcs_free_splu_symbolic(&((*H)->S));
+    }
+    mcs_free_spmat(&((*H)->A_c));
+    free((*H)->lev);
+    free((*H)->work);
+    free(*H);
+    *H = NULL;
+}
+
+/*
+ * y = A*x
+ */
+void mcs_amg_matvec(mcs_csr* A, double* x, double* y){
+    long i, k;
+    double s;
+    #pragma omp parallel for private(k,s) schedule(static)
+    for(i=0;i<A->n;i++){
+        s = 0.0;
+        for(k=A->p[i];k<A->p[i+1];k++){
+            s += A->x[k]*x[A->j[k]];
+        }
+        y[i] = s;
+    }
+    MCS_PROF_COUNT(MCS_PROF_MATVECS,1);
+}
+
+/*
+ * r = b - A*x
+ */
+void mcs_amg_residual(mcs_csr* A, double* x, double* b, double* r){
+    long i, k;
+    double s;
+    #pragma omp parallel for private(k,s) schedule(static)
+    for(i=0;i<A->n;i++){
+        s = b[i];
+        for(k=A->p[i];k<A->p[i+1];k++){
+            s -= A->x[k]*x[A->j[k]];
+        }
+        r[i] = s;
+    }
+    MCS_PROF_COUNT(MCS_PROF_MATVECS,1);
+}
+
+/*
+ * Apply one V-cycle starting at level l to lev[l].b, writing lev[l].x.
+ */
+void mcs_amg_cycle(mcs_amg* H, long l){
+    mcs_amg_level* lev = &(H->lev[l]);
+    mcs_amg_level* crs;
+    long i, k, s;
+    double v;
+    if(l == H->num_level-1){
+        mcs_splu_solve(H->N,lev->b,lev->x);
+        return;
+    }
+    crs = &(H->lev[l+1]);
+    //the first sweep from a zero guess is x = omega*inv(D)*b
+    #pragma omp parallel for schedule(static)
+    for(i=0;i<lev->A->n;i++){
+        lev->x[i] = lev->dinv[i]*lev->b[i];
+    }
+    for(s=1;s<2*MCS_AMG_SWEEPS;s++){
+        if(s == MCS_AMG_SWEEPS){
+            //restrict the residual and correct from the coarse level
+            mcs_amg_residual(lev->A,lev->x,lev->b,lev->r);
+            #pragma omp parallel for private(k,v) schedule(static)
+            for(i=0;i<crs->A->n;i++){
+                v = 0.0;
+                for(k=lev->R->p[i];k<lev->R->p[i+1];k++){
+                    v += lev->R->x[k]*lev->r[lev->R->j[k]];
+                }
+                crs->b[i] = v;
+            }
+            mcs_amg_cycle(H,l+1);
+            #pragma omp parallel for private(k,v) schedule(static)
+            for(i=0;i<lev->A->n;i++){
+                v = 0.0;
+                for(k=lev->P->p[i];k<lev->P->p[i+1];k++){
+                    v += lev->P->x[k]*crs->x[lev->P->j[k]];
+                }
+                lev->x[i] += v;
+            }
+        }
+        mcs_amg_residual(lev->A,lev->x,lev->b,lev->r);
+        #pragma omp parallel for schedule(static)
+        for(i=0;i<lev->A->n;i++){
+            lev->x[i] += lev->dinv[i]*lev->r[i];
+        }
+    }
+}
+
+double mcs_amg_dot(long n, double* x, double* y){
+    long i;
+    double s = 0.0;
+    #pragma omp parallel for reduction(+:s) schedule(static)
+    for(i=0;i<n;i++){
+        s += x[i]*y[i];
+    }
+    MCS_PROF_COUNT(MCS_PROF_DOTS,1);
+    return s;
+}
+
+long mcs_amg_pcg(mcs_amg* H, double* b, double* x, double tol,
+                 long max_iter){
+    mcs_csr* A = H->lev[0].A;
+    long n = A->n;
+    long i, iter;
+    double* r = H->work;
+    double* p = &(H->work[n]);
+    double* q = &(H->work[2*n]);
+    double* z = H->lev[0].x;
+    double bnrm, rz, rz_new, alpha, beta;
+    bnrm = sqrt(mcs_amg_dot(n,b,b));
+    mcs_amg_residual(A,x,b,r);
+    if(sqrt(mcs_amg_dot(n,r,r)) <= tol*bnrm){
+        return 0;
+    }
+    for(i=0;i<n;i++){
+        H->lev[0].b[i] = r[i];
+    }
+    mcs_amg_cycle(H,0);
+    for(i=0;i<n;i++){
+        p[i] = z[i];
+    }
+    rz = mcs_amg_dot(n,r,z);
+    for(iter=1;iter<=max_iter;iter++){
+        MCS_PROF_COUNT(MCS_PROF_ITERS,1);
+        mcs_amg_matvec(A,p,q);
+        alpha = rz/mcs_amg_dot(n,p,q);
+        #pragma omp parallel for schedule(static)
+        for(i=0;i<n;i++){
+            x[i] += alpha*p[i];
+            r[i] -= alpha*q[i];
+        }
+        if(sqrt(mcs_amg_dot(n,r,r)) <= tol*bnrm){
+            return iter;
+        }
+        for(i=0;i<n;i++){
+            H->lev[0].b[i] = r[i];
+        }
+        mcs_amg_cycle(H,0);
+        rz_new = mcs_amg_dot(n,r,z);
+        beta = rz_new/rz;
+        rz = rz_new;
+        #pragma omp parallel for schedule(static)
+        for(i=0;i<n;i++){
+            p[i] = z[i] + beta*p[i];
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,150 @@
+#ifndef MCS_AMG_SOLVER_H
+#define MCS_AMG_SOLVER_H
+
+/*
+ * Algebraic multigrid preconditioned conjugate gradients for symmetric
+ * positive definite circuit matrices by Bram Rodgers.
+ *
+ * Networks of resistors and current sources have a conductance matrix
+ * which is symmetric positive definite. For those, conjugate gradients
+ * needs one matrix vector product per iteration, and a multigrid
+ * preconditioner keeps the iteration count nearly independent of size.
+ *
+ * The preconditioner is smoothed aggregation multigrid:
+ * ->Unknowns are grouped into aggregates of strongly connected
+ *   neighbors. Unknown i is strongly connected to j when
+ *      |a_ij| >= MCS_AMG_THETA*sqrt(a_ii*a_jj).
+ * ->The tentative prolongation is constant on each aggregate, and is
+ *   smoothed with one step of damped Jacobi.
+ * ->Coarse matrices are the Galerkin products P^T*A*P, down to at most
+ *   MCS_AMG_COARSE unknowns, which are solved with sparse_lu.
+ * ->One V-cycle with damped Jacobi smoothing is applied per iteration.
+ *   Jacobi makes the V-cycle symmetric, and runs in parallel.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../sparse_lu/sparse_lu.h"
+#include"../profiling/profiling.h"
+
+/*
+ * Strength of connection threshold.
+ */
+#define MCS_AMG_THETA       0.08
+/*
+ * Largest matrix solved directly at the bottom of the hierarchy.
+ */
+#define MCS_AMG_COARSE      200
+/*
+ * Largest number of levels, including the finest.
+ */
+#define MCS_AMG_MAX_LEVEL   25
+/*
+ * Number of Jacobi sweeps before and after each coarse correction.
+ */
+#define MCS_AMG_SWEEPS      2
+/*
+ * Default relative residual tolerance and iteration limit for PCG.
+ */
+#define MCS_AMG_TOL         1.0e-12
+#define MCS_AMG_MAX_ITER    500
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * A sparse matrix in compressed sparse row format. No column index
+ * appears twice in a row, but the columns of a row are not sorted.
+ */
+typedef struct _mcs_csr{
+    long n;     /*Number of rows*/
+    long m;     /*Number of columns*/
+    long* p;    /*Row pointers, n+1 entries*/
+    long* j;    /*Column index of each entry*/
+    double* x;  /*Value of each entry*/
+} mcs_csr;
+
+/*
+ * One level of the multigrid hierarchy.
+ */
+typedef struct _mcs_amg_level{
+    mcs_csr* A;     /*Matrix of this level*/
+    mcs_csr* P;     /*Prolongation from the next coarser level*/
+    mcs_csr* R;     /*Restriction to the next coarser level, P^T*/
+    double* dinv;   /*Jacobi weight divided by each diagonal entry*/
+    double* x;      /*Correction on this level*/
+    double* b;      /*Right hand side on this level*/
+    double* r;      /*Residual workspace*/
+} mcs_amg_level;
+
+typedef struct _mcs_amg{
+    long num_level;         /*Number of levels, the last is solved by LU*/
+    mcs_amg_level* lev;     /*Levels from finest to coarsest*/
+    mcs_spmat* A_c;         /*Coarsest matrix in coordinate format*/
+    mcs_splu_symbolic* S;   /*Symbolic analysis of A_c*/
+    mcs_splu_numeric* N;    /*Numeric factors of A_c*/
+    double* work;           /*PCG workspace of 3 vectors*/
+} mcs_amg;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Return 1 if the square matrix A is symmetric, has a positive diagonal,
+ * and is diagonally dominant in every row, which guarantees that A is
+ * symmetric positive definite. Duplicate coordinates are summed.
+ * Resistor networks with gmin to ground pass this test, and circuits
+ * with voltage sources or inductors do not.
+ */
+int mcs_amg_is_spd(mcs_spmat* A);
+
+/*
+ * Convert the coordinate matrix A to compressed sparse row format,
+ * summing duplicates.
+ */
+void mcs_amg_csr(mcs_spmat* A, mcs_csr** C);
+
+/*
+ * Free a compressed sparse row matrix.
+ */
+void mcs_free_csr(mcs_csr** C);
+
+/*
+ * Build the multigrid hierarchy of the symmetric positive definite
+ * matrix A. A is not referenced after this returns.
+ *
+ * Returns 0. If the coarsest level can not be factored, then returns 1
+ * with *H set to NULL after recording MCS_SINGULAR_MATRIX in st. If st is
+ * NULL then mcs_error is called instead.
+ */
+int mcs_alloc_amg(mcs_spmat* A, mcs_amg** H, mcs_status* st);
+
+/*
+ * Free a multigrid hierarchy.
+ */
+void mcs_free_amg(mcs_amg** H);
+
+/*
+ * Solve A*x = b with conjugate gradients preconditioned by one V-cycle
+ * of H per iteration, where A is the matrix given to mcs_alloc_amg.
+ * x holds the initial guess on entry. Iteration stops once the residual
+ * norm is at most tol times the norm of b.
+ *
+ * Returns the number of iterations, or -1 if max_iter was reached.
+ */
+long mcs_amg_pcg(mcs_amg* H, double* b, double* x, double tol,
+                 long max_iter);
+
+#endif
@@ -0,0 +1,184 @@
+/*
+ * Implementation for:
+ * Parameter sweep and Monte Carlo batch runner for MicroCircSim
+ * by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "batch_runner.h"
+/*
+ * Locally used helper functions:
+ */
+
+double mcs_batch_uniform(unsigned long long* state);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * splitmix64 generator. Returns a uniform random number in (0,1].
+ */
+double mcs_batch_uniform(unsigned long long* state){
+    unsigned long long z;
+    *state += 0x9E3779B97F4A7C15ULL;
+    z = *state;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    return ((double) ((z >> 11) + 1)) / 9007199254740992.0;
+}
+
+void mcs_batch_sweep(double lo, double hi, long num_samples, double* values){
+    long s;
+    for(s=0;s<num_samples;s++){
+        if(num_samples > 1){
+            values[s] = lo + (hi-lo)*((double) s)/(num_samples-1);
+        }else{
+            values[s] = lo;
+        }
+    }
+}
+
+void mcs_batch_monte_carlo(mcs_mna* M,
+                           long num_param,
+                           long* dev,
+                           double* rel_tol,
+                           unsigned long seed,
+                           long num_samples,
+                           double* values){
+    unsigned long long state;
+    double u1, u2, z;
+    long s, j;
+    for(s=0;s<num_samples;s++){
+        state = ((unsigned long long) seed)*0x100000001B3ULL
+                    + (unsigned long long) s;
+        for(j=0;j<num_param;j++){
+            //Box-Muller transform
+            u1 = mcs_batch_uniform(&state);
+            u2 = mcs_batch_uniform(&state);
+            z = sqrt(-2.0*log(u1))*cos(2.0*M_PI*u2);
+            values[s*num_param+j] = M->val[dev[j]]*(1.0 + rel_tol[j]*z);
+        }
+    }
+}
+
+int mcs_batch_dc(mcs_mna* M,
+                 long num_param,
+                 long* dev,
+                 double* values,
+                 long num_samples,
+                 double* x,
+                 long* iters,
+                 mcs_status* st){
+    mcs_spmat* G;
+    mcs_splu_symbolic* S;
+    double* x_nom;
+    long i, s;
+    //one nominal solve gives the shared pivot order and the initial guess
+    x_nom = (double*) malloc(sizeof(double)*(M->dim+1));
+    for(i=0;i<M->dim;i++){
+        x_nom[i] = 0.0;
+    }
+    if(mcs_dc_op(M,x_nom,MCS_DC_TOL,MCS_DC_MAX_ITER) < 0){
+        free(x_nom);
+        return mcs_raise(st,MCS_NO_CONVERGE);
+    }
+    mcs_mna_alloc_G(M,&G);
+    mcs_mna_stamp_G(M,x_nom,G->dat,NULL);
+    if(mcs_splu_analyze_r(G,&S)){
+        mcs_free_spmat(&G);
+        free(x_nom);
+        return mcs_raise(st,MCS_SINGULAR_MATRIX);
+    }
+    #pragma omp parallel private(i,s)
+    {
+        mcs_mna M_own;
+        mcs_spmat* G_own;
+        mcs_splu_numeric* N;
+        double* work;
+        long j;
+        //each thread sees the shared circuit with its own element values
+        M_own = *M;
+        M_own.val = (double*) malloc(sizeof(double)*(M->num_dev+1));
+        for(i=0;i<M->num_dev;i++){
+            M_own.val[i] = M->val[i];
+        }
+        mcs_spmat_share(G,&G_own);
+        mcs_alloc_splu(S,&N);
+        work = (double*) malloc(sizeof(double)*(2*M->dim+1));
+        #pragma omp for schedule(dynamic)
+        for(s=0;s<num_samples;s++){
+            for(j=0;j<num_param;j++){
+                M_own.val[dev[j]] = values[s*num_param+j];
+            }
+            for(i=0;i<M->dim;i++){
+                x[s*M->dim+i] = x_nom[i];
+            }
+            iters[s] = mcs_dc_newton(&M_own,G_own,N,&(x[s*M->dim]),work,
+                                     MCS_DC_TOL,MCS_DC_MAX_ITER);
+            for(j=0;j<num_param;j++){
+                M_own.val[dev[j]] = M->val[dev[j]];
+            }
+        }
+        free(work);
+        mcs_free_splu(&N);
+        mcs_free_spmat(&G_own);
+        free(M_own.val);
+    }
+    mcs_free_splu_symbolic(&S);
+    mcs_free_spmat(&G);
+    free(x_nom);
+    return 0;
+}
+
+int mcs_batch_write(const char* filename,
+                    mcs_mna* M,
+                    long num_param,
+                    long* dev,
+                    double* values,
+                    long num_samples,
+                    double* x,
+                    long* iters,
+                    mcs_status* st){
+    static const char w_only[2] = "w";
+    char name[MCS_NETLIST_LINE_LEN+1];
+    long i, j, s;
+    int err;
+    FILE* out = fopen(filename,w_only);
+    if(out == NULL){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    fprintf(out,"%% sample iters");
+    for(j=0;j<num_param;j++){
+        mcs_mna_element_name(M,dev[j],name);
+        fprintf(out," %s",name);
+    }
+    for(i=0;i<M->dim;i++){
+        mcs_mna_unknown_name(M,i,name);
+        fprintf(out," %s",name);
+    }
+    fprintf(out,"\n");
+    for(s=0;s<num_samples;s++){
+        fprintf(out,"%ld %ld",s,iters[s]);
+        for(j=0;j<num_param;j++){
+            fprintf(out," %le",values[s*num_param+j]);
+        }
+        for(i=0;i<M->dim;i++){
+            fprintf(out," %le",x[s*M->dim+i]);
+        }
+        fprintf(out,"\n");
+    }
+    err = ferror(out);
+    if(fclose(out) != 0 || err){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    return 0;
+}
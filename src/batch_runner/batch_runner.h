@@ -0,0 +1,107 @@
+#ifndef MCS_BATCH_RUNNER_H
+#define MCS_BATCH_RUNNER_H
+
+/*
+ * Parameter sweep and Monte Carlo batch runner for MicroCircSim
+ * by Bram Rodgers.
+ *
+ * A netlist is parsed once and its MNA description is shared by every
+ * sample. A sample replaces the ohm, farad, volt, amp, or henry values of
+ * a few elements. Samples are split among OpenMP threads, and all threads
+ * share one sparsity pattern and one symbolic LU analysis.
+ *
+ * Sample values are stored as a table where row s holds the values of
+ * sample s, so values[s*num_param + j] is the value of element dev[j]
+ * in sample s.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include<stdio.h>
+#include"math.h"
+#include"../mna_system/mna_system.h"
+#include"../dc_analysis/dc_analysis.h"
+#include"../sparse_lu/sparse_lu.h"
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Fill values with num_samples values of one element, spaced linearly
+ * from lo to hi.
+ */
+void mcs_batch_sweep(double lo, double hi, long num_samples, double* values);
+
+/*
+ * Fill the sample table with Monte Carlo samples. Element dev[j] gets
+ * the value M->val[dev[j]]*(1 + rel_tol[j]*z) with z a standard normal
+ * random number.
+ *
+ * Sample s only depends on seed and s, so results are reproducible no
+ * matter how the samples are later split among threads.
+ */
+void mcs_batch_monte_carlo(mcs_mna* M,
+                           long num_param,
+                           long* dev,
+                           double* rel_tol,
+                           unsigned long seed,
+                           long num_samples,
+                           double* values);
+
+/*
+ * Solve the DC operating point of every sample.
+ *
+ * dev lists num_param positions in M->dev. On exit, x[s*M->dim + i] holds
+ * entry i of the operating point of sample s, and iters[s] holds the
+ * number of Newton iterations of sample s, or -1 if it did not converge.
+ * Every sample starts Newton's method from the nominal operating point.
+ *
+ * M is only read, so it may be shared with other threads.
+ *
+ * Returns 0. If the nominal operating point does not converge, or its
+ * Jacobian is singular, then no sample is solved, 1 is returned, and
+ * MCS_NO_CONVERGE or MCS_SINGULAR_MATRIX is recorded in st. If st is
+ * NULL then mcs_error is called instead.
+ */
+int mcs_batch_dc(mcs_mna* M,
+                 long num_param,
+                 long* dev,
+                 double* values,
+                 long num_samples,
+                 double* x,
+                 long* iters,
+                 mcs_status* st);
+
+/*
+ * Write the results of mcs_batch_dc to one text file. The file starts with
+ * a comment line naming each column, then has one line per sample holding
+ * the sample number, the Newton iteration count, the sample values, and
+ * the operating point.
+ *
+ * Returns 0, or 1 after recording MCS_FILE_WRITE in st if the file could
+ * not be opened or written. If st is NULL then mcs_error is called instead.
+ */
+int mcs_batch_write(const char* filename,
+                    mcs_mna* M,
+                    long num_param,
+                    long* dev,
+                    double* values,
+                    long num_samples,
+                    double* x,
+                    long* iters,
+                    mcs_status* st);
+
+#endif
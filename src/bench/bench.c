@@ -0,0 +1,263 @@
+/*
+ * Implementation for:
+ * Benchmark driver for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "bench.h"
+
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Linear map of mcs_bicgstab_r for the sparse matrix data.
+ */
+void mcs_bench_apply(void* data, double* v, double* w);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Scratch netlist written and read by every benchmark case.
+ */
+static const char mcs_bench_file[] = "mcs_bench.net";
+
+/*
+ * Function Implementations:
+ */
+
+void mcs_bench_apply(void* data, double* v, double* w){
+    mcs_spmatvec('n',(mcs_spmat*) data,v,w);
+}
+
+int mcs_bench_rc_ladder(const char* filename, long n){
+    FILE* f = fopen(filename,"w");
+    long k;
+    if(f == NULL){
+        return 1;
+    }
+    fprintf(f,"%% RC ladder, %ld sections\n",n);
+    fprintf(f,"I1 0 1 1.0e-3\n");
+    fprintf(f,"R%ld 1 0 1000\n",n+1);
+    for(k=1;k<=n;k++){
+        fprintf(f,"R%ld %ld %ld 100\n",k,k,k+1);
+        fprintf(f,"C%ld %ld 0 1.0e-12\n",k,k+1);
+    }
+    return (fclose(f) != 0);
+}
+
+int mcs_bench_power_grid(const char* filename, long n){
+    FILE* f = fopen(filename,"w");
+    long i, j, node, r = 1, c = 1;
+    if(f == NULL){
+        return 1;
+    }
+    fprintf(f,"%% %ld by %ld power grid\n",n,n);
+    for(i=0;i<n;i++){
+        for(j=0;j<n;j++){
+            node = i*n + j + 1;
+            if(j+1 < n){
+                fprintf(f,"R%ld %ld %ld 0.1\n",r++,node,node+1);
+            }
+            if(i+1 < n){
+                fprintf(f,"R%ld %ld %ld 0.1\n",r++,node,node+n);
+            }
+            fprintf(f,"I%ld %ld 0 1.0e-4\n",c++,node);
+            if(i%8 == 0 && j%8 == 0){
+                //a 1 Volt supply pad with 0.01 Ohm of resistance
+                fprintf(f,"I%ld 0 %ld 100\n",c++,node);
+                fprintf(f,"R%ld %ld 0 0.01\n",r++,node);
+            }
+        }
+    }
+    return (fclose(f) != 0);
+}
+
+int mcs_bench_rlc_line(const char* filename, long n){
+    FILE* f = fopen(filename,"w");
+    long k;
+    if(f == NULL){
+        return 1;
+    }
+    fprintf(f,"%% RLC line, %ld sections\n",n);
+    fprintf(f,"V1 1 0 1.0\n");
+    for(k=1;k<=n;k++){
+        fprintf(f,"R%ld %ld %ld 0.5\n",k,2*k-1,2*k);
+        fprintf(f,"L%ld %ld %ld 1.0e-9\n",k,2*k,2*k+1);
+        fprintf(f,"C%ld %ld 0 1.0e-12\n",k,2*k+1);
+    }
+    fprintf(f,"R%ld %ld 0 50\n",n+1,2*n+1);
+    return (fclose(f) != 0);
+}
+
+int mcs_bench_diode_chain(const char* filename, long n){
+    FILE* f = fopen(filename,"w");
+    long k;
+    if(f == NULL){
+        return 1;
+    }
+    fprintf(f,"%% diode chain, %ld diodes\n",n);
+    fprintf(f,"V1 1 0 5.0\n");
+    fprintf(f,"R%ld 1 2 1000\n",n+1);
+    for(k=1;k<=n;k++){
+        fprintf(f,"D%ld %ld %ld\n",k,k+1,k+2);
+        fprintf(f,"R%ld %ld 0 100000\n",k,k+2);
+    }
+    return (fclose(f) != 0);
+}
+
+int mcs_bench_mos_chain(const char* filename, long n){
+    FILE* f = fopen(filename,"w");
+    long k;
+    if(f == NULL){
+        return 1;
+    }
+    fprintf(f,"%% NMOS inverter chain, %ld stages\n",n);
+    fprintf(f,"V1 1 0 5.0\n");
+    fprintf(f,"V2 2 0 5.0\n");
+    for(k=1;k<=n;k++){
+        fprintf(f,"R%ld 1 %ld 10000\n",k,k+2);
+        fprintf(f,"MN%ld %ld %ld 0\n",k,k+2,k+1);
+        fprintf(f,"C%ld %ld 0 1.0e-13\n",k,k+2);
+    }
+    return (fclose(f) != 0);
+}
+
+int mcs_bench_run(FILE* out, const char* name, mcs_bench_gen gen,
+                  long n, long reps){
+    mcs_netlist* nl;
+    mcs_mna* M;
+    mcs_spmat* G;
+    mcs_splu_symbolic* S;
+    mcs_splu_numeric* N = NULL;
+    mcs_spmv* P;
+    double *b, *x, *work;
+    double t0, t_parse, t_asm, t_mv, t_pv, t_lu, t_cg = -1.0;
+    long i, k, iter = 0;
+    int lu_fail;
+    if(reps < 1 || gen(mcs_bench_file,n)){
+        remove(mcs_bench_file);
+        return 1;
+    }
+    t0 = mcs_prof_now();
+    mcs_read_netlist(mcs_bench_file,&nl);
+    t_parse = mcs_prof_now() - t0;
+    t0 = mcs_prof_now();
+    mcs_alloc_mna(&M,nl);
+    b = (double*) malloc(sizeof(double)*(M->dim+1));
+    mcs_mna_alloc_G(M,&G);
+    mcs_mna_stamp_G(M,NULL,G->dat,b);
+    t_asm = mcs_prof_now() - t0;
+    x = (double*) malloc(sizeof(double)*(M->dim+1));
+    work = (double*) malloc(sizeof(double)*(6*M->dim+1));
+    t0 = mcs_prof_now();
+    for(k=0;k<reps;k++){
+        mcs_spmatvec('n',G,b,x);
+    }
+    t_mv = (mcs_prof_now() - t0)/reps;
+    mcs_alloc_spmv(G,MCS_SPMV_TRIAL,&P);
+    t0 = mcs_prof_now();
+    for(k=0;k<reps;k++){
+        mcs_spmv_apply(P,b,x);
+    }
+    t_pv = (mcs_prof_now() - t0)/reps;
+    if(M->num_branch == 0){
+        for(i=0;i<M->dim;i++){
+            x[i] = 0.0;
+        }
+        t0 = mcs_prof_now();
+        iter = mcs_bicgstab_r(mcs_bench_apply,G,b,x,work,M->dim,
+                              MCS_BENCH_TOL,MCS_BENCH_MAX_ITER);
+        t_cg = mcs_prof_now() - t0;
+    }
+    t0 = mcs_prof_now();
+    lu_fail = mcs_splu_analyze_r(G,&S);
+    if(!lu_fail){
+        mcs_alloc_splu(S,&N);
+        lu_fail = mcs_splu_factor(N,G->dat);
+    }
+    if(!lu_fail){
+        mcs_splu_solve(N,b,x);
+    }
+    t_lu = mcs_prof_now() - t0;
+    fprintf(out,"{\"case\": \"%s\", \"size\": %ld, \"dim\": %ld, "
+                "\"nnz\": %ld, \"parse\": %.6e, \"assemble\": %.6e, "
+                "\"spmatvec\": %.6e, \"spmv\": %.6e, \"spmv_fmt\": \"%s\", ",
+                name,n,M->dim,G->nnz,t_parse,t_asm,t_mv,t_pv,
+                mcs_spmv_name(P->fmt));
+    if(t_cg < 0.0){
+        fprintf(out,"\"bicgstab\": null, \"bicgstab_iter\": null, "
+                    "\"bicgstab_converged\": null, ");
+    }else{
+        fprintf(out,"\"bicgstab\": %.6e, \"bicgstab_iter\": %ld, "
+                    "\"bicgstab_converged\": %s, ",t_cg,
+                    (iter < 0) ? MCS_BENCH_MAX_ITER : iter,
+                    (iter < 0) ? "false" : "true");
+    }
+    if(lu_fail){
+        fprintf(out,"\"lu\": null, \"lu_nnz\": null}\n");
+    }else{
+        fprintf(out,"\"lu\": %.6e, \"lu_nnz\": %ld}\n",
+                    t_lu,S->Lp[S->n]+S->Up[S->n]);
+    }
+    fflush(out);
+    if(N != NULL){
+        mcs_free_splu(&N);
+    }
+    if(S != NULL){
+        mcs_free_splu_symbolic(&S);
+    }
+    mcs_free_spmv(&P);
+    free(work);
+    free(x);
+    free(b);
+    mcs_free_spmat(&G);
+    mcs_free_mna(&M);
+    mcs_free_netlist(&nl);
+    remove(mcs_bench_file);
+    return 0;
+}
+
+/*
+ * Usage: bench.x [num_sizes] [reps]
+ * Each case is run at num_sizes sizes, doubling from its smallest size.
+ * Returns 1 if the arguments are invalid or a netlist could not be
+ * written.
+ */
+int main(int argc, char** argv){
+    long num_sizes = 3, reps = 10;
+    long s, n;
+    int fail = 0;
+    if(argc > 1){
+        num_sizes = atol(argv[1]);
+    }
+    if(argc > 2){
+        reps = atol(argv[2]);
+    }
+    if(argc > 3 || num_sizes < 0 || reps < 1){
+        printf("Usage: %s [num_sizes] [reps], with reps at least 1\n",
+                    argv[0]);
+        return 1;
+    }
+    for(s=0,n=1;s<num_sizes && !fail;s++,n*=2){
+        fail = mcs_bench_run(stdout,"rc_ladder",mcs_bench_rc_ladder,
+                             2000*n,reps)
+            || mcs_bench_run(stdout,"power_grid",mcs_bench_power_grid,
+                             20*n,reps)
+            || mcs_bench_run(stdout,"rlc_line",mcs_bench_rlc_line,
+                             500*n,reps)
+            || mcs_bench_run(stdout,"diode_chain",mcs_bench_diode_chain,
+                             1000*n,reps)
+            || mcs_bench_run(stdout,"mos_chain",mcs_bench_mos_chain,
+                             500*n,reps);
+    }
+    if(fail){
+        printf("%s:%s",mcs_bench_file,mcs_error_str(MCS_FILE_WRITE));
+    }
+    return fail;
+}
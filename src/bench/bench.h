@@ -0,0 +1,100 @@
+#ifndef MCS_BENCH_H
+#define MCS_BENCH_H
+
+/*
+ * Benchmark driver for MicroCircSim by Bram Rodgers.
+ *
+ * Generates netlists of scalable size, then times each stage of setting
+ * up and solving them:
+ * ->parse:     mcs_read_netlist
+ * ->assemble:  mcs_alloc_mna, mcs_mna_alloc_G, and mcs_mna_stamp_G
+ * ->spmatvec:  one mcs_spmatvec with G, averaged over several repeats
+ * ->spmv:      one mcs_spmv_apply with G in the format chosen by
+ *              MCS_SPMV_TRIAL, averaged the same way. spmv_fmt names it.
+ * ->bicgstab:  mcs_bicgstab_r with G and the stamped right hand side,
+ *              limited to MCS_BENCH_MAX_ITER iterations. bicgstab_iter
+ *              is its number of iterations, and bicgstab_converged is
+ *              false if it stopped at the limit.
+ * ->lu:        mcs_splu_analyze, mcs_splu_factor, and mcs_splu_solve
+ *
+ * Every benchmark case is printed as one line of JSON, so results from
+ * different builds can be compared with any JSON tool. Times are in
+ * seconds, and stages which were skipped or failed are null.
+ *
+ * BiCGSTAB is only timed for circuits without branch currents, whose G
+ * is symmetric positive definite. Nonlinear circuits are timed with G
+ * linearized at x = 0.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include<stdio.h>
+#include"math.h"
+#include"../micro_circ_sim.h"
+
+/*
+ * Tolerance and iteration limit given to mcs_bicgstab_r.
+ */
+#define MCS_BENCH_TOL       1.0e-9
+#define MCS_BENCH_MAX_ITER  10000
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * A netlist generator. Writes a circuit of size n to filename. Returns 0,
+ * or 1 if the file could not be written.
+ */
+typedef int (*mcs_bench_gen)(const char* filename, long n);
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * RC ladder of n sections driven by a Norton source at node 1.
+ */
+int mcs_bench_rc_ladder(const char* filename, long n);
+
+/*
+ * n by n resistive power grid mesh. Every node draws a load current, and
+ * supply pads on a coarse lattice are Norton sources.
+ */
+int mcs_bench_power_grid(const char* filename, long n);
+
+/*
+ * Lossy transmission line of n RLC sections driven by a voltage source
+ * and terminated with a resistor.
+ */
+int mcs_bench_rlc_line(const char* filename, long n);
+
+/*
+ * n series diodes, each with a resistor to ground, fed through a resistor
+ * from a voltage source.
+ */
+int mcs_bench_diode_chain(const char* filename, long n);
+
+/*
+ * Chain of n NMOS inverters with resistive loads and capacitive outputs.
+ */
+int mcs_bench_mos_chain(const char* filename, long n);
+
+/*
+ * Generate the case called name at size n with gen, time every stage,
+ * and print one line of JSON to out. spmatvec is averaged over reps runs.
+ * Returns 0, or 1 without printing anything if reps is less than 1 or
+ * gen failed.
+ */
+int mcs_bench_run(FILE* out, const char* name, mcs_bench_gen gen,
+                  long n, long reps);
+
+#endif
@@ -0,0 +1,625 @@
+/*
+ * Implementation for:
+ * Checkpoint and restart of transient analyses by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "checkpoint.h"
+#include<string.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Round bytes up to a multiple of 8.
+ */
+size_t mcs_ckpt_pad(size_t bytes);
+
+/*
+ * Length of the snapshot file described by H.
+ */
+size_t mcs_ckpt_size(const mcs_ckpt_head* H);
+
+/*
+ * Entries of grp_p in use. Linear analyses have no latency groups.
+ */
+long mcs_ckpt_num_grp_p(const mcs_ckpt_head* H);
+
+/*
+ * Copy bytes from src into buf at offset off, and return the offset of
+ * the next array.
+ */
+size_t mcs_ckpt_put(char* buf, size_t off, const void* src, size_t bytes);
+
+/*
+ * Copy bytes from base at offset *off into dst, advancing *off to the
+ * next array.
+ */
+void mcs_ckpt_take(const char* base, size_t* off, void* dst, size_t bytes);
+
+/*
+ * Copy the state of T into a new buffer of length *len.
+ */
+char* mcs_ckpt_pack(mcs_tran* T, size_t* len);
+
+/*
+ * Write len bytes of buf to a temporary file next to path, then rename
+ * it to path. Returns 0 on success.
+ */
+int mcs_ckpt_dump(const char* path, const char* buf, size_t len);
+
+/*
+ * Thread which writes the buffer of the checkpoint writer K.
+ */
+void* mcs_ckpt_thread(void* K);
+
+/*
+ * Return 1 if the header H can be restored on this machine from a file
+ * of the given length.
+ */
+int mcs_ckpt_check(const mcs_ckpt_head* H, size_t bytes);
+
+/*
+ * Return 1 if the len entries of a are all in [lo, hi).
+ */
+int mcs_ckpt_in(const long* a, long len, long lo, long hi);
+
+/*
+ * Return 1 if the n+1 pointers p start at 0, end at end, and increase by
+ * at least step from one to the next.
+ */
+int mcs_ckpt_ptr(const long* p, long n, long end, long step);
+
+/*
+ * Return 1 if the n entries of p are a permutation of 0 to n-1.
+ */
+int mcs_ckpt_perm(const long* p, long n);
+
+/*
+ * Return 1 if every index array restored into T and T->M, which are later
+ * used as subscripts without checks, is in range.
+ */
+int mcs_ckpt_valid(const mcs_ckpt_head* H, mcs_tran* T);
+
+/*
+ * Free a restore which failed mcs_ckpt_valid, before T->N, T->Cv, and
+ * T->work are allocated.
+ */
+void mcs_ckpt_discard(mcs_netlist* nl, mcs_tran* T);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+size_t mcs_ckpt_pad(size_t bytes){
+    return (bytes + 7) & ~((size_t) 7);
+}
+
+size_t mcs_ckpt_size(const mcs_ckpt_head* H){
+    size_t L = sizeof(long), D = sizeof(double);
+    size_t s = sizeof(mcs_ckpt_head);
+    size_t n = (size_t) H->dim;
+    size_t nd = (size_t) H->num_dev;
+    s += mcs_ckpt_pad(nd*H->elem_size);
+    //MNA description: val, term, branch, G_off
+    s += D*nd + L*3*nd + L*nd + L*(nd+1);
+    //transient: x, source values, sources, A, C/h, latency groups
+    s += D*n + D*nd + L*H->num_src;
+    s += (2*L + D)*H->nnz_A + (2*L + D)*H->nnz_Ch;
+    s += L*mcs_ckpt_num_grp_p(H) + L*H->num_grp_dev + D*3*nd + D*4*nd;
+    //symbolic analysis and factors
+    s += L*(n+1) + L*H->lu_A + L*H->lu_nnz + L*2*n;
+    s += L*(n+1) + L*H->lu_L + L*(n+1) + L*H->lu_U;
+    s += D*(H->lu_A + H->lu_L + H->lu_U);
+    return s;
+}
+
+long mcs_ckpt_num_grp_p(const mcs_ckpt_head* H){
+    return (H->num_grp > 0) ? H->num_grp + 1 : 0;
+}
+
+size_t mcs_ckpt_put(char* buf, size_t off, const void* src, size_t bytes){
+    memcpy(&(buf[off]),src,bytes);
+    return off + mcs_ckpt_pad(bytes);
+}
+
+void mcs_ckpt_take(const char* base, size_t* off, void* dst, size_t bytes){
+    memcpy(dst,&(base[*off]),bytes);
+    *off += mcs_ckpt_pad(bytes);
+}
+
+char* mcs_ckpt_pack(mcs_tran* T, size_t* len){
+    mcs_ckpt_head H;
+    mcs_mna* M = T->M;
+    mcs_splu_symbolic* S = T->N->S;
+    size_t L = sizeof(long), D = sizeof(double), E = sizeof(mcs_element);
+    size_t off, nd = (size_t) M->num_dev, n = (size_t) M->dim;
+    long k;
+    char* buf;
+    memset(&H,0,sizeof(mcs_ckpt_head));
+    memcpy(H.magic,MCS_CKPT_MAGIC,8);
+    H.version = MCS_CKPT_VERSION;
+    H.endian = MCS_CKPT_ENDIAN;
+    H.elem_size = (long) E;
+    H.num_dev = M->num_dev;
+    H.num_nodes = M->num_nodes;
+    H.num_branch = M->num_branch;
+    H.dim = M->dim;
+    H.nnz_G = M->nnz_G;
+    H.nnz_C = M->nnz_C;
+    H.gmin = M->gmin;
+    H.h = T->h;
+    H.t = T->t;
+    H.tol = T->tol;
+    H.lat_tol = T->lat_tol;
+    H.linear = T->linear;
+    H.num_src = T->num_src;
+    H.max_iter = T->max_iter;
+    H.num_steps = T->num_steps;
+    H.num_factor = T->num_factor;
+    H.num_grp = T->num_grp;
+    H.num_grp_dev = (T->num_grp > 0) ? T->grp_p[T->num_grp] : 0;
+    H.dirty = T->dirty;
+    H.num_eval = T->num_eval;
+    H.nnz_A = T->A->nnz;
+    H.nnz_Ch = T->C->nnz;
+    H.lu_nnz = S->nnz;
+    H.lu_A = S->Ap[S->n];
+    H.lu_L = S->Lp[S->n];
+    H.lu_U = S->Up[S->n];
+    *len = mcs_ckpt_size(&H);
+    H.bytes = (long) *len;
+    buf = (char*) calloc(*len,1);
+    off = mcs_ckpt_put(buf,0,&H,sizeof(mcs_ckpt_head));
+    //instances share their elements, so save flat copies of them
+    for(k=0;k<M->num_dev;k++){
+        mcs_mna_flat_element(M,k,(mcs_element*) &(buf[off+k*E]));
+    }
+    off += mcs_ckpt_pad(nd*E);
+    off = mcs_ckpt_put(buf,off,M->val,D*nd);
+    off = mcs_ckpt_put(buf,off,M->term,L*3*nd);
+    off = mcs_ckpt_put(buf,off,M->branch,L*nd);
+    off = mcs_ckpt_put(buf,off,M->G_off,L*(nd+1));
+    off = mcs_ckpt_put(buf,off,T->x,D*n);
+    off = mcs_ckpt_put(buf,off,T->Mt.val,D*nd);
+    off = mcs_ckpt_put(buf,off,T->src,L*T->num_src);
+    off = mcs_ckpt_put(buf,off,T->A->r,L*H.nnz_A);
+    off = mcs_ckpt_put(buf,off,T->A->c,L*H.nnz_A);
+    off = mcs_ckpt_put(buf,off,T->A->dat,D*H.nnz_A);
+    off = mcs_ckpt_put(buf,off,T->C->r,L*H.nnz_Ch);
+    off = mcs_ckpt_put(buf,off,T->C->c,L*H.nnz_Ch);
+    off = mcs_ckpt_put(buf,off,T->C->dat,D*H.nnz_Ch);
+    off = mcs_ckpt_put(buf,off,T->grp_p,L*mcs_ckpt_num_grp_p(&H));
+    off = mcs_ckpt_put(buf,off,T->grp_dev,L*H.num_grp_dev);
+    off = mcs_ckpt_put(buf,off,T->v_ref,D*3*nd);
+    off = mcs_ckpt_put(buf,off,T->rhs,D*4*nd);
+    off = mcs_ckpt_put(buf,off,S->Ap,L*(n+1));
+    off = mcs_ckpt_put(buf,off,S->Ai,L*H.lu_A);
+    off = mcs_ckpt_put(buf,off,S->map,L*H.lu_nnz);
+    off = mcs_ckpt_put(buf,off,S->pinv,L*n);
+    off = mcs_ckpt_put(buf,off,S->q,L*n);
+    off = mcs_ckpt_put(buf,off,S->Lp,L*(n+1));
+    off = mcs_ckpt_put(buf,off,S->Li,L*H.lu_L);
+    off = mcs_ckpt_put(buf,off,S->Up,L*(n+1));
+    off = mcs_ckpt_put(buf,off,S->Ui,L*H.lu_U);
+    off = mcs_ckpt_put(buf,off,T->N->Ax,D*H.lu_A);
+    off = mcs_ckpt_put(buf,off,T->N->Lx,D*H.lu_L);
+    mcs_ckpt_put(buf,off,T->N->Ux,D*H.lu_U);
+    return buf;
+}
+
+int mcs_ckpt_dump(const char* path, const char* buf, size_t len){
+    char tmp[MCS_CKPT_PATH_LEN+8];
+    FILE* f;
+    int err;
+    snprintf(tmp,sizeof(tmp),"%s.tmp",path);
+    f = fopen(tmp,"wb");
+    if(f == NULL){
+        return 1;
+    }
+    err = (fwrite(buf,1,len,f) != len);
+    err = (fflush(f) != 0) || err;
+    err = (fsync(fileno(f)) != 0) || err;
+    err = (fclose(f) != 0) || err;
+    if(!err){
+        err = (rename(tmp,path) != 0);
+    }
+    if(err){
+        remove(tmp);
+    }
+    return err;
+}
+
+void* mcs_ckpt_thread(void* K){
+    mcs_ckpt* C = (mcs_ckpt*) K;
+    C->err = mcs_ckpt_dump(C->path,C->buf,C->len);
+    return NULL;
+}
+
+void mcs_alloc_ckpt(mcs_ckpt** K, const char* path, double interval){
+    mcs_ckpt* C = (mcs_ckpt*) malloc(sizeof(mcs_ckpt));
+    strncpy(C->path,path,MCS_CKPT_PATH_LEN-1);
+    C->path[MCS_CKPT_PATH_LEN-1] = '\0';
+    C->buf = NULL;
+    C->len = 0;
+    C->busy = 0;
+    C->err = 0;
+    C->interval = interval;
+    C->last = mcs_prof_now();
+    C->num_write = 0;
+    *K = C;
+}
+
+void mcs_free_ckpt(mcs_ckpt** K){
+    mcs_ckpt_wait(*K,NULL);
+    free(*K);
+    *K = NULL;
+}
+
+int mcs_ckpt_wait(mcs_ckpt* K, mcs_status* st){
+    if(K->busy){
+        pthread_join(K->thread,NULL);
+        K->busy = 0;
+        free(K->buf);
+        K->buf = NULL;
+        if(!K->err){
+            K->num_write++;
+        }
+    }
+    if(K->err && st != NULL){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    return K->err;
+}
+
+void mcs_ckpt_save(mcs_ckpt* K, mcs_tran* T){
+    mcs_ckpt_wait(K,NULL);
+    K->buf = mcs_ckpt_pack(T,&(K->len));
+    K->last = mcs_prof_now();
+    if(pthread_create(&(K->thread),NULL,&mcs_ckpt_thread,K) == 0){
+        K->busy = 1;
+        return;
+    }
+    //no thread is available, so write it here
+    mcs_ckpt_thread(K);
+    free(K->buf);
+    K->buf = NULL;
+    if(!K->err){
+        K->num_write++;
+    }
+}
+
+int mcs_ckpt_write(const char* path, mcs_tran* T, mcs_status* st){
+    size_t len;
+    char* buf = mcs_ckpt_pack(T,&len);
+    int err = mcs_ckpt_dump(path,buf,len);
+    free(buf);
+    if(err){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    return 0;
+}
+
+int mcs_ckpt_check(const mcs_ckpt_head* H, size_t bytes){
+    long cnt[17];
+    int k;
+    if(memcmp(H->magic,MCS_CKPT_MAGIC,8) != 0
+       || H->version != MCS_CKPT_VERSION
+       || H->endian != MCS_CKPT_ENDIAN
+       || H->elem_size != (long) sizeof(mcs_element)
+       || H->bytes != (long) bytes){
+        return 0;
+    }
+    cnt[0] = H->num_dev;
+    cnt[1] = H->num_nodes;
+    cnt[2] = H->num_branch;
+    cnt[3] = H->dim;
+    cnt[4] = H->nnz_G;
+    cnt[5] = H->nnz_C;
+    cnt[6] = H->num_src;
+    cnt[7] = H->num_grp;
+    cnt[8] = H->num_grp_dev;
+    cnt[9] = H->nnz_A;
+    cnt[10] = H->nnz_Ch;
+    cnt[11] = H->lu_nnz;
+    cnt[12] = H->lu_A;
+    cnt[13] = H->lu_L;
+    cnt[14] = H->lu_U;
+    cnt[15] = H->num_steps;
+    cnt[16] = H->max_iter;
+    //every count is bounded by the file length before sizes are summed
+    for(k=0;k<17;k++){
+        if(cnt[k] < 0 || cnt[k] > (long) bytes){
+            return 0;
+        }
+    }
+    return H->dim == H->num_nodes + H->num_branch
+           && H->num_src <= H->num_dev
+           && H->num_grp <= H->num_dev + 1
+           && H->num_grp_dev <= H->num_dev
+           && H->lu_nnz == H->nnz_A
+           && mcs_ckpt_size(H) == bytes;
+}
+
+int mcs_ckpt_in(const long* a, long len, long lo, long hi){
+    long k;
+    for(k=0;k<len;k++){
+        if(a[k] < lo || a[k] >= hi){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int mcs_ckpt_ptr(const long* p, long n, long end, long step){
+    long k;
+    if(p[0] != 0 || p[n] != end){
+        return 0;
+    }
+    for(k=0;k<n;k++){
+        if(p[k+1] - p[k] < step){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int mcs_ckpt_perm(const long* p, long n){
+    char* seen;
+    long k;
+    int ok = mcs_ckpt_in(p,n,0,n);
+    if(!ok){
+        return 0;
+    }
+    seen = (char*) calloc(n+1,1);
+    for(k=0;k<n && ok;k++){
+        ok = !seen[p[k]];
+        seen[p[k]] = 1;
+    }
+    free(seen);
+    return ok;
+}
+
+int mcs_ckpt_valid(const mcs_ckpt_head* H, mcs_tran* T){
+    mcs_mna* M = T->M;
+    mcs_splu_symbolic* S = T->S;
+    long n = M->dim, nd = M->num_dev;
+    if(mcs_mna_check(M) != 0
+       || T->C->nnz != M->nnz_C
+       || T->A->nnz != M->nnz_G + M->nnz_C){
+        return 0;
+    }
+    //the transient analysis
+    if(!mcs_ckpt_in(T->src,T->num_src,0,nd)
+       || !mcs_ckpt_in(T->A->r,T->A->nnz,0,n)
+       || !mcs_ckpt_in(T->A->c,T->A->nnz,0,n)
+       || !mcs_ckpt_in(T->C->r,T->C->nnz,0,n)
+       || !mcs_ckpt_in(T->C->c,T->C->nnz,0,n)){
+        return 0;
+    }
+    if(T->num_grp > 0 && (!mcs_ckpt_ptr(T->grp_p,T->num_grp,H->num_grp_dev,0)
+                || !mcs_ckpt_in(T->grp_dev,H->num_grp_dev,0,nd))){
+        return 0;
+    }
+    //the symbolic analysis, whose columns must not be empty
+    return mcs_ckpt_ptr(S->Ap,n,H->lu_A,0)
+           && mcs_ckpt_in(S->Ai,H->lu_A,0,n)
+           && mcs_ckpt_in(S->map,H->lu_nnz,0,H->lu_A)
+           && mcs_ckpt_perm(S->pinv,n)
+           && mcs_ckpt_perm(S->q,n)
+           && mcs_ckpt_ptr(S->Lp,n,H->lu_L,1)
+           && mcs_ckpt_in(S->Li,H->lu_L,0,n)
+           && mcs_ckpt_ptr(S->Up,n,H->lu_U,1)
+           && mcs_ckpt_in(S->Ui,H->lu_U,0,n);
+}
+
+void mcs_ckpt_discard(mcs_netlist* nl, mcs_tran* T){
+    mcs_mna* M = T->M;
+    mcs_free_splu_symbolic(&(T->S));
+    mcs_free_spmat(&(T->A));
+    mcs_free_spmat(&(T->C));
+    free(T->rhs);
+    free(T->v_ref);
+    free(T->grp_dev);
+    free(T->grp_p);
+    free(T->x);
+    free(T->src);
+    free(T->Mt.val);
+    free(T);
+    mcs_free_mna(&M);
+    mcs_free_netlist(&nl);
+}
+
+int mcs_ckpt_restore(const char* path,
+                     mcs_netlist** nl,
+                     mcs_mna** M,
+                     mcs_tran** T,
+                     mcs_status* st){
+    mcs_ckpt_head H;
+    mcs_netlist *first = NULL, *prev = NULL, *line;
+    mcs_mna* Q;
+    mcs_tran* R;
+    mcs_splu_symbolic* S;
+    mcs_element z;
+    struct stat sb;
+    size_t L = sizeof(long), D = sizeof(double), E = sizeof(mcs_element);
+    size_t off, nd, n;
+    long k;
+    char* base;
+    int fd = open(path,O_RDONLY);
+    if(fd < 0){
+        return mcs_raise(st,FILE_READ_ONLY);
+    }
+    if(fstat(fd,&sb) != 0 || (size_t) sb.st_size < sizeof(mcs_ckpt_head)){
+        close(fd);
+        return mcs_raise(st,MCS_CKPT_FMT);
+    }
+    base = (char*) mmap(NULL,sb.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+    close(fd);
+    if(base == MAP_FAILED){
+        return mcs_raise(st,FILE_READ_ONLY);
+    }
+    memcpy(&H,base,sizeof(mcs_ckpt_head));
+    if(!mcs_ckpt_check(&H,(size_t) sb.st_size)){
+        munmap(base,sb.st_size);
+        return mcs_raise(st,MCS_CKPT_FMT);
+    }
+    madvise(base,sb.st_size,MADV_SEQUENTIAL);
+    nd = (size_t) H.num_dev;
+    n = (size_t) H.dim;
+    off = sizeof(mcs_ckpt_head);
+    //snapshots hold flat elements, and only 'X' owns memory, so reject
+    //any other symbol before the elements go into a netlist
+    for(k=0;k<H.num_dev;k++){
+        memcpy(&z,&(base[off+k*E]),E);
+        if(z.elem.symbol == '\0'
+           || strchr("VIRCLDQM",z.elem.symbol) == NULL){
+            munmap(base,sb.st_size);
+            return mcs_raise(st,MCS_CKPT_FMT);
+        }
+    }
+    //the netlist, in the order of M->dev
+    Q = (mcs_mna*) malloc(sizeof(mcs_mna));
+    Q->dev = (mcs_element**) malloc(sizeof(mcs_element*)*(nd+1));
+    for(k=0;k<H.num_dev;k++){
+        mcs_alloc_netlist(&line);
+        memcpy(line->dev,&(base[off+k*E]),E);
+        line->prev = prev;
+        if(prev == NULL){
+            first = line;
+        }else{
+            prev->next = line;
+        }
+        prev = line;
+        Q->dev[k] = line->dev;
+    }
+    off += mcs_ckpt_pad(nd*E);
+    Q->num_dev = H.num_dev;
+    Q->num_nodes = H.num_nodes;
+    Q->num_branch = H.num_branch;
+    Q->dim = H.dim;
+    Q->nnz_G = H.nnz_G;
+    Q->nnz_C = H.nnz_C;
+    Q->gmin = H.gmin;
+    Q->gen_G = NULL;
+    Q->val = (double*) malloc(D*(nd+1));
+    Q->term = (long*) malloc(L*(3*nd+1));
+    Q->branch = (long*) malloc(L*(nd+1));
+    Q->G_off = (long*) malloc(L*(nd+1));
+    mcs_ckpt_take(base,&off,Q->val,D*nd);
+    mcs_ckpt_take(base,&off,Q->term,L*3*nd);
+    mcs_ckpt_take(base,&off,Q->branch,L*nd);
+    mcs_ckpt_take(base,&off,Q->G_off,L*(nd+1));
+    //the transient analysis
+    R = (mcs_tran*) malloc(sizeof(mcs_tran));
+    R->M = Q;
+    R->Mt = *Q;
+    R->h = H.h;
+    R->t = H.t;
+    R->linear = (int) H.linear;
+    R->num_src = H.num_src;
+    R->wave = NULL;
+    R->wave_data = NULL;
+    R->tol = H.tol;
+    R->max_iter = H.max_iter;
+    R->num_steps = H.num_steps;
+    R->num_factor = H.num_factor;
+    R->num_grp = H.num_grp;
+    R->lat_tol = H.lat_tol;
+    R->dirty = (int) H.dirty;
+    R->num_eval = H.num_eval;
+    R->x = (double*) malloc(D*(n+1));
+    R->Mt.val = (double*) malloc(D*(nd+1));
+    R->src = (long*) malloc(L*(nd+1));
+    mcs_ckpt_take(base,&off,R->x,D*n);
+    mcs_ckpt_take(base,&off,R->Mt.val,D*nd);
+    mcs_ckpt_take(base,&off,R->src,L*H.num_src);
+    mcs_alloc_spmat(&(R->A),H.nnz_A,H.dim,H.dim);
+    mcs_ckpt_take(base,&off,R->A->r,L*H.nnz_A);
+    mcs_ckpt_take(base,&off,R->A->c,L*H.nnz_A);
+    mcs_ckpt_take(base,&off,R->A->dat,D*H.nnz_A);
+    mcs_alloc_spmat(&(R->C),H.nnz_Ch,H.dim,H.dim);
+    mcs_ckpt_take(base,&off,R->C->r,L*H.nnz_Ch);
+    mcs_ckpt_take(base,&off,R->C->c,L*H.nnz_Ch);
+    mcs_ckpt_take(base,&off,R->C->dat,D*H.nnz_Ch);
+    R->grp_p = (long*) malloc(L*(nd+2));
+    R->grp_dev = (long*) malloc(L*(nd+1));
+    R->v_ref = (double*) malloc(D*(3*nd+1));
+    R->rhs = (double*) malloc(D*(4*nd+1));
+    mcs_ckpt_take(base,&off,R->grp_p,L*mcs_ckpt_num_grp_p(&H));
+    mcs_ckpt_take(base,&off,R->grp_dev,L*H.num_grp_dev);
+    mcs_ckpt_take(base,&off,R->v_ref,D*3*nd);
+    mcs_ckpt_take(base,&off,R->rhs,D*4*nd);
+    //symbolic analysis and factors, laid out as by mcs_splu_analyze
+    S = (mcs_splu_symbolic*) malloc(sizeof(mcs_splu_symbolic));
+    S->n = H.dim;
+    S->nnz = H.lu_nnz;
+    S->Ap = (long*) malloc(L*(n+1));
+    S->Ai = (long*) malloc(L*(H.lu_A+1));
+    S->map = (long*) malloc(L*(H.lu_nnz+1));
+    S->pinv = (long*) malloc(L*(n+1));
+    S->q = (long*) malloc(L*(n+1));
+    S->Lp = (long*) malloc(L*(n+1));
+    S->Li = (long*) malloc(L*(H.lu_L+1));
+    S->Up = (long*) malloc(L*(n+1));
+    S->Ui = (long*) malloc(L*(H.lu_U+1));
+    mcs_ckpt_take(base,&off,S->Ap,L*(n+1));
+    mcs_ckpt_take(base,&off,S->Ai,L*H.lu_A);
+    mcs_ckpt_take(base,&off,S->map,L*H.lu_nnz);
+    mcs_ckpt_take(base,&off,S->pinv,L*n);
+    mcs_ckpt_take(base,&off,S->q,L*n);
+    mcs_ckpt_take(base,&off,S->Lp,L*(n+1));
+    mcs_ckpt_take(base,&off,S->Li,L*H.lu_L);
+    mcs_ckpt_take(base,&off,S->Up,L*(n+1));
+    mcs_ckpt_take(base,&off,S->Ui,L*H.lu_U);
+    R->S = S;
+    //the factors are sized from S, so it is checked first
+    if(!mcs_ckpt_valid(&H,R)){
+        munmap(base,sb.st_size);
+        mcs_ckpt_discard(first,R);
+        return mcs_raise(st,MCS_CKPT_FMT);
+    }
+    mcs_alloc_splu(S,&(R->N));
+    mcs_ckpt_take(base,&off,R->N->Ax,D*H.lu_A);
+    mcs_ckpt_take(base,&off,R->N->Lx,D*H.lu_L);
+    mcs_ckpt_take(base,&off,R->N->Ux,D*H.lu_U);
+    munmap(base,sb.st_size);
+    mcs_alloc_spmv(R->C,MCS_SPMV_AUTO,&(R->Cv));
+    R->work = (double*) malloc(D*(3*n+1));
+    *nl = first;
+    *M = Q;
+    *T = R;
+    return 0;
+}
+
+long mcs_ckpt_run(mcs_tran* T, double t_stop, mcs_wave* W, mcs_ckpt* K){
+    long n = 0;
+    if(W != NULL){
+        mcs_wave_write(W,T->t,T->x);
+    }
+    while(T->t < t_stop - 0.5*T->h){
+        if(mcs_tran_step(T) < 0){
+            return -1;
+        }
+        n++;
+        if(W != NULL){
+            mcs_wave_write(W,T->t,T->x);
+        }
+        if(mcs_prof_now() - K->last >= K->interval){
+            mcs_ckpt_save(K,T);
+        }
+    }
+    return n;
+}
@@ -0,0 +1,181 @@
+#ifndef MCS_CHECKPOINT_H
+#define MCS_CHECKPOINT_H
+
+/*
+ * Checkpoint and restart of transient analyses by Bram Rodgers.
+ *
+ * A checkpoint is one binary snapshot of everything a transient analysis
+ * needs to carry on: the circuit elements, the MNA description, the
+ * pattern and values of G + C/h with its symbolic analysis and factors,
+ * the latency groups, the solution, and the time and step counters.
+ * Restoring it maps the file with mmap and copies the arrays straight
+ * into the usual structs, so nothing is parsed with mcs_read_netlist and
+ * nothing is analyzed or factored again. The restored objects are freed
+ * with mcs_free_tran, mcs_free_mna, and mcs_free_netlist as usual.
+ *
+ * Snapshots are written without stalling the solver. mcs_ckpt_save
+ * copies the state into a buffer, which costs about as much as one or
+ * two time steps, and a separate thread writes the buffer to a temporary
+ * file and renames it over the old snapshot. So the file
+ * always holds a whole snapshot, even if the job is killed mid write.
+ *
+ * The file starts with a header of 8 byte fields followed by the arrays,
+ * each padded to 8 bytes. It is only read on machines with the same size
+ * of long, byte order, and element layout as the one which wrote it,
+ * which is checked when restoring, along with the format version.
+ *
+ * Source waveforms are functions, so they are not saved. Set them again
+ * with mcs_tran_set_wave after restoring.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include<stdio.h>
+#include<pthread.h>
+#include"../error_handling/error_handling.h"
+#include"../netlist_parser/netlist_parser.h"
+#include"../mna_system/mna_system.h"
+#include"../transient_analysis/transient_analysis.h"
+#include"../waveform_writer/waveform_writer.h"
+
+/*
+ * First 8 bytes and format version of a snapshot.
+ */
+#define MCS_CKPT_MAGIC      "MCSCKPT\n"
+#define MCS_CKPT_VERSION    2
+
+/*
+ * Written into every header to check the byte order when restoring.
+ */
+#define MCS_CKPT_ENDIAN     0x0102030405060708L
+
+/*
+ * Longest snapshot path.
+ */
+#define MCS_CKPT_PATH_LEN   1024
+
+/*
+ * Default wall clock seconds between the checkpoints of mcs_ckpt_run.
+ */
+#define MCS_CKPT_INTERVAL   60.0
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * Header of a snapshot. Every field is 8 bytes so the arrays which
+ * follow it are aligned.
+ */
+typedef struct _mcs_ckpt_head{
+    char magic[8];
+    long version;
+    long endian;        /*MCS_CKPT_ENDIAN in the byte order of the writer*/
+    long elem_size;     /*sizeof(mcs_element) of the writer*/
+    long bytes;         /*Length of the file*/
+    long num_dev;
+    long num_nodes;
+    long num_branch;
+    long dim;
+    long nnz_G;
+    long nnz_C;
+    double gmin;
+    double h;
+    double t;
+    double tol;
+    double lat_tol;
+    long linear;
+    long num_src;
+    long max_iter;
+    long num_steps;
+    long num_factor;
+    long num_grp;
+    long num_grp_dev;   /*Entries of grp_dev in use*/
+    long dirty;
+    long num_eval;
+    long nnz_A;         /*Coordinate entries of G + C/h*/
+    long nnz_Ch;        /*Coordinate entries of C/h*/
+    long lu_nnz;        /*S->nnz*/
+    long lu_A;          /*Entries of the compressed matrix, S->Ap[n]*/
+    long lu_L;          /*Entries of L, S->Lp[n]*/
+    long lu_U;          /*Entries of U, S->Up[n]*/
+} mcs_ckpt_head;
+
+/*
+ * A checkpoint writer.
+ */
+typedef struct _mcs_ckpt{
+    char path[MCS_CKPT_PATH_LEN];   /*Snapshot file*/
+    char* buf;                      /*Snapshot being written*/
+    size_t len;                     /*Length of buf*/
+    pthread_t thread;               /*Thread writing buf*/
+    int busy;                       /*1 while thread has not been joined*/
+    int err;                        /*1 if the last write failed*/
+    double interval;                /*Seconds between checkpoints*/
+    double last;                    /*Wall clock time of the last save*/
+    long num_write;                 /*Snapshots written*/
+} mcs_ckpt;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Allocate a checkpoint writer for the file path, which mcs_ckpt_run
+ * saves to every interval seconds of wall clock time.
+ */
+void mcs_alloc_ckpt(mcs_ckpt** K, const char* path, double interval);
+
+/*
+ * Wait for a write in progress and free the writer.
+ */
+void mcs_free_ckpt(mcs_ckpt** K);
+
+/*
+ * Copy the state of T and start writing it in the background. Waits for
+ * the previous write first if it has not finished.
+ */
+void mcs_ckpt_save(mcs_ckpt* K, mcs_tran* T);
+
+/*
+ * Wait for a write in progress. Returns 0 if the last write succeeded,
+ * or 1 after recording MCS_FILE_WRITE in st.
+ */
+int mcs_ckpt_wait(mcs_ckpt* K, mcs_status* st);
+
+/*
+ * Write a snapshot of T to path without a thread. Returns 0 on success,
+ * or 1 after recording MCS_FILE_WRITE in st.
+ */
+int mcs_ckpt_write(const char* path, mcs_tran* T, mcs_status* st);
+
+/*
+ * Restore the snapshot in path into a new netlist, MNA description, and
+ * transient analysis. Every element symbol and every stored index is
+ * checked against the sizes in the header before it is used, so a
+ * damaged snapshot is rejected rather than trusted. Returns 0 on success,
+ * or 1 after recording FILE_READ_ONLY or MCS_CKPT_FMT in st, with nothing
+ * allocated.
+ */
+int mcs_ckpt_restore(const char* path,
+                     mcs_netlist** nl,
+                     mcs_mna** M,
+                     mcs_tran** T,
+                     mcs_status* st);
+
+/*
+ * As mcs_tran_run, saving a checkpoint with K whenever K->interval
+ * seconds have passed since the last one. Returns the number of steps
+ * taken, or -1 if a step did not converge.
+ */
+long mcs_ckpt_run(mcs_tran* T, double t_stop, mcs_wave* W, mcs_ckpt* K);
+
+#endif
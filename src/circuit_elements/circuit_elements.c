@@ -151,3 +151,13 @@ void mcs_init_mosfet_pc(mcs_mosfet_pc* MP,
 }
 
  
+
+void mcs_init_instance(mcs_instance* X,
+                       unsigned long idx,
+                       struct _mcs_subckt* sub,
+                       unsigned long* node){
+    X->symbol = 'X';
+    X->idx    = idx;
+    X->sub    = sub;
+    X->node   = node;
+}
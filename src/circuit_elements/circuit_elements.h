@@ -119,6 +119,17 @@ typedef struct _mcs_mosfet_pc{
     unsigned long node_s;        /*The source node for this transistor*/
 } mcs_mosfet_pc;
 
+/*
+ * An instance of a subcircuit definition, see netlist_parser.h. Every
+ * instance of one definition shares the elements of the definition.
+ */
+typedef struct _mcs_instance{
+    char symbol;/* = 'X';         Subcircuit instances denoted by X*/
+    unsigned long idx;           /*The numeric identifier for this element.*/
+    struct _mcs_subckt* sub;     /*The definition this is an instance of*/
+    unsigned long* node;         /*The node connected to each port of sub*/
+} mcs_instance;
+
 /*
  *  This union allows us to store all the various circuit elements
  *  in data structures with one type.
@@ -135,6 +146,7 @@ typedef union _mcs_element{
     mcs_bjt_pnp     QP;
     mcs_mosfet_nc   MN;
     mcs_mosfet_pc   MP;
+    mcs_instance    X;
 } mcs_element;
 /*
  * Function Declarations:
@@ -197,4 +209,9 @@ void mcs_init_mosfet_pc(mcs_mosfet_pc* MP,
                         unsigned long node_d,
                         unsigned long node_g,
                         unsigned long node_s);
+
+void mcs_init_instance(mcs_instance* X,
+                       unsigned long idx,
+                       struct _mcs_subckt* sub,
+                       unsigned long* node);
 #endif
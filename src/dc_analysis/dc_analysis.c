@@ -0,0 +1,362 @@
+/*
+ * Implementation for:
+ * DC operating point analysis for MicroCircSim by Bram Rodgers.
+ * Based on Chapter 3 of the textbook
+ * ``Circuit Simulation'' by Farid N. Najm.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "dc_analysis.h"
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * mcs_dc_newton where every node also has the conductance g_pt to the
+ * voltage x_pt[i], as a backward Euler step of length 1/g_pt with
+ * a unit capacitor on every node would. g_pt = 0 is Newton's method.
+ */
+long mcs_dc_newton_pt(mcs_mna* M,
+                      mcs_spmat* G,
+                      mcs_splu_numeric* N,
+                      double* x,
+                      double* x_pt,
+                      double g_pt,
+                      double* work,
+                      double tol,
+                      long max_iter);
+
+/*
+ * Set M to stage s of gmin stepping, or of source stepping if source
+ * is 1. s = 1 is the original circuit, whose source values are val and
+ * whose gmin is gmin.
+ */
+void mcs_dc_set_stage(mcs_mna* M, double* val, double gmin, double s,
+                      int source);
+
+/*
+ * Continuation in s from 0 to 1 shared by gmin and source stepping.
+ * The step in s doubles after a stage which converges quickly and is
+ * cut by 4 after one which fails. The stages are solved on a copy of M,
+ * which is not changed.
+ */
+long mcs_dc_continue(mcs_mna* M,
+                     mcs_spmat* G,
+                     mcs_splu_numeric* N,
+                     double* x,
+                     double* work,
+                     double tol,
+                     long max_iter,
+                     int source);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+long mcs_dc_newton_pt(mcs_mna* M,
+                      mcs_spmat* G,
+                      mcs_splu_numeric* N,
+                      double* x,
+                      double* x_pt,
+                      double g_pt,
+                      double* work,
+                      double tol,
+                      long max_iter){
+    mcs_splu_symbolic* S_own;
+    mcs_splu_numeric* N_own;
+    double* b = work;
+    double* x_new = &(work[M->dim]);
+    double* g_node = &(G->dat[M->G_off[M->num_dev]]);
+    double t0;
+    long i, iter;
+    int linear = mcs_mna_is_linear(M);
+    int converged = 0;
+    int failed;
+    for(iter=1;iter<=max_iter;iter++){
+        mcs_mna_stamp_G(M,x,G->dat,b);
+        if(g_pt > 0.0){
+            for(i=0;i<M->num_nodes;i++){
+                g_node[i] += g_pt;
+                b[i] += g_pt*x_pt[i];
+            }
+        }
+        t0 = mcs_prof_now();
+        if(mcs_splu_factor(N,G->dat) == 0){
+            mcs_splu_solve(N,b,x_new);
+        }else{
+            //the given pivot order is unstable for these values
+            if(mcs_splu_analyze_r(G,&S_own)){
+                return -1;
+            }
+            mcs_alloc_splu(S_own,&N_own);
+            failed = mcs_splu_factor(N_own,G->dat);
+            if(!failed){
+                mcs_splu_solve(N_own,b,x_new);
+            }
+            mcs_free_splu(&N_own);
+            mcs_free_splu_symbolic(&S_own);
+            if(failed){
+                return -1;
+            }
+        }
+        mcs_sys_capture("dc_newton",G,b,mcs_prof_now()-t0);
+        converged = 1;
+        for(i=0;i<M->dim;i++){
+            if(!isfinite(x_new[i])){
+                return -1;
+            }
+            if(fabs(x_new[i]-x[i]) > tol*(1.0+fabs(x_new[i]))){
+                converged = 0;
+            }
+            x[i] = x_new[i];
+        }
+        if(converged || linear){
+            return iter;
+        }
+    }
+    return -1;
+}
+
+void mcs_dc_set_stage(mcs_mna* M, double* val, double gmin, double s,
+                      int source){
+    long k;
+    char symbol;
+    if(source){
+        for(k=0;k<M->num_dev;k++){
+            symbol = M->dev[k]->elem.symbol;
+            if(symbol == 'V' || symbol == 'I'){
+                M->val[k] = s*val[k];
+            }
+        }
+    }else if(s < 1.0){
+        M->gmin = pow(MCS_DC_GMIN_START,1.0-s)*pow(gmin,s);
+    }else{
+        M->gmin = gmin;
+    }
+}
+
+long mcs_dc_continue(mcs_mna* M,
+                     mcs_spmat* G,
+                     mcs_splu_numeric* N,
+                     double* x,
+                     double* work,
+                     double tol,
+                     long max_iter,
+                     int source){
+    mcs_mna M_own;
+    double* x_save = &(work[2*M->dim]);
+    double s = 0.0, ds = MCS_DC_FIRST_STEP, s_try;
+    long i, k, iter, stage, solves = 0;
+    if(!source && M->gmin >= MCS_DC_GMIN_START){
+        return -1;
+    }
+    //the stages are solved on a copy with its own element values and gmin
+    M_own = *M;
+    M_own.val = (double*) malloc(sizeof(double)*(M->num_dev+1));
+    for(k=0;k<M->num_dev;k++){
+        M_own.val[k] = M->val[k];
+    }
+    mcs_dc_set_stage(&M_own,M->val,M->gmin,s,source);
+    iter = mcs_dc_newton(&M_own,G,N,x,work,tol,max_iter);
+    solves += (iter < 0) ? max_iter : iter;
+    for(stage=0;iter >= 0 && s < 1.0;stage++){
+        if(stage >= MCS_DC_MAX_STAGE || ds < MCS_DC_MIN_STEP){
+            iter = -1;
+            break;
+        }
+        s_try = (s+ds < 1.0) ? s+ds : 1.0;
+        for(i=0;i<M->dim;i++){
+            x_save[i] = x[i];
+        }
+        mcs_dc_set_stage(&M_own,M->val,M->gmin,s_try,source);
+        //only the last stage needs the full iteration limit
+        iter = mcs_dc_newton(&M_own,G,N,x,work,tol,
+                             (s_try < 1.0) ? MCS_DC_STAGE_ITER : max_iter);
+        if(iter >= 0){
+            solves += iter;
+            s = s_try;
+            if(iter <= MCS_DC_STAGE_ITER/4){
+                ds *= 2.0;
+            }
+        }else{
+            //warm start the shorter step from the last converged stage
+            solves += (s_try < 1.0) ? MCS_DC_STAGE_ITER : max_iter;
+            for(i=0;i<M->dim;i++){
+                x[i] = x_save[i];
+            }
+            ds *= 0.25;
+            iter = 0;
+        }
+    }
+    free(M_own.val);
+    if(iter < 0){
+        return -1;
+    }
+    return solves;
+}
+
+long mcs_dc_newton(mcs_mna* M,
+                   mcs_spmat* G,
+                   mcs_splu_numeric* N,
+                   double* x,
+                   double* work,
+                   double tol,
+                   long max_iter){
+    return mcs_dc_newton_pt(M,G,N,x,NULL,0.0,work,tol,max_iter);
+}
+
+long mcs_dc_gmin_step(mcs_mna* M,
+                      mcs_spmat* G,
+                      mcs_splu_numeric* N,
+                      double* x,
+                      double* work,
+                      double tol,
+                      long max_iter){
+    return mcs_dc_continue(M,G,N,x,work,tol,max_iter,0);
+}
+
+long mcs_dc_source_step(mcs_mna* M,
+                        mcs_spmat* G,
+                        mcs_splu_numeric* N,
+                        double* x,
+                        double* work,
+                        double tol,
+                        long max_iter){
+    return mcs_dc_continue(M,G,N,x,work,tol,max_iter,1);
+}
+
+long mcs_dc_ptran(mcs_mna* M,
+                  mcs_spmat* G,
+                  mcs_splu_numeric* N,
+                  double* x,
+                  double* work,
+                  double tol,
+                  long max_iter){
+    double* x_pt = &(work[2*M->dim]);
+    double g = MCS_DC_PTRAN_START;
+    long i, iter, stage, solves = 0;
+    for(stage=0;stage<MCS_DC_MAX_STAGE;stage++){
+        for(i=0;i<M->dim;i++){
+            x_pt[i] = x[i];
+        }
+        if(g < MCS_DC_PTRAN_END){
+            //the time step is long enough to try for the steady state
+            iter = mcs_dc_newton(M,G,N,x,work,tol,max_iter);
+            if(iter >= 0){
+                return solves + iter;
+            }
+            solves += max_iter;
+            for(i=0;i<M->dim;i++){
+                x[i] = x_pt[i];
+            }
+            g = MCS_DC_PTRAN_END;
+        }
+        iter = mcs_dc_newton_pt(M,G,N,x,x_pt,g,work,tol,MCS_DC_STAGE_ITER);
+        if(iter >= 0){
+            solves += iter;
+            g *= (iter <= MCS_DC_STAGE_ITER/4) ? 0.1 : 0.5;
+        }else{
+            solves += MCS_DC_STAGE_ITER;
+            for(i=0;i<M->dim;i++){
+                x[i] = x_pt[i];
+            }
+            g *= 8.0;
+            if(g > MCS_DC_PTRAN_MAX){
+                return -1;
+            }
+        }
+    }
+    return -1;
+}
+
+long mcs_dc_homotopy(mcs_mna* M,
+                     mcs_spmat* G,
+                     mcs_splu_numeric* N,
+                     double* x,
+                     double* work,
+                     double tol,
+                     long max_iter){
+    double* x0 = &(work[3*M->dim]);
+    long i, iter, solves;
+    for(i=0;i<M->dim;i++){
+        x0[i] = x[i];
+    }
+    iter = mcs_dc_newton(M,G,N,x,work,tol,max_iter);
+    if(iter >= 0){
+        return iter;
+    }
+    solves = max_iter;
+    //each strategy starts over from the initial guess
+    for(i=0;i<M->dim;i++){
+        x[i] = x0[i];
+    }
+    iter = mcs_dc_gmin_step(M,G,N,x,work,tol,max_iter);
+    if(iter < 0){
+        for(i=0;i<M->dim;i++){
+            x[i] = x0[i];
+        }
+        iter = mcs_dc_source_step(M,G,N,x,work,tol,max_iter);
+    }
+    if(iter < 0){
+        for(i=0;i<M->dim;i++){
+            x[i] = x0[i];
+        }
+        iter = mcs_dc_ptran(M,G,N,x,work,tol,max_iter);
+    }
+    if(iter < 0){
+        return -1;
+    }
+    return solves + iter;
+}
+
+long mcs_dc_op(mcs_mna* M, double* x, double tol, long max_iter){
+    mcs_status st;
+    mcs_spmat* G;
+    mcs_splu_symbolic* S;
+    mcs_splu_numeric* N;
+    mcs_amg* H;
+    double* work;
+    double t0;
+    long iter;
+    work = (double*) malloc(sizeof(double)*(4*M->dim+1));
+    mcs_mna_alloc_G(M,&G);
+    if(M->dim >= MCS_DC_AMG_DIM && mcs_mna_is_linear(M)){
+        mcs_mna_stamp_G(M,x,G->dat,work);
+        if(mcs_amg_is_spd(G)){
+            t0 = mcs_prof_now();
+            mcs_status_init(&st);
+            iter = -1;
+            if(mcs_alloc_amg(G,&H,&st) == 0){
+                iter = mcs_amg_pcg(H,work,x,MCS_AMG_TOL,MCS_AMG_MAX_ITER);
+                mcs_free_amg(&H);
+            }
+            mcs_sys_capture("dc_amg",G,work,mcs_prof_now()-t0);
+            if(iter >= 0){
+                mcs_free_spmat(&G);
+                free(work);
+                return 1;
+            }
+        }
+    }
+    //choose the pivot order with the values at the initial guess
+    mcs_mna_stamp_G(M,x,G->dat,NULL);
+    if(mcs_splu_analyze_r(G,&S)){
+        mcs_free_spmat(&G);
+        free(work);
+        return -1;
+    }
+    mcs_alloc_splu(S,&N);
+    iter = mcs_dc_homotopy(M,G,N,x,work,tol,max_iter);
+    mcs_free_splu(&N);
+    mcs_free_splu_symbolic(&S);
+    mcs_free_spmat(&G);
+    free(work);
+    return iter;
+}
@@ -0,0 +1,183 @@
+#ifndef MCS_DC_ANALYSIS_H
+#define MCS_DC_ANALYSIS_H
+
+/*
+ * DC operating point analysis for MicroCircSim by Bram Rodgers.
+ * Based on Chapter 3 of the textbook
+ * ``Circuit Simulation'' by Farid N. Najm.
+ *
+ * Capacitors are open circuits and inductors are short circuits.
+ * Nonlinear devices are solved with Newton's method, where every Newton
+ * step reuses the sparsity pattern and pivot order of the first step.
+ *
+ * When Newton's method fails from the initial guess, mcs_dc_op falls
+ * back to continuation, which solves a sequence of easier circuits
+ * ending with the original one, warm starting each from the last:
+ * ->gmin stepping:   every node has a large conductance to ground,
+ *                    which is reduced geometrically to M->gmin.
+ * ->source stepping: every V and I source is ramped up from zero.
+ * ->pseudo-transient: every node has a unit capacitor, and backward
+ *                    Euler steps of growing length are taken until
+ *                    the circuit settles at its operating point.
+ * Step lengths adapt, growing after stages which converge quickly and
+ * shrinking after stages which fail.
+ *
+ * Large linear circuits whose conductance matrix is symmetric positive
+ * definite, such as resistor and current source networks, are solved
+ * with multigrid preconditioned conjugate gradients instead of LU.
+ *
+ * Linear solves which are slow may be captured for offline study,
+ * see matrix_io.h.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../mna_system/mna_system.h"
+#include"../sparse_lu/sparse_lu.h"
+#include"../amg_solver/amg_solver.h"
+#include"../matrix_io/matrix_io.h"
+
+/*
+ * Default relative tolerance and iteration limit of Newton's method.
+ */
+#define MCS_DC_TOL      1.0e-9
+#define MCS_DC_MAX_ITER 100
+
+/*
+ * Smallest linear circuit which is tested for a symmetric positive
+ * definite G and then solved with mcs_amg_pcg.
+ */
+#define MCS_DC_AMG_DIM  1000
+
+/*
+ * Continuation control. A stage is one Newton solve along the path, and
+ * is limited to MCS_DC_STAGE_ITER iterations except for the last.
+ */
+#define MCS_DC_STAGE_ITER   20      /*Newton iterations of a stage*/
+#define MCS_DC_MAX_STAGE    200     /*Stages before continuation fails*/
+#define MCS_DC_FIRST_STEP   0.1     /*First step in the continuation path*/
+#define MCS_DC_MIN_STEP     1.0e-4  /*Continuation fails below this step*/
+#define MCS_DC_GMIN_START   1.0e-2  /*First gmin of gmin stepping*/
+#define MCS_DC_PTRAN_START  1.0e-2  /*First 1/h of pseudo-transient*/
+#define MCS_DC_PTRAN_END    1.0e-9  /*1/h at which steady state is tried*/
+#define MCS_DC_PTRAN_MAX    1.0e3   /*Pseudo-transient fails above this 1/h*/
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Solve for the DC operating point of the circuit M.
+ * x holds an initial guess on entry and the operating point on exit.
+ * x has M->dim entries.
+ *
+ * Newton iterations stop once every entry of x changes by less than
+ * tol*(1+|x[i]|). Linear circuits are solved with a single iteration.
+ * When mcs_amg_pcg is used, the relative residual is reduced to
+ * MCS_AMG_TOL, falling back to LU if that fails.
+ *
+ * Returns the number of Newton iterations used, or -1 if neither Newton
+ * nor continuation converged. When continuation was needed, the count
+ * is that of mcs_dc_homotopy. -1 is also returned if the Jacobian at the
+ * initial guess has no pivot order.
+ */
+long mcs_dc_op(mcs_mna* M, double* x, double tol, long max_iter);
+
+/*
+ * The Newton iteration of mcs_dc_op with caller owned storage, so that
+ * repeated solves of one circuit skip all setup.
+ *
+ * G is a matrix allocated by mcs_mna_alloc_G(M,&G). N holds numeric factors
+ * of a symbolic analysis of G, which may be shared with other threads.
+ * If a Newton step is unstable with the pivot order of N, that step uses
+ * its own symbolic analysis. work has 2*M->dim entries.
+ *
+ * Arguments and return value are otherwise the same as mcs_dc_op, except
+ * that -1 is also returned when that symbolic analysis finds G singular.
+ * mcs_dc_newton never exits the process.
+ */
+long mcs_dc_newton(mcs_mna* M,
+                   mcs_spmat* G,
+                   mcs_splu_numeric* N,
+                   double* x,
+                   double* work,
+                   double tol,
+                   long max_iter);
+
+/*
+ * Solve for the DC operating point of M with gmin stepping. Arguments
+ * are those of mcs_dc_newton, except that work has 3*M->dim entries.
+ * max_iter limits the first and last stages.
+ *
+ * The stages are solved on a copy of M with its own gmin, so M is not
+ * changed and may be shared with other threads. Returns the number of
+ * Newton iterations of all stages, or -1 if the continuation failed, in
+ * which case x holds the last converged stage.
+ */
+long mcs_dc_gmin_step(mcs_mna* M,
+                      mcs_spmat* G,
+                      mcs_splu_numeric* N,
+                      double* x,
+                      double* work,
+                      double tol,
+                      long max_iter);
+
+/*
+ * Solve for the DC operating point of M with source stepping, the same
+ * as mcs_dc_gmin_step except that the copy of M has its own V and I
+ * values.
+ */
+long mcs_dc_source_step(mcs_mna* M,
+                        mcs_spmat* G,
+                        mcs_splu_numeric* N,
+                        double* x,
+                        double* work,
+                        double tol,
+                        long max_iter);
+
+/*
+ * Solve for the DC operating point of M with pseudo-transient
+ * continuation. Arguments and return value are those of
+ * mcs_dc_gmin_step. M is not changed.
+ */
+long mcs_dc_ptran(mcs_mna* M,
+                  mcs_spmat* G,
+                  mcs_splu_numeric* N,
+                  double* x,
+                  double* work,
+                  double tol,
+                  long max_iter);
+
+/*
+ * mcs_dc_newton, falling back to mcs_dc_gmin_step, mcs_dc_source_step,
+ * and then mcs_dc_ptran, each started from the initial guess, until
+ * one converges. work has 4*M->dim entries.
+ *
+ * Returns the number of Newton iterations if plain Newton converged.
+ * Otherwise returns max_iter, the limit of the failed plain Newton
+ * attempt, plus the iterations of the strategy which converged, or -1 if
+ * every strategy failed. A fallback strategy which fails does not report
+ * its iterations, so those are not counted.
+ */
+long mcs_dc_homotopy(mcs_mna* M,
+                     mcs_spmat* G,
+                     mcs_splu_numeric* N,
+                     double* x,
+                     double* work,
+                     double tol,
+                     long max_iter);
+
+#endif
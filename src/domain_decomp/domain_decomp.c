@@ -0,0 +1,589 @@
+/*
+ * Implementation for:
+ * Domain decomposition solver for large circuit matrices by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "domain_decomp.h"
+
+/*
+ * Locally used helper functions:
+ */
+
+long mcs_dd_bfs(long* adj_p, long* adj, long root,
+                long* level, long* order, long start);
+long mcs_dd_find(long* parent, long i);
+void mcs_dd_pattern(mcs_dd* D);
+int mcs_dd_factor_dom(mcs_dd* D, mcs_dd_dom* d, double* dat);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Breadth first search of the graph with adjacency lists adj_p, adj from
+ * root, visiting only unknowns with level[i] < 0. The visited unknowns
+ * are written to order starting at order[start] and get their distance
+ * from root in level. Returns the number of unknowns visited.
+ */
+long mcs_dd_bfs(long* adj_p, long* adj, long root,
+                long* level, long* order, long start){
+    long head = start, tail = start, i, p;
+    order[tail++] = root;
+    level[root] = 0;
+    while(head < tail){
+        i = order[head++];
+        for(p=adj_p[i];p<adj_p[i+1];p++){
+            if(level[adj[p]] < 0){
+                level[adj[p]] = level[i]+1;
+                order[tail++] = adj[p];
+            }
+        }
+    }
+    return tail - start;
+}
+
+/*
+ * Root of the set of i in the union find forest parent, halving the
+ * path on the way up.
+ */
+long mcs_dd_find(long* parent, long i){
+    while(parent[i] != i){
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/*
+ * Build D->Sch, the coordinate pattern of the Schur complement sorted by
+ * column, and D->I_q. Column j of A_d^(-1) * B_d is zero outside the
+ * connected pieces of A_d which hold a row of column j of B_d, so column
+ * j of S only has rows of E_d entries in those pieces, plus A_I.
+ */
+void mcs_dd_pattern(mcs_dd* D){
+    mcs_dd_dom* d;
+    long ni = D->num_if;
+    long i, j, k, p, q, t, nnz, cap;
+    long *parent, *ce_p, *ce_r, *I_p, *I_e, *mark, *cmark, *pos, *r, *c;
+    parent = (long*) malloc(sizeof(long)*(D->n+1));
+    ce_p = (long*) calloc(D->n+2,sizeof(long));
+    for(i=0;i<D->n;i++){
+        parent[i] = i;
+    }
+    //connected pieces of every A_d, named by a source matrix index
+    for(t=0;t<D->num_dom;t++){
+        d = &(D->dom[t]);
+        for(k=0;k<d->A->nnz;k++){
+            i = mcs_dd_find(parent,d->idx[d->A->r[k]]);
+            j = mcs_dd_find(parent,d->idx[d->A->c[k]]);
+            parent[i] = j;
+        }
+    }
+    //rows of E_d in each piece, ce_p[i] starts the list of root i
+    for(t=0;t<D->num_dom;t++){
+        d = &(D->dom[t]);
+        for(p=0;p<d->num_E;p++){
+            ce_p[mcs_dd_find(parent,d->idx[d->E_c[p]])+2]++;
+        }
+    }
+    for(i=0;i<D->n;i++){
+        ce_p[i+2] += ce_p[i+1];
+    }
+    ce_r = (long*) malloc(sizeof(long)*(ce_p[D->n+1]+1));
+    for(t=0;t<D->num_dom;t++){
+        d = &(D->dom[t]);
+        for(p=0;p<d->num_E;p++){
+            i = mcs_dd_find(parent,d->idx[d->E_c[p]]);
+            ce_r[ce_p[i+1]++] = d->E_r[p];
+        }
+    }
+    //entries of A_I by column
+    I_p = (long*) calloc(ni+2,sizeof(long));
+    I_e = (long*) malloc(sizeof(long)*(D->num_I+1));
+    for(k=0;k<D->num_I;k++){
+        I_p[D->I_c[k]+2]++;
+    }
+    for(j=0;j<ni;j++){
+        I_p[j+2] += I_p[j+1];
+    }
+    for(k=0;k<D->num_I;k++){
+        I_e[I_p[D->I_c[k]+1]++] = k;
+    }
+    mark = (long*) malloc(sizeof(long)*(ni+1));
+    pos = (long*) malloc(sizeof(long)*(ni+1));
+    cmark = (long*) malloc(sizeof(long)*(D->n+1));
+    for(i=0;i<ni;i++){
+        mark[i] = -1;
+    }
+    for(i=0;i<D->n;i++){
+        cmark[i] = -1;
+    }
+    cap = D->num_I + ni + 1;
+    r = (long*) malloc(sizeof(long)*cap);
+    c = (long*) malloc(sizeof(long)*cap);
+    nnz = 0;
+    for(j=0;j<ni;j++){
+        D->Sch_p[j] = nnz;
+        for(p=I_p[j];p<I_p[j+1];p++){
+            i = D->I_r[I_e[p]];
+            if(mark[i] != j){
+                mark[i] = j;
+                pos[i] = nnz;
+                r[nnz] = i;
+                c[nnz++] = j;
+            }
+            D->I_q[I_e[p]] = pos[i];
+        }
+        for(t=0;t<D->num_dom;t++){
+            d = &(D->dom[t]);
+            for(p=d->B_p[j];p<d->B_p[j+1];p++){
+                k = mcs_dd_find(parent,d->idx[d->B_r[p]]);
+                if(cmark[k] == j){
+                    continue;
+                }
+                cmark[k] = j;
+                if(nnz + ce_p[k+1]-ce_p[k] > cap){
+                    cap = 2*cap + ce_p[k+1]-ce_p[k];
+                    r = (long*) realloc(r,sizeof(long)*cap);
+                    c = (long*) realloc(c,sizeof(long)*cap);
+                }
+                for(q=ce_p[k];q<ce_p[k+1];q++){
+                    i = ce_r[q];
+                    if(mark[i] != j){
+                        mark[i] = j;
+                        r[nnz] = i;
+                        c[nnz++] = j;
+                    }
+                }
+            }
+        }
+    }
+    D->Sch_p[ni] = nnz;
+    mcs_alloc_spmat(&(D->Sch),nnz,ni,ni);
+    for(k=0;k<nnz;k++){
+        D->Sch->r[k] = r[k];
+        D->Sch->c[k] = c[k];
+    }
+    free(c);
+    free(r);
+    free(cmark);
+    free(pos);
+    free(mark);
+    free(I_e);
+    free(I_p);
+    free(ce_r);
+    free(ce_p);
+    free(parent);
+}
+
+/*
+ * Factor A_d and subtract E_d * A_d^(-1) * B_d from the Schur complement
+ * D->Sch, one interface column of B_d at a time. Returns 0, or 1 if A_d
+ * is singular.
+ */
+int mcs_dd_factor_dom(mcs_dd* D, mcs_dd_dom* d, double* dat){
+    mcs_splu_symbolic* S;
+    long i, j, k, p, q;
+    double* w;
+    if(d->n == 0){
+        return 0;
+    }
+    for(k=0;k<d->A->nnz;k++){
+        d->A->dat[k] = dat[d->A_k[k]];
+    }
+    if(mcs_splu_factor(d->N,d->A->dat)){
+        //the fixed pivot order failed, so pick a new one for these values
+        if(mcs_splu_analyze_r(d->A,&S)){
+            return 1;
+        }
+        mcs_free_splu(&(d->N));
+        mcs_free_splu_symbolic(&(d->S));
+        d->S = S;
+        mcs_alloc_splu(d->S,&(d->N));
+        if(mcs_splu_factor(d->N,d->A->dat)){
+            return 1;
+        }
+    }
+    w = (double*) calloc(D->num_if+1,sizeof(double));
+    for(j=0;j<D->num_if;j++){
+        if(d->B_p[j] == d->B_p[j+1]){
+            continue;
+        }
+        for(k=0;k<d->n;k++){
+            d->y[k] = 0.0;
+        }
+        for(p=d->B_p[j];p<d->B_p[j+1];p++){
+            d->y[d->B_r[p]] += dat[d->B_k[p]];
+        }
+        mcs_splu_solve(d->N,d->y,d->y);
+        for(p=0;p<d->num_E;p++){
+            w[d->E_r[p]] += dat[d->E_k[p]]*d->y[d->E_c[p]];
+        }
+        for(q=D->Sch_p[j];q<D->Sch_p[j+1];q++){
+            i = D->Sch->r[q];
+            if(w[i] != 0.0){
+                #pragma omp atomic
+                D->Sch->dat[q] -= w[i];
+            }
+        }
+        for(p=0;p<d->num_E;p++){
+            w[d->E_r[p]] = 0.0;
+        }
+    }
+    free(w);
+    return 0;
+}
+
+long mcs_dd_partition(mcs_spmat* A, long num_dom, long* part){
+    long n = A->r_len;
+    long i, j, k, p, root, seen, last, num_if;
+    long *adj_p, *adj, *level, *order, *diag;
+    adj_p = (long*) calloc(n+1,sizeof(long));
+    adj = (long*) malloc(sizeof(long)*(2*A->nnz+1));
+    level = (long*) malloc(sizeof(long)*n);
+    order = (long*) malloc(sizeof(long)*n);
+    diag = (long*) calloc(n,sizeof(long));
+    //adjacency lists of the symmetrized pattern
+    for(k=0;k<A->nnz;k++){
+        if(A->r[k] == A->c[k]){
+            diag[A->r[k]] = 1;
+            continue;
+        }
+        adj_p[A->r[k]+1]++;
+        adj_p[A->c[k]+1]++;
+    }
+    for(i=0;i<n;i++){
+        adj_p[i+1] += adj_p[i];
+        level[i] = adj_p[i];
+    }
+    for(k=0;k<A->nnz;k++){
+        if(A->r[k] != A->c[k]){
+            adj[level[A->r[k]]++] = A->c[k];
+            adj[level[A->c[k]]++] = A->r[k];
+        }
+    }
+    //breadth first ordering of each connected component, started from
+    //the last unknown reached by a search from its first unknown.
+    for(i=0;i<n;i++){
+        level[i] = -1;
+    }
+    seen = 0;
+    for(root=0;root<n;root++){
+        if(level[root] >= 0){
+            continue;
+        }
+        k = mcs_dd_bfs(adj_p,adj,root,level,order,seen);
+        last = order[seen+k-1];
+        for(p=seen;p<seen+k;p++){
+            level[order[p]] = -1;
+        }
+        seen += mcs_dd_bfs(adj_p,adj,last,level,order,seen);
+    }
+    for(p=0;p<n;p++){
+        part[order[p]] = (p*num_dom)/n;
+    }
+    //separate the subdomains
+    num_if = 0;
+    for(i=0;i<n;i++){
+        k = part[i];
+        for(p=adj_p[i];p<adj_p[i+1];p++){
+            j = adj[p];
+            if(part[j] < k){
+                part[i] = num_dom;
+                num_if++;
+                break;
+            }
+        }
+    }
+    for(i=0;i<n;i++){
+        if(diag[i] || part[i] == num_dom){
+            continue;
+        }
+        for(p=adj_p[i];p<adj_p[i+1];p++){
+            if(part[adj[p]] == num_dom){
+                part[i] = num_dom;
+                num_if++;
+                break;
+            }
+        }
+    }
+    free(diag);
+    free(order);
+    free(level);
+    free(adj);
+    free(adj_p);
+    return num_if;
+}
+
+int mcs_alloc_dd(mcs_spmat* A, long num_dom, mcs_dd** D, mcs_status* st){
+    mcs_dd* T;
+    mcs_dd_dom* d;
+    long n = A->r_len;
+    long i, k, r, c, t, num_fail = 0;
+    long* cnt;
+    T = (mcs_dd*) malloc(sizeof(mcs_dd));
+    T->n = n;
+    T->nnz = A->nnz;
+    T->num_dom = num_dom;
+    T->part = (long*) malloc(sizeof(long)*(n+1));
+    T->loc = (long*) malloc(sizeof(long)*(n+1));
+    T->num_if = mcs_dd_partition(A,num_dom,T->part);
+    T->if_idx = (long*) malloc(sizeof(long)*(T->num_if+1));
+    T->dom = (mcs_dd_dom*) calloc(num_dom,sizeof(mcs_dd_dom));
+    cnt = (long*) calloc(num_dom+1,sizeof(long));
+    for(i=0;i<n;i++){
+        T->loc[i] = cnt[T->part[i]]++;
+        if(T->part[i] == num_dom){
+            T->if_idx[T->loc[i]] = i;
+        }
+    }
+    for(t=0;t<num_dom;t++){
+        d = &(T->dom[t]);
+        d->n = cnt[t];
+        d->idx = (long*) malloc(sizeof(long)*(d->n+1));
+        d->B_p = (long*) calloc(T->num_if+1,sizeof(long));
+        d->y = (double*) malloc(sizeof(double)*(d->n+1));
+    }
+    for(i=0;i<n;i++){
+        if(T->part[i] < num_dom){
+            T->dom[T->part[i]].idx[T->loc[i]] = i;
+        }
+    }
+    //count the entries of each block, cnt[t] counts the entries of A_d
+    for(t=0;t<=num_dom;t++){
+        cnt[t] = 0;
+    }
+    T->num_I = 0;
+    for(k=0;k<A->nnz;k++){
+        r = T->part[A->r[k]];
+        c = T->part[A->c[k]];
+        if(r < num_dom && c < num_dom){
+            cnt[r]++;
+        }else if(r < num_dom){
+            T->dom[r].num_B++;
+            T->dom[r].B_p[T->loc[A->c[k]]+1]++;
+        }else if(c < num_dom){
+            T->dom[c].num_E++;
+        }else{
+            T->num_I++;
+        }
+    }
+    for(t=0;t<num_dom;t++){
+        d = &(T->dom[t]);
+        mcs_alloc_spmat(&(d->A),cnt[t],d->n,d->n);
+        d->A_k = (long*) malloc(sizeof(long)*(cnt[t]+1));
+        for(i=0;i<T->num_if;i++){
+            d->B_p[i+1] += d->B_p[i];
+        }
+        d->B_r = (long*) malloc(sizeof(long)*(d->num_B+1));
+        d->B_k = (long*) malloc(sizeof(long)*(d->num_B+1));
+        d->E_r = (long*) malloc(sizeof(long)*(d->num_E+1));
+        d->E_c = (long*) malloc(sizeof(long)*(d->num_E+1));
+        d->E_k = (long*) malloc(sizeof(long)*(d->num_E+1));
+        d->A->nnz = 0;
+        d->num_E = 0;
+    }
+    T->I_r = (long*) malloc(sizeof(long)*(T->num_I+1));
+    T->I_c = (long*) malloc(sizeof(long)*(T->num_I+1));
+    T->I_k = (long*) malloc(sizeof(long)*(T->num_I+1));
+    T->num_I = 0;
+    //fill the blocks, B_p[j] walks through interface column j of B_d
+    for(k=0;k<A->nnz;k++){
+        r = T->part[A->r[k]];
+        c = T->part[A->c[k]];
+        if(r < num_dom && c < num_dom){
+            d = &(T->dom[r]);
+            d->A->r[d->A->nnz] = T->loc[A->r[k]];
+            d->A->c[d->A->nnz] = T->loc[A->c[k]];
+            d->A->dat[d->A->nnz] = A->dat[k];
+            d->A_k[d->A->nnz++] = k;
+        }else if(r < num_dom){
+            d = &(T->dom[r]);
+            i = d->B_p[T->loc[A->c[k]]]++;
+            d->B_r[i] = T->loc[A->r[k]];
+            d->B_k[i] = k;
+        }else if(c < num_dom){
+            d = &(T->dom[c]);
+            d->E_r[d->num_E] = T->loc[A->r[k]];
+            d->E_c[d->num_E] = T->loc[A->c[k]];
+            d->E_k[d->num_E++] = k;
+        }else{
+            T->I_r[T->num_I] = T->loc[A->r[k]];
+            T->I_c[T->num_I] = T->loc[A->c[k]];
+            T->I_k[T->num_I++] = k;
+        }
+    }
+    #pragma omp parallel for private(d) schedule(dynamic) \
+                             reduction(+:num_fail)
+    for(t=0;t<num_dom;t++){
+        d = &(T->dom[t]);
+        //shift the column pointers of B_d back to column starts
+        for(i=T->num_if;i>0;i--){
+            d->B_p[i] = d->B_p[i-1];
+        }
+        d->B_p[0] = 0;
+        d->S = NULL;
+        d->N = NULL;
+        if(d->n > 0){
+            if(mcs_splu_analyze_r(d->A,&(d->S))){
+                num_fail++;
+            }else{
+                mcs_alloc_splu(d->S,&(d->N));
+            }
+        }
+    }
+    T->I_q = (long*) malloc(sizeof(long)*(T->num_I+1));
+    T->Sch_p = (long*) malloc(sizeof(long)*(T->num_if+1));
+    mcs_dd_pattern(T);
+    T->S = NULL;
+    T->N = NULL;
+    T->dat = (double*) malloc(sizeof(double)*(A->nnz+1));
+    T->g = (double*) malloc(sizeof(double)*(T->num_if+1));
+    free(cnt);
+    if(num_fail > 0){
+        mcs_free_dd(&T);
+        *D = NULL;
+        return mcs_raise(st,MCS_SINGULAR_MATRIX);
+    }
+    *D = T;
+    return 0;
+}
+
+void mcs_free_dd(mcs_dd** D){
+    mcs_dd_dom* d;
+    long t;
+    for(t=0;t<(*D)->num_dom;t++){
+        d = &((*D)->dom[t]);
+        if(d->N != NULL){
+            mcs_free_splu(&(d->N));
+        }
+        if(d->S != NULL){
+            mcs_free_splu_symbolic(&(d->S));
+        }
+        free(d->y);
+        free(d->E_k);
+        free(d->E_c);
+        free(d->E_r);
+        free(d->B_k);
+        free(d->B_r);
+        free(d->B_p);
+        free(d->A_k);
+        mcs_free_spmat(&(d->A));
+        free(d->idx);
+    }
+    if((*D)->N != NULL){
+        mcs_free_splu(&((*D)->N));
+        mcs_free_splu_symbolic(&((*D)->S));
+    }
+    free((*D)->g);
+    free((*D)->dat);
+    mcs_free_spmat(&((*D)->Sch));
+    free((*D)->Sch_p);
+    free((*D)->I_q);
+    free((*D)->I_k);
+    free((*D)->I_c);
+    free((*D)->I_r);
+    free((*D)->dom);
+    free((*D)->if_idx);
+    free((*D)->loc);
+    free((*D)->part);
+    free(*D);
+}
+
+int mcs_dd_factor(mcs_dd* D, double* dat){
+    mcs_splu_symbolic* S;
+    long k, t, num_fail = 0;
+    for(k=0;k<D->nnz;k++){
+        D->dat[k] = dat[k];
+    }
+    for(k=0;k<D->Sch->nnz;k++){
+        D->Sch->dat[k] = 0.0;
+    }
+    for(k=0;k<D->num_I;k++){
+        D->Sch->dat[D->I_q[k]] += dat[D->I_k[k]];
+    }
+    #pragma omp parallel for schedule(dynamic) reduction(+:num_fail)
+    for(t=0;t<D->num_dom;t++){
+        num_fail += mcs_dd_factor_dom(D,&(D->dom[t]),D->dat);
+    }
+    if(num_fail > 0){
+        return 1;
+    }
+    if(D->num_if == 0){
+        return 0;
+    }
+    if(D->N != NULL && mcs_splu_factor(D->N,D->Sch->dat) == 0){
+        return 0;
+    }
+    //the first factorization, or the pivot order of S failed
+    if(mcs_splu_analyze_r(D->Sch,&S)){
+        return 1;
+    }
+    if(D->N != NULL){
+        mcs_free_splu(&(D->N));
+        mcs_free_splu_symbolic(&(D->S));
+    }
+    D->S = S;
+    mcs_alloc_splu(D->S,&(D->N));
+    return mcs_splu_factor(D->N,D->Sch->dat);
+}
+
+void mcs_dd_solve(mcs_dd* D, double* b, double* x){
+    mcs_dd_dom* d;
+    long i, k, p, t, ni = D->num_if;
+    double v;
+    for(i=0;i<ni;i++){
+        D->g[i] = b[D->if_idx[i]];
+    }
+    //g = b_I - sum_d E_d * A_d^(-1) * b_d
+    #pragma omp parallel for private(d,k,p,v) schedule(dynamic)
+    for(t=0;t<D->num_dom;t++){
+        d = &(D->dom[t]);
+        if(d->n == 0){
+            continue;
+        }
+        for(k=0;k<d->n;k++){
+            d->y[k] = b[d->idx[k]];
+        }
+        mcs_splu_solve(d->N,d->y,d->y);
+        for(p=0;p<d->num_E;p++){
+            v = D->dat[d->E_k[p]]*d->y[d->E_c[p]];
+            #pragma omp atomic
+            D->g[d->E_r[p]] -= v;
+        }
+    }
+    if(ni > 0){
+        mcs_splu_solve(D->N,D->g,D->g);
+    }
+    //x_d = A_d^(-1) * (b_d - B_d * x_I)
+    #pragma omp parallel for private(d,i,k,p) schedule(dynamic)
+    for(t=0;t<D->num_dom;t++){
+        d = &(D->dom[t]);
+        if(d->n == 0){
+            continue;
+        }
+        for(k=0;k<d->n;k++){
+            d->y[k] = b[d->idx[k]];
+        }
+        for(i=0;i<ni;i++){
+            for(p=d->B_p[i];p<d->B_p[i+1];p++){
+                d->y[d->B_r[p]] -= D->dat[d->B_k[p]]*D->g[i];
+            }
+        }
+        mcs_splu_solve(d->N,d->y,d->y);
+        for(k=0;k<d->n;k++){
+            x[d->idx[k]] = d->y[k];
+        }
+    }
+    for(i=0;i<ni;i++){
+        x[D->if_idx[i]] = D->g[i];
+    }
+}
@@ -0,0 +1,142 @@
+#ifndef MCS_DOMAIN_DECOMP_H
+#define MCS_DOMAIN_DECOMP_H
+
+/*
+ * Domain decomposition solver for large circuit matrices by Bram Rodgers.
+ *
+ * The unknowns are split into num_dom subdomains and a set of interface
+ * unknowns such that no matrix entry couples two different subdomains.
+ * With the subdomains ordered first the matrix has the block form
+ *
+ *      [ A_1             B_1 ]
+ *      [      A_2        B_2 ]
+ *      [           ...   ... ]
+ *      [ E_1  E_2  ...   A_I ]
+ *
+ * Every A_d is factored with sparse_lu, in parallel over subdomains.
+ * The interface is coupled through the Schur complement
+ *      S = A_I - sum_d E_d * A_d^(-1) * B_d
+ * which only couples interface unknowns next to the same connected piece
+ * of a subdomain. S is stored with that pattern and factored with
+ * sparse_lu as well, so it stays sparse when there are many subdomains.
+ * A solve is two parallel sweeps over the subdomains around one sparse
+ * solve with S.
+ *
+ * The partition comes from the structural graph of the matrix, so the
+ * subdomain blocks are analyzed once and only refactored when values
+ * change, just like a monolithic sparse_lu factorization.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../sparse_lu/sparse_lu.h"
+#include"../error_handling/error_handling.h"
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * One subdomain. The blocks are stored as lists of coordinate entries of
+ * the source matrix, so they are filled straight from its values.
+ */
+typedef struct _mcs_dd_dom{
+    long n;                 /*Number of unknowns in this subdomain*/
+    long* idx;              /*Source matrix index of each unknown*/
+    mcs_spmat* A;           /*Coordinate pattern and values of A_d*/
+    long* A_k;              /*Source coordinate entry of each entry of A*/
+    long num_B;             /*Number of entries of B_d*/
+    long* B_p;              /*Entries of B_d sorted by interface column*/
+    long* B_r;              /*Local row of each entry of B_d*/
+    long* B_k;              /*Source coordinate entry of each entry of B_d*/
+    long num_E;             /*Number of entries of E_d*/
+    long* E_r;              /*Interface row of each entry of E_d*/
+    long* E_c;              /*Local column of each entry of E_d*/
+    long* E_k;              /*Source coordinate entry of each entry of E_d*/
+    mcs_splu_symbolic* S;   /*Symbolic analysis of A_d, or NULL if empty*/
+    mcs_splu_numeric* N;    /*Numeric factors of A_d, or NULL if empty*/
+    double* y;              /*Workspace of length n*/
+} mcs_dd_dom;
+
+typedef struct _mcs_dd{
+    long n;             /*Number of rows and columns of the source matrix*/
+    long nnz;           /*Number of coordinate entries of the source matrix*/
+    long num_dom;       /*Number of subdomains*/
+    long* part;         /*Subdomain of each unknown, num_dom on the interface*/
+    long* loc;          /*Index of each unknown in its subdomain or interface*/
+    mcs_dd_dom* dom;    /*The subdomains*/
+    long num_if;        /*Number of interface unknowns*/
+    long* if_idx;       /*Source matrix index of each interface unknown*/
+    long num_I;         /*Number of entries of A_I*/
+    long* I_r;          /*Interface row of each entry of A_I*/
+    long* I_c;          /*Interface column of each entry of A_I*/
+    long* I_k;          /*Source coordinate entry of each entry of A_I*/
+    long* I_q;          /*Entry of Sch of each entry of A_I*/
+    mcs_spmat* Sch;     /*Pattern and values of S, sorted by column*/
+    long* Sch_p;        /*First entry of each column of Sch*/
+    mcs_splu_symbolic* S;   /*Symbolic analysis of S, or NULL*/
+    mcs_splu_numeric* N;    /*Numeric factors of S, or NULL*/
+    double* dat;        /*Copy of the source values from the last factor*/
+    double* g;          /*Workspace of length num_if*/
+} mcs_dd;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Partition the unknowns of the square matrix A into num_dom subdomains
+ * and an interface. Subdomains are consecutive slices of a breadth first
+ * ordering from a pseudo-peripheral unknown, and an unknown is moved to
+ * the interface whenever it touches an unknown of a lower subdomain.
+ * Unknowns with no diagonal entry which touch the interface are moved to
+ * it as well, so MNA branch currents stay with their nodes.
+ *
+ * On exit part[i] is the subdomain of unknown i, or num_dom if i is on
+ * the interface. Returns the number of interface unknowns.
+ */
+long mcs_dd_partition(mcs_spmat* A, long num_dom, long* part);
+
+/*
+ * Partition A, build the subdomain blocks, and analyze each A_d using
+ * the values in A->dat. No numeric factorization is done.
+ *
+ * Returns 0. If some A_d has no pivot order, then returns 1 with *D set
+ * to NULL after recording MCS_SINGULAR_MATRIX in st. If st is NULL then
+ * mcs_error is called instead.
+ */
+int mcs_alloc_dd(mcs_spmat* A, long num_dom, mcs_dd** D, mcs_status* st);
+
+/*
+ * Free a domain decomposition and its factors. A is not freed.
+ */
+void mcs_free_dd(mcs_dd** D);
+
+/*
+ * Factor the matrix whose coordinate format values are dat, ordered as
+ * the matrix given to mcs_alloc_dd. A subdomain whose fixed pivot order
+ * fails is analyzed again with the new values. S is analyzed at the first
+ * call, and again whenever its pivot order fails.
+ *
+ * Returns 0 on success, or 1 if a subdomain block or the Schur
+ * complement is singular.
+ */
+int mcs_dd_factor(mcs_dd* D, double* dat);
+
+/*
+ * Solve A*x = b using the last factorization. b and x may be the same
+ * array. Not safe to call from several threads on the same D.
+ */
+void mcs_dd_solve(mcs_dd* D, double* b, double* x);
+
+#endif
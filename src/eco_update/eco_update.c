@@ -0,0 +1,499 @@
+/*
+ * Implementation for:
+ * Incremental edits of a loaded circuit by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "eco_update.h"
+#include "../sparse_matrix/vector_math.h"
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Entry i of z, where ground, i = -1, is 0.
+ */
+double mcs_eco_at(const double* z, long i);
+
+/*
+ * Return 1 if s is the symbol of a circuit element.
+ */
+int mcs_eco_known(char s);
+
+/*
+ * Free G0 and its factors.
+ */
+void mcs_eco_unfactor(mcs_eco* E);
+
+/*
+ * Factor G0 of the circuit as it is now and drop the columns of the
+ * update. Returns 0, or 1 if G0 is singular.
+ */
+int mcs_eco_refactor(mcs_eco* E);
+
+/*
+ * Add dg*(e_a - e_b)*(e_a - e_b)^T to the update.
+ */
+void mcs_eco_column(mcs_eco* E, long a, long b, double dg);
+
+/*
+ * Add s times the DC matrix entries of the element at position k of
+ * ctx->M to the update.
+ */
+void mcs_eco_stamp(mcs_eco* E, long k, double s);
+
+/*
+ * Free the matrix, factors, and generated code of the context, which no
+ * longer fit the circuit once an element is added or removed.
+ */
+void mcs_eco_restructure(mcs_eco* E);
+
+/*
+ * Resize ctx->x after the number of unknowns changed. br is the branch
+ * current which was removed, or -1 if one was added at the end.
+ */
+void mcs_eco_resize(mcs_eco* E, long br);
+
+/*
+ * Factor K = I + D*V^T*Z with partial pivoting.
+ * Returns 0, or 1 if a pivot is smaller than MCS_ECO_PIV_MIN.
+ */
+int mcs_eco_factor_K(mcs_eco* E);
+
+/*
+ * Overwrite c with K^(-1)*c.
+ */
+void mcs_eco_solve_K(mcs_eco* E, double* c);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+double mcs_eco_at(const double* z, long i){
+    return (i < 0) ? 0.0 : z[i];
+}
+
+int mcs_eco_known(char s){
+    switch(s){
+        case 'V':
+        case 'I':
+        case 'R':
+        case 'C':
+        case 'L':
+        case 'D':
+        case 'Q':
+        case 'M':
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+void mcs_eco_unfactor(mcs_eco* E){
+    if(E->N != NULL){
+        mcs_free_splu(&(E->N));
+        mcs_free_splu_symbolic(&(E->S));
+        E->N = NULL;
+        E->S = NULL;
+    }
+    if(E->G != NULL){
+        mcs_free_spmat(&(E->G));
+        E->G = NULL;
+    }
+}
+
+int mcs_eco_refactor(mcs_eco* E){
+    mcs_mna* M = E->ctx->M;
+    mcs_eco_unfactor(E);
+    //the values of a linear circuit do not depend on x
+    mcs_mna_alloc_G(M,&(E->G));
+    if(mcs_splu_analyze_r(E->G,&(E->S))){
+        mcs_free_spmat(&(E->G));
+        E->G = NULL;
+        E->S = NULL;
+        return 1;
+    }
+    mcs_alloc_splu(E->S,&(E->N));
+    //the pivot order was just chosen for these values, so analyzing
+    //again would not help
+    if(mcs_splu_factor(E->N,E->G->dat)){
+        mcs_eco_unfactor(E);
+        return 1;
+    }
+    E->dim = M->dim;
+    E->b = (double*) realloc(E->b,sizeof(double)*(M->dim+1));
+    E->y = (double*) realloc(E->y,sizeof(double)*(M->dim+1));
+    free(E->Z);
+    E->Z = NULL;
+    E->rank = 0;
+    E->rebuild = 0;
+    E->K_dirty = 0;
+    E->num_factor++;
+    return 0;
+}
+
+void mcs_eco_column(mcs_eco* E, long a, long b, double dg){
+    long i, j;
+    double* z;
+    if(a > b){
+        j = a;
+        a = b;
+        b = j;
+    }
+    if(!E->linear || E->rebuild || a == b){
+        return;
+    }
+    for(j=0;j<E->rank;j++){
+        if(E->pair[2*j] == a && E->pair[2*j+1] == b){
+            E->d[j] += dg;
+            E->K_dirty = 1;
+            return;
+        }
+    }
+    if(E->rank == MCS_ECO_MAX_RANK){
+        E->rebuild = 1;
+        return;
+    }
+    j = E->rank;
+    E->Z = (double*) realloc(E->Z,sizeof(double)*((j+1)*E->dim));
+    z = &(E->Z[j*E->dim]);
+    for(i=0;i<E->dim;i++){
+        E->b[i] = 0.0;
+    }
+    if(a >= 0){
+        E->b[a] = 1.0;
+    }
+    E->b[b] = -1.0;
+    mcs_splu_solve(E->N,E->b,z);
+    E->pair[2*j] = a;
+    E->pair[2*j+1] = b;
+    E->d[j] = dg;
+    E->rank++;
+    E->K_dirty = 1;
+}
+
+void mcs_eco_stamp(mcs_eco* E, long k, double s){
+    mcs_mna* M = E->ctx->M;
+    switch(M->dev[k]->elem.symbol){
+        case 'R':
+            mcs_eco_column(E,M->term[3*k],M->term[3*k+1],s/M->val[k]);
+            break;
+        case 'V':
+        case 'L':
+            //adds or removes an unknown
+            E->rebuild = 1;
+            break;
+        default:
+            break;
+    }
+}
+
+void mcs_eco_restructure(mcs_eco* E){
+    mcs_ctx* ctx = E->ctx;
+    if(ctx->N != NULL){
+        mcs_free_splu(&(ctx->N));
+        mcs_free_splu_symbolic(&(ctx->S));
+        ctx->N = NULL;
+        ctx->S = NULL;
+    }
+    if(ctx->G != NULL){
+        mcs_free_spmat(&(ctx->G));
+        ctx->G = NULL;
+    }
+    if(ctx->gen != NULL){
+        mcs_free_codegen(&(ctx->gen));
+    }
+}
+
+void mcs_eco_resize(mcs_eco* E, long br){
+    mcs_ctx* ctx = E->ctx;
+    long i, dim = ctx->M->dim;
+    if(br >= 0){
+        for(i=br;i<dim;i++){
+            ctx->x[i] = ctx->x[i+1];
+        }
+    }else{
+        ctx->x = (double*) realloc(ctx->x,sizeof(double)*(dim+1));
+        ctx->x[dim-1] = 0.0;
+    }
+    ctx->work = (double*) realloc(ctx->work,sizeof(double)*(4*dim+1));
+}
+
+int mcs_eco_factor_K(mcs_eco* E){
+    long r = E->rank;
+    long i, j, k, p;
+    double t, amax;
+    double* K = E->K;
+    double* z;
+    for(j=0;j<r;j++){
+        z = &(E->Z[j*E->dim]);
+        for(i=0;i<r;i++){
+            K[i*r+j] = E->d[i]*(mcs_eco_at(z,E->pair[2*i])
+                                - mcs_eco_at(z,E->pair[2*i+1]));
+        }
+        K[j*r+j] += 1.0;
+    }
+    for(k=0;k<r;k++){
+        p = k;
+        amax = fabs(K[k*r+k]);
+        for(i=k+1;i<r;i++){
+            if(fabs(K[i*r+k]) > amax){
+                amax = fabs(K[i*r+k]);
+                p = i;
+            }
+        }
+        if(!(amax >= MCS_ECO_PIV_MIN)){
+            return 1;
+        }
+        E->piv[k] = p;
+        if(p != k){
+            for(j=0;j<r;j++){
+                t = K[k*r+j];
+                K[k*r+j] = K[p*r+j];
+                K[p*r+j] = t;
+            }
+        }
+        for(i=k+1;i<r;i++){
+            K[i*r+k] /= K[k*r+k];
+            for(j=k+1;j<r;j++){
+                K[i*r+j] -= K[i*r+k]*K[k*r+j];
+            }
+        }
+    }
+    E->K_dirty = 0;
+    return 0;
+}
+
+void mcs_eco_solve_K(mcs_eco* E, double* c){
+    long r = E->rank;
+    long i, j;
+    double t;
+    double* K = E->K;
+    for(i=0;i<r;i++){
+        t = c[i];
+        c[i] = c[E->piv[i]];
+        c[E->piv[i]] = t;
+        for(j=0;j<i;j++){
+            c[i] -= K[i*r+j]*c[j];
+        }
+    }
+    for(i=r-1;i>=0;i--){
+        for(j=i+1;j<r;j++){
+            c[i] -= K[i*r+j]*c[j];
+        }
+        c[i] /= K[i*r+i];
+    }
+}
+
+int mcs_alloc_eco(mcs_ctx* ctx, mcs_eco** E){
+    mcs_eco* R;
+    mcs_netlist* this_line;
+    long k;
+    if(ctx->M == NULL){
+        return mcs_raise(&(ctx->st),DEFAULT_ERR);
+    }
+    //edits are made to single netlist lines, so instances are not allowed
+    for(this_line = ctx->nl; this_line != NULL; this_line = this_line->next){
+        if(this_line->dev->elem.symbol == 'X'){
+            return mcs_raise(&(ctx->st),MCS_ECO_EDIT);
+        }
+    }
+    R = (mcs_eco*) malloc(sizeof(mcs_eco));
+    R->ctx = ctx;
+    R->line = (mcs_netlist**)
+              malloc(sizeof(mcs_netlist*)*(ctx->M->num_dev+1));
+    R->tail = NULL;
+    k = 0;
+    for(this_line = ctx->nl; this_line != NULL; this_line = this_line->next){
+        R->line[k++] = this_line;
+        R->tail = this_line;
+    }
+    R->linear = mcs_mna_is_linear(ctx->M);
+    R->rebuild = 1;
+    R->G = NULL;
+    R->S = NULL;
+    R->N = NULL;
+    R->dim = 0;
+    R->rank = 0;
+    R->pair = (long*) malloc(sizeof(long)*2*MCS_ECO_MAX_RANK);
+    R->d = (double*) malloc(sizeof(double)*MCS_ECO_MAX_RANK);
+    R->Z = NULL;
+    R->K = (double*) malloc(sizeof(double)*MCS_ECO_MAX_RANK*MCS_ECO_MAX_RANK);
+    R->piv = (long*) malloc(sizeof(long)*MCS_ECO_MAX_RANK);
+    R->K_dirty = 0;
+    R->b = NULL;
+    R->y = NULL;
+    R->c = (double*) malloc(sizeof(double)*MCS_ECO_MAX_RANK);
+    R->tol = MCS_DC_TOL;
+    R->max_iter = MCS_DC_MAX_ITER;
+    R->num_edit = 0;
+    R->num_factor = 0;
+    if(R->linear && mcs_eco_refactor(R)){
+        mcs_free_eco(&R);
+        return mcs_raise(&(ctx->st),MCS_SINGULAR_MATRIX);
+    }
+    *E = R;
+    return 0;
+}
+
+void mcs_free_eco(mcs_eco** E){
+    mcs_eco_unfactor(*E);
+    free((*E)->c);
+    free((*E)->y);
+    free((*E)->b);
+    free((*E)->piv);
+    free((*E)->K);
+    free((*E)->Z);
+    free((*E)->d);
+    free((*E)->pair);
+    free((*E)->line);
+    free(*E);
+    *E = NULL;
+}
+
+int mcs_eco_set(mcs_eco* E, char symbol, unsigned long idx, double val){
+    mcs_mna* M = E->ctx->M;
+    long k = -1;
+    if(symbol == 'V' || symbol == 'I' || symbol == 'R'
+       || symbol == 'C' || symbol == 'L'){
+        k = mcs_mna_find(M,symbol,idx);
+    }
+    if(k < 0){
+        return mcs_raise(&(E->ctx->st),MCS_ECO_EDIT);
+    }
+    if(symbol == 'R'){
+        mcs_eco_stamp(E,k,-1.0);
+    }
+    M->val[k] = val;
+    M->dev[k]->L.henry = val;
+    if(symbol == 'R'){
+        mcs_eco_stamp(E,k,1.0);
+    }
+    E->num_edit++;
+    return 0;
+}
+
+int mcs_eco_add(mcs_eco* E, const mcs_element* e){
+    mcs_ctx* ctx = E->ctx;
+    mcs_mna* M = ctx->M;
+    mcs_netlist* line;
+    char sym = e->elem.symbol;
+    unsigned long idx;
+    long dim = M->dim;
+    if(!mcs_eco_known(sym)){
+        return mcs_raise(&(ctx->st),MCS_ECO_EDIT);
+    }
+    //BJTs and MOSFETs store the doping pattern before idx
+    idx = (sym == 'Q' || sym == 'M') ? e->QN.idx : e->V.idx;
+    if(mcs_mna_find(M,sym,idx) >= 0){
+        return mcs_raise(&(ctx->st),MCS_ECO_EDIT);
+    }
+    mcs_alloc_netlist(&line);
+    *(line->dev) = *e;
+    mcs_eco_restructure(E);
+    if(mcs_mna_add_element(M,line->dev)){
+        free(line->dev);
+        free(line);
+        return mcs_raise(&(ctx->st),MCS_ECO_EDIT);
+    }
+    if(E->tail == NULL){
+        ctx->nl = line;
+    }else{
+        E->tail->next = line;
+        line->prev = E->tail;
+    }
+    E->tail = line;
+    E->line = (mcs_netlist**)
+              realloc(E->line,sizeof(mcs_netlist*)*(M->num_dev+1));
+    E->line[M->num_dev-1] = line;
+    if(M->dim != dim){
+        mcs_eco_resize(E,-1);
+    }
+    if(sym == 'D' || sym == 'Q' || sym == 'M'){
+        E->linear = 0;
+    }
+    mcs_eco_stamp(E,M->num_dev-1,1.0);
+    E->num_edit++;
+    return 0;
+}
+
+int mcs_eco_remove(mcs_eco* E, char symbol, unsigned long idx){
+    mcs_ctx* ctx = E->ctx;
+    mcs_mna* M = ctx->M;
+    mcs_netlist* line;
+    long j, br;
+    long k = mcs_mna_find(M,symbol,idx);
+    if(k < 0){
+        return mcs_raise(&(ctx->st),MCS_ECO_EDIT);
+    }
+    mcs_eco_stamp(E,k,-1.0);
+    mcs_eco_restructure(E);
+    br = M->branch[k];
+    line = E->line[k];
+    if(line->prev == NULL){
+        ctx->nl = line->next;
+    }else{
+        line->prev->next = line->next;
+    }
+    if(line->next == NULL){
+        E->tail = line->prev;
+    }else{
+        line->next->prev = line->prev;
+    }
+    for(j=k;j<M->num_dev-1;j++){
+        E->line[j] = E->line[j+1];
+    }
+    mcs_mna_remove_element(M,k);
+    free(line->dev);
+    free(line);
+    if(br >= 0){
+        mcs_eco_resize(E,br);
+    }
+    E->num_edit++;
+    return 0;
+}
+
+int mcs_eco_solve(mcs_eco* E){
+    mcs_ctx* ctx = E->ctx;
+    long i, j;
+    double* z;
+    if(!E->linear){
+        return mcs_ctx_dc_op(ctx,E->tol,E->max_iter);
+    }
+    if(!E->rebuild && E->rank > 0 && E->K_dirty && mcs_eco_factor_K(E)){
+        //the update is close to singular, so factor the edited G instead
+        E->rebuild = 1;
+    }
+    if(E->rebuild && mcs_eco_refactor(E)){
+        return mcs_raise(&(ctx->st),MCS_SINGULAR_MATRIX);
+    }
+    mcs_mna_stamp_G(ctx->M,NULL,NULL,E->b);
+    mcs_splu_solve(E->N,E->b,E->y);
+    for(j=0;j<E->rank;j++){
+        E->c[j] = E->d[j]*(mcs_eco_at(E->y,E->pair[2*j])
+                           - mcs_eco_at(E->y,E->pair[2*j+1]));
+    }
+    mcs_eco_solve_K(E,E->c);
+    mcs_vector_copy(E->y,ctx->x,i,E->dim);
+    for(j=0;j<E->rank;j++){
+        z = &(E->Z[j*E->dim]);
+        mcs_vector_add(ctx->x,z,-E->c[j],ctx->x,i,E->dim);
+    }
+    for(i=0;i<E->dim;i++){
+        if(!isfinite(ctx->x[i])){
+            if(E->rank == 0){
+                return mcs_raise(&(ctx->st),MCS_SINGULAR_MATRIX);
+            }
+            E->rebuild = 1;
+            return mcs_eco_solve(E);
+        }
+    }
+    return 0;
+}
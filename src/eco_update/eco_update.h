@@ -0,0 +1,147 @@
+#ifndef MCS_ECO_UPDATE_H
+#define MCS_ECO_UPDATE_H
+
+/*
+ * Incremental edits of a loaded circuit by Bram Rodgers.
+ * Based on the Sherman-Morrison-Woodbury formula, as in
+ * Chapter 2.1.4 of ``Matrix Computations'' by Golub and Van Loan.
+ *
+ * An edit session changes the circuit held by a simulation context in
+ * place: element values are set, and elements are added or removed, in
+ * both the netlist and the MNA description. Nothing is parsed again.
+ *
+ * In a linear circuit, a resistor edit between unknowns a and b changes
+ * the DC matrix by d*v*v^T, where v = e_a - e_b and d is the change in
+ * conductance. After r such edits
+ *      G = G0 + V*D*V^T,
+ * where G0 was factored when the session began. The edited circuit is
+ * then solved by
+ *      x = y - Z*(I + D*V^T*Z)^(-1)*D*V^T*y,
+ * with y = G0^(-1)*b and Z = G0^(-1)*V. Each column of Z costs one pair of
+ * triangular solves when it is added, and each solve costs one more pair
+ * plus a dense solve of order r. Edits of one node pair share a column.
+ * Source values only change b, and capacitors and inductors do not appear
+ * in the DC matrix, so edits of those cost no columns at all.
+ *
+ * G0 is factored again, and the columns dropped, once there are
+ * MCS_ECO_MAX_RANK columns, when the update becomes ill conditioned, or
+ * when a voltage source or inductor is added or removed, which changes
+ * the number of unknowns.
+ *
+ * Circuits with semiconductor devices are solved by Newton's method from
+ * the last solution, reusing the pivot order of the context until an edit
+ * changes the pattern of G.
+ *
+ * Finding an element by name is a scan of the circuit, and adding or
+ * removing one moves the arrays of the MNA description, so the edits
+ * themselves take time linear in the size of the circuit, but no
+ * factorization.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../error_handling/error_handling.h"
+#include"../netlist_parser/netlist_parser.h"
+#include"../mna_system/mna_system.h"
+#include"../sparse_lu/sparse_lu.h"
+#include"../dc_analysis/dc_analysis.h"
+#include"../sim_context/sim_context.h"
+
+/*
+ * Largest number of columns of the update before G0 is factored again.
+ */
+#define MCS_ECO_MAX_RANK    32
+
+/*
+ * Smallest pivot of I + D*V^T*Z before G0 is factored again instead.
+ * Smaller pivots lose too many digits of the solution, as happens when
+ * removing a resistor leaves part of the circuit held only by gmin.
+ */
+#define MCS_ECO_PIV_MIN     1.0e-6
+
+/*
+ * Object and Struct Definitions:
+ */
+
+typedef struct _mcs_eco{
+    mcs_ctx* ctx;               /*The context whose circuit is edited*/
+    mcs_netlist** line;         /*Netlist line of each element of ctx->M*/
+    mcs_netlist* tail;          /*Last line of the netlist*/
+    int linear;                 /*1 if edits are low rank updates of G0*/
+    int rebuild;                /*1 if G0 must be factored again*/
+    mcs_spmat* G;               /*The DC matrix G0*/
+    mcs_splu_symbolic* S;       /*Symbolic analysis of G0*/
+    mcs_splu_numeric* N;        /*Numeric factors of G0*/
+    long dim;                   /*Number of unknowns of G0*/
+    long rank;                  /*Number of columns of the update*/
+    long* pair;                 /*Unknowns a < b of each column*/
+    double* d;                  /*Conductance change of each column*/
+    double* Z;                  /*G0^(-1)*(e_a - e_b) of each column*/
+    double* K;                  /*LU factors of I + D*V^T*Z, by rows*/
+    long* piv;                  /*Row swaps of the factors of K*/
+    int K_dirty;                /*1 if K must be factored again*/
+    double* b;                  /*Right hand side, dim entries*/
+    double* y;                  /*G0^(-1)*b*/
+    double* c;                  /*Coefficients of the columns of Z*/
+    double tol;                 /*Newton tolerance, as in mcs_dc_op*/
+    long max_iter;              /*Newton iteration limit*/
+    long num_edit;              /*Edits applied*/
+    long num_factor;            /*Factorizations of G0*/
+} mcs_eco;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Begin an edit session of the circuit loaded in ctx. Linear circuits
+ * have G0 factored here. Returns 0, or 1 after recording DEFAULT_ERR in
+ * ctx->st if no circuit is loaded, MCS_ECO_EDIT if the netlist has
+ * subcircuit instances, whose elements are shared, or MCS_SINGULAR_MATRIX,
+ * with nothing allocated.
+ */
+int mcs_alloc_eco(mcs_ctx* ctx, mcs_eco** E);
+
+/*
+ * End an edit session. The edited circuit stays in the context.
+ */
+void mcs_free_eco(mcs_eco** E);
+
+/*
+ * Set the volt, amp, ohm, farad, or henry of the V, I, R, C, or L element
+ * with numeric identifier idx. Returns 0, or 1 after recording
+ * MCS_ECO_EDIT if there is no such element.
+ */
+int mcs_eco_set(mcs_eco* E, char symbol, unsigned long idx, double val);
+
+/*
+ * Add a copy of element e to the end of the circuit. Returns 0, or 1
+ * after recording MCS_ECO_EDIT if an element of the same name exists or
+ * e is connected to a node which is not in the circuit.
+ */
+int mcs_eco_add(mcs_eco* E, const mcs_element* e);
+
+/*
+ * Remove the element with the given symbol and numeric identifier.
+ * Returns 0, or 1 after recording MCS_ECO_EDIT if there is no such
+ * element.
+ */
+int mcs_eco_remove(mcs_eco* E, char symbol, unsigned long idx);
+
+/*
+ * Solve for the DC operating point of the edited circuit, leaving it in
+ * ctx->x. Returns 0, or 1 after recording MCS_SINGULAR_MATRIX or
+ * MCS_NO_CONVERGE in ctx->st.
+ */
+int mcs_eco_solve(mcs_eco* E);
+
+#endif
@@ -21,25 +21,58 @@
 
 
 void mcs_error(enum MCS_ERROR_TYPE e){
+    printf("%s",mcs_error_str(e));
+    exit(1);
+}
+
+const char* mcs_error_str(enum MCS_ERROR_TYPE e){
     switch(e){
         case FILE_READ_ONLY:
-            printf(MCS_FILE_READ_ONLY_STR);
-            break;
+            return MCS_FILE_READ_ONLY_STR;
         case MCS_NETLIST_FMT:
-            printf(MCS_NETLIST_FMT_STR);
-            break;
+            return MCS_NETLIST_FMT_STR;
         case MCS_DEV_READ_UNKNOWN:
-            printf(MCS_DEV_READ_UNKNOWN_STR);
-            break;
+            return MCS_DEV_READ_UNKNOWN_STR;
         case MCS_NUM_PARSER:
-            printf(MCS_NUM_PARSER_STR);
-            break;
+            return MCS_NUM_PARSER_STR;
         case MCS_DEV_WRITE_UNKNOWN:
-            printf(MCS_DEV_WRITE_UNKNOWN_STR);
-            break;
+            return MCS_DEV_WRITE_UNKNOWN_STR;
+        case MCS_SINGULAR_MATRIX:
+            return MCS_SINGULAR_MATRIX_STR;
+        case MCS_FILE_WRITE:
+            return MCS_FILE_WRITE_STR;
+        case MCS_NO_CONVERGE:
+            return MCS_NO_CONVERGE_STR;
+        case MCS_MATRIX_FMT:
+            return MCS_MATRIX_FMT_STR;
+        case MCS_CODEGEN:
+            return MCS_CODEGEN_STR;
+        case MCS_CKPT_FMT:
+            return MCS_CKPT_FMT_STR;
+        case MCS_ECO_EDIT:
+            return MCS_ECO_EDIT_STR;
+        case MCS_WAVE_FMT:
+            return MCS_WAVE_FMT_STR;
+        case MCS_BAD_ARG:
+            return MCS_BAD_ARG_STR;
         default:
-            printf(MCS_DEFAULT_ERR_STR);
+            return MCS_DEFAULT_ERR_STR;
     }
-    exit(1);
 }
- 
+
+void mcs_status_init(mcs_status* st){
+    st->failed = 0;
+    st->err = DEFAULT_ERR;
+    st->line = 0;
+}
+
+int mcs_raise(mcs_status* st, enum MCS_ERROR_TYPE e){
+    if(st == NULL){
+        mcs_error(e);
+    }
+    if(!st->failed){
+        st->failed = 1;
+        st->err = e;
+    }
+    return 1;
+}
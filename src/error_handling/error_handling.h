@@ -22,6 +22,15 @@
 #define MCS_DEV_READ_UNKNOWN_STR "\nError: read unknown netlist device.\n"
 #define MCS_NUM_PARSER_STR "\nError: error in parsing netlist parameters.\n"
 #define MCS_DEV_WRITE_UNKNOWN_STR "\nError: wrote unknown netlist device.\n"
+#define MCS_SINGULAR_MATRIX_STR "\nError: circuit matrix is singular.\n"
+#define MCS_FILE_WRITE_STR "\nError: Could not open file for writing.\n"
+#define MCS_NO_CONVERGE_STR "\nError: nonlinear solve did not converge.\n"
+#define MCS_MATRIX_FMT_STR "\nError: matrix file formatted incorrectly.\n"
+#define MCS_CODEGEN_STR "\nError: could not build generated code.\n"
+#define MCS_CKPT_FMT_STR "\nError: checkpoint file formatted incorrectly.\n"
+#define MCS_ECO_EDIT_STR "\nError: could not apply circuit edit.\n"
+#define MCS_WAVE_FMT_STR "\nError: waveform file formatted incorrectly.\n"
+#define MCS_BAD_ARG_STR "\nError: invalid analysis parameters.\n"
 /*
  * Object and Struct Definitions:
  */
@@ -32,13 +41,52 @@ enum MCS_ERROR_TYPE{
     MCS_NETLIST_FMT         =  1,
     MCS_DEV_READ_UNKNOWN    =  2,
     MCS_NUM_PARSER          =  3,
-    MCS_DEV_WRITE_UNKNOWN   =  4
+    MCS_DEV_WRITE_UNKNOWN   =  4,
+    MCS_SINGULAR_MATRIX     =  5,
+    MCS_FILE_WRITE          =  6,
+    MCS_NO_CONVERGE         =  7,
+    MCS_MATRIX_FMT          =  8,
+    MCS_CODEGEN             =  9,
+    MCS_CKPT_FMT            = 10,
+    MCS_ECO_EDIT            = 11,
+    MCS_WAVE_FMT            = 12,
+    MCS_BAD_ARG             = 13
 };
 
+/*
+ * Error status of one simulation. Functions given a status record their
+ * error in it and return instead of exiting, so simulations running on
+ * different threads report errors independently.
+ */
+typedef struct _mcs_status{
+    int failed;                 /*1 once an error has been recorded*/
+    enum MCS_ERROR_TYPE err;    /*The first error recorded*/
+    long line;                  /*Netlist line of a parser error, or 0*/
+} mcs_status;
+
 /*
  * Function Declarations:
  */
 
+/*
+ * Print the message of e to stdout and exit the process.
+ */
 void mcs_error(enum MCS_ERROR_TYPE e);
 
+/*
+ * Return the message of e. The string is static and must not be freed.
+ */
+const char* mcs_error_str(enum MCS_ERROR_TYPE e);
+
+/*
+ * Clear the status st.
+ */
+void mcs_status_init(mcs_status* st);
+
+/*
+ * Record the error e in st, keeping an earlier error if there is one,
+ * and return 1. If st is NULL then calls mcs_error(e) instead.
+ */
+int mcs_raise(mcs_status* st, enum MCS_ERROR_TYPE e);
+
 #endif
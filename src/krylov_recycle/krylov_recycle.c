@@ -0,0 +1,303 @@
+/*
+ * Implementation for:
+ * Krylov subspace recycling for sequences of linear solves
+ * by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "krylov_recycle.h"
+#include "../sparse_matrix/vector_math.h"
+#include<string.h>
+
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Linear map of mcs_gcro_solve for the sparse matrix A.
+ */
+void mcs_gcro_apply_spmat(void* A, double* x, double* y);
+
+/*
+ * Recompute C = A*U for a new operator and orthonormalize C, applying
+ * the same steps to U. Pairs which become dependent are dropped.
+ * Returns the number of products with L.
+ */
+long mcs_gcro_refresh(mcs_gcro* S,
+                      void (*L)(void*,double*,double*),
+                      void* data);
+
+/*
+ * Add the pair (u, c), where c = A*u, to the session. The pair is
+ * orthogonalized against C first, and is not added if nothing is left.
+ * u and c are overwritten.
+ */
+void mcs_gcro_add(mcs_gcro* S, double* u, double* c);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+void mcs_alloc_gcro(mcs_gcro** S, long N, long m, long k_max){
+    mcs_gcro* G = (mcs_gcro*) malloc(sizeof(mcs_gcro));
+    G->N = N;
+    G->m = m;
+    G->k_max = k_max;
+    G->k = 0;
+    G->stale = 0;
+    G->num_matvec = 0;
+    G->U = (double*) malloc(sizeof(double)*(k_max*N+1));
+    G->C = (double*) malloc(sizeof(double)*(k_max*N+1));
+    G->V = (double*) malloc(sizeof(double)*((m+1)*N+1));
+    G->H = (double*) malloc(sizeof(double)*((m+1)*m+1));
+    G->B = (double*) malloc(sizeof(double)*(k_max*m+1));
+    G->g = (double*) malloc(sizeof(double)*(m+2));
+    G->cs = (double*) malloc(sizeof(double)*(m+1));
+    G->sn = (double*) malloc(sizeof(double)*(m+1));
+    G->y = (double*) malloc(sizeof(double)*(m+1));
+    G->r = (double*) malloc(sizeof(double)*(N+1));
+    G->x_p = (double*) malloc(sizeof(double)*(N+1));
+    G->r_p = (double*) malloc(sizeof(double)*(N+1));
+    *S = G;
+}
+
+void mcs_free_gcro(mcs_gcro** S){
+    free((*S)->U);
+    free((*S)->C);
+    free((*S)->V);
+    free((*S)->H);
+    free((*S)->B);
+    free((*S)->g);
+    free((*S)->cs);
+    free((*S)->sn);
+    free((*S)->y);
+    free((*S)->r);
+    free((*S)->x_p);
+    free((*S)->r_p);
+    free(*S);
+    *S = NULL;
+}
+
+void mcs_gcro_changed(mcs_gcro* S){
+    S->stale = 1;
+}
+
+void mcs_gcro_clear(mcs_gcro* S){
+    S->k = 0;
+    S->stale = 0;
+}
+
+void mcs_gcro_apply_spmat(void* A, double* x, double* y){
+    mcs_spmatvec('n',(mcs_spmat*) A,x,y);
+}
+
+long mcs_gcro_refresh(mcs_gcro* S,
+                      void (*L)(void*,double*,double*),
+                      void* data){
+    long N = S->N, i, j, l, kept = 0;
+    double *u, *c, a, nc;
+    for(j=0;j<S->k;j++){
+        u = &(S->U[kept*N]);
+        c = &(S->C[kept*N]);
+        if(kept < j){
+            memcpy(u,&(S->U[j*N]),sizeof(double)*N);
+        }
+        L(data,u,c);
+        for(l=0;l<kept;l++){
+            mcs_vector_dot(&(S->C[l*N]),c,a,i,N);
+            mcs_vector_add(c,&(S->C[l*N]),-a,c,i,N);
+            mcs_vector_add(u,&(S->U[l*N]),-a,u,i,N);
+        }
+        mcs_vector_dot(c,c,nc,i,N);
+        nc = sqrt(nc);
+        if(nc > 0.0){
+            for(i=0;i<N;i++){
+                c[i] /= nc;
+                u[i] /= nc;
+            }
+            kept++;
+        }
+    }
+    j = S->k;
+    S->k = kept;
+    return j;
+}
+
+void mcs_gcro_add(mcs_gcro* S, double* u, double* c){
+    long N = S->N, i, l;
+    double a, nc, nc0;
+    if(S->k_max == 0){
+        return;
+    }
+    mcs_vector_dot(c,c,nc0,i,N);
+    for(l=0;l<S->k;l++){
+        mcs_vector_dot(&(S->C[l*N]),c,a,i,N);
+        mcs_vector_add(c,&(S->C[l*N]),-a,c,i,N);
+        mcs_vector_add(u,&(S->U[l*N]),-a,u,i,N);
+    }
+    mcs_vector_dot(c,c,nc,i,N);
+    //a correction already in the span of C adds nothing new
+    if(nc <= 1.0e-20*nc0 || nc == 0.0){
+        return;
+    }
+    nc = sqrt(nc);
+    if(S->k == S->k_max){
+        memmove(S->U,&(S->U[N]),sizeof(double)*(S->k_max-1)*N);
+        memmove(S->C,&(S->C[N]),sizeof(double)*(S->k_max-1)*N);
+        S->k--;
+    }
+    for(i=0;i<N;i++){
+        S->U[S->k*N+i] = u[i]/nc;
+        S->C[S->k*N+i] = c[i]/nc;
+    }
+    S->k++;
+}
+
+long mcs_gcro_solve(mcs_gcro* S,
+                    void (*L)(void*,double*,double*),
+                    void* data,
+                    double* b,
+                    double* x,
+                    double tol,
+                    long max_iter){
+    long N = S->N, m = S->m, k_max = S->k_max;
+    long i, j, l, jj, num_mv = 0;
+    double nb, beta, a, h, t, den;
+    double *v, *w;
+    double* H = S->H;
+    int failed = 0;
+    mcs_vector_dot(b,b,nb,i,N);
+    nb = sqrt(nb);
+    if(nb == 0.0){
+        for(i=0;i<N;i++){
+            x[i] = 0.0;
+        }
+        S->num_matvec = 0;
+        return 0;
+    }
+    if(S->stale){
+        num_mv += mcs_gcro_refresh(S,L,data);
+        S->stale = 0;
+    }
+    L(data,x,S->r);
+    num_mv++;
+    mcs_vector_add(b,S->r,-1.0,S->r,i,N);
+    //best correction from the recycled space
+    for(l=0;l<S->k;l++){
+        mcs_vector_dot(&(S->C[l*N]),S->r,a,i,N);
+        mcs_vector_add(x,&(S->U[l*N]),a,x,i,N);
+        mcs_vector_add(S->r,&(S->C[l*N]),-a,S->r,i,N);
+    }
+    mcs_vector_copy(x,S->x_p,i,N);
+    mcs_vector_copy(S->r,S->r_p,i,N);
+    mcs_vector_dot(S->r,S->r,beta,i,N);
+    beta = sqrt(beta);
+    while(beta > tol*nb){
+        if(max_iter > 0 && num_mv >= max_iter){
+            failed = 1;
+            break;
+        }
+        for(i=0;i<N;i++){
+            S->V[i] = S->r[i]/beta;
+        }
+        S->g[0] = beta;
+        jj = 0;
+        for(j=0;j<m;j++){
+            v = &(S->V[j*N]);
+            w = &(S->V[(j+1)*N]);
+            L(data,v,w);
+            num_mv++;
+            //GMRES on (I - C*C^T)*A
+            for(l=0;l<S->k;l++){
+                mcs_vector_dot(&(S->C[l*N]),w,a,i,N);
+                S->B[l+j*k_max] = a;
+                mcs_vector_add(w,&(S->C[l*N]),-a,w,i,N);
+            }
+            for(l=0;l<=j;l++){
+                mcs_vector_dot(&(S->V[l*N]),w,a,i,N);
+                H[l+j*(m+1)] = a;
+                mcs_vector_add(w,&(S->V[l*N]),-a,w,i,N);
+            }
+            mcs_vector_dot(w,w,h,i,N);
+            h = sqrt(h);
+            H[j+1+j*(m+1)] = h;
+            if(h > 0.0){
+                for(i=0;i<N;i++){
+                    w[i] /= h;
+                }
+            }
+            for(l=0;l<j;l++){
+                t = S->cs[l]*H[l+j*(m+1)] + S->sn[l]*H[l+1+j*(m+1)];
+                H[l+1+j*(m+1)] = -S->sn[l]*H[l+j*(m+1)]
+                                 + S->cs[l]*H[l+1+j*(m+1)];
+                H[l+j*(m+1)] = t;
+            }
+            den = sqrt(H[j+j*(m+1)]*H[j+j*(m+1)] + h*h);
+            if(den == 0.0){
+                //the deflated operator is singular on v
+                break;
+            }
+            S->cs[j] = H[j+j*(m+1)]/den;
+            S->sn[j] = h/den;
+            H[j+j*(m+1)] = den;
+            H[j+1+j*(m+1)] = 0.0;
+            S->g[j+1] = -S->sn[j]*S->g[j];
+            S->g[j] = S->cs[j]*S->g[j];
+            jj = j+1;
+            if(fabs(S->g[j+1]) <= tol*nb || h == 0.0
+               || (max_iter > 0 && num_mv >= max_iter)){
+                break;
+            }
+        }
+        if(jj == 0){
+            failed = 1;
+            break;
+        }
+        for(j=jj-1;j>=0;j--){
+            t = S->g[j];
+            for(l=j+1;l<jj;l++){
+                t -= H[j+l*(m+1)]*S->y[l];
+            }
+            S->y[j] = t/H[j+j*(m+1)];
+        }
+        //x += V*y - U*B*y keeps the residual orthogonal to C
+        for(j=0;j<jj;j++){
+            mcs_vector_add(x,&(S->V[j*N]),S->y[j],x,i,N);
+        }
+        for(l=0;l<S->k;l++){
+            a = 0.0;
+            for(j=0;j<jj;j++){
+                a += S->B[l+j*k_max]*S->y[j];
+            }
+            mcs_vector_add(x,&(S->U[l*N]),-a,x,i,N);
+        }
+        L(data,x,S->r);
+        num_mv++;
+        mcs_vector_add(b,S->r,-1.0,S->r,i,N);
+        mcs_vector_dot(S->r,S->r,beta,i,N);
+        beta = sqrt(beta);
+    }
+    //the whole correction of this solve, and its image under A
+    mcs_vector_add(x,S->x_p,-1.0,S->x_p,i,N);
+    mcs_vector_add(S->r_p,S->r,-1.0,S->r_p,i,N);
+    mcs_gcro_add(S,S->x_p,S->r_p);
+    S->num_matvec = num_mv;
+    MCS_PROF_COUNT(MCS_PROF_ITERS,num_mv);
+    return failed ? -1 : num_mv;
+}
+
+long mcs_spmat_gcro(mcs_gcro* S,
+                    mcs_spmat* A,
+                    double* b,
+                    double* x,
+                    double tol,
+                    long max_iter){
+    return mcs_gcro_solve(S,&mcs_gcro_apply_spmat,A,b,x,tol,max_iter);
+}
@@ -0,0 +1,133 @@
+#ifndef MCS_KRYLOV_RECYCLE_H
+#define MCS_KRYLOV_RECYCLE_H
+
+/*
+ * Krylov subspace recycling for sequences of linear solves
+ * by Bram Rodgers.
+ *
+ * Newton iterations and time steps solve many systems A*x = b where A
+ * and b change slowly from one solve to the next. A recycling session
+ * keeps a small subspace from earlier solves to speed up later ones.
+ *
+ * The solver is GCRO with restarted GMRES as its inner iteration,
+ * after de Sturler. The session holds up to k_max vector pairs (U, C)
+ * with A*U = C and C orthonormal. Unlike GCRO-DR, which recycles
+ * harmonic Ritz vectors, U is spanned by the corrections of recent
+ * solves, so no dense eigenvalue problem is solved.
+ * Every solve:
+ * ->projects the initial residual onto C, which is the best correction
+ *   to x from the span of U,
+ * ->runs GMRES on the deflated operator (I - C*C^T)*A, so no Krylov
+ *   vector is spent on directions the session already holds,
+ * ->adds its own total correction to x as a new pair, dropping the
+ *   oldest pair when the session is full.
+ * For a sequence of time steps or Newton steps the corrections of
+ * earlier solves are close to those of later ones, so later solves need
+ * far fewer matrix vector products.
+ *
+ * If the operator changes between solves, mcs_gcro_changed recomputes
+ * C = A*U at the start of the next solve, which costs one product per
+ * recycled vector.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../profiling/profiling.h"
+
+/*
+ * Default GMRES steps per restart and number of recycled vectors.
+ */
+#define MCS_GCRO_M      30
+#define MCS_GCRO_K      10
+
+/*
+ * Object and Struct Definitions:
+ */
+
+typedef struct _mcs_gcro{
+    long N;         /*Length of the vectors*/
+    long m;         /*GMRES steps per restart*/
+    long k_max;     /*Largest number of recycled vector pairs*/
+    long k;         /*Number of recycled vector pairs held*/
+    double* U;      /*Recycled directions, k_max vectors of length N*/
+    double* C;      /*A*U, orthonormal*/
+    int stale;      /*1 if A changed since C was computed*/
+    double* V;      /*m+1 Arnoldi vectors*/
+    double* H;      /*Hessenberg matrix, (m+1) by m, column major*/
+    double* B;      /*C^T*A*V, k_max by m, column major*/
+    double* g;      /*Rotated right hand side of the least squares problem*/
+    double* cs;     /*Givens rotation cosines*/
+    double* sn;     /*Givens rotation sines*/
+    double* y;      /*Least squares solution*/
+    double* r;      /*Residual*/
+    double* x_p;    /*x after projection onto U*/
+    double* r_p;    /*Residual after projection onto C*/
+    long num_matvec;/*Matrix vector products of the last solve*/
+} mcs_gcro;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Allocate a recycling session for systems with N unknowns, running
+ * GMRES(m) and keeping up to k_max vector pairs. Calls about
+ * (m + 2*k_max + 4)*N doubles of mallocs.
+ */
+void mcs_alloc_gcro(mcs_gcro** S, long N, long m, long k_max);
+
+/*
+ * Free a recycling session.
+ */
+void mcs_free_gcro(mcs_gcro** S);
+
+/*
+ * Mark that the operator has changed since the last solve, so the
+ * recycled vectors are multiplied by the new operator before reuse.
+ */
+void mcs_gcro_changed(mcs_gcro* S);
+
+/*
+ * Forget every recycled vector.
+ */
+void mcs_gcro_clear(mcs_gcro* S);
+
+/*
+ * Solve L(x) = b where L is the linear map computed by L(data,v,w), as in
+ * mcs_bicgstab_r. x holds the initial guess on entry. Iteration stops once
+ * the residual norm is at most tol times the norm of b.
+ *
+ * If max_iter > 0 then at most about max_iter products with L are taken.
+ *
+ * Returns the number of products with L, or -1 if max_iter was reached.
+ * The session is updated either way.
+ */
+long mcs_gcro_solve(mcs_gcro* S,
+                    void (*L)(void*,double*,double*),
+                    void* data,
+                    double* b,
+                    double* x,
+                    double tol,
+                    long max_iter);
+
+/*
+ * mcs_gcro_solve with the sparse matrix A as the linear map.
+ */
+long mcs_spmat_gcro(mcs_gcro* S,
+                    mcs_spmat* A,
+                    double* b,
+                    double* x,
+                    double tol,
+                    long max_iter);
+
+#endif
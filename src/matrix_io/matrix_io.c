@@ -0,0 +1,355 @@
+/*
+ * Implementation for:
+ * Saving and loading of sparse linear systems by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "matrix_io.h"
+#include<string.h>
+#include<ctype.h>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Read the banner of a Matrix Market file and skip its comments. The
+ * banner words are written to fmt, field, and sym, in lower case, and
+ * line is left holding the size line. Returns 1 on a format error.
+ */
+int mcs_mm_header(FILE* f, char* line, char* fmt, char* field, char* sym);
+
+/*
+ * Read the next line of f which is not blank into line.
+ * Returns 1 at the end of the file.
+ */
+int mcs_mm_next(FILE* f, char* line);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Number of systems captured by this process.
+ */
+static long mcs_capture_count = 0;
+
+/*
+ * Function Implementations:
+ */
+
+int mcs_mm_next(FILE* f, char* line){
+    char* p;
+    while(fgets(line,MCS_MM_LINE_LEN,f) != NULL){
+        for(p=line;isspace((unsigned char) *p);p++);
+        if(*p != '\0'){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int mcs_mm_header(FILE* f, char* line, char* fmt, char* field, char* sym){
+    char banner[16], obj[16];
+    char* p;
+    if(fgets(line,MCS_MM_LINE_LEN,f) == NULL){
+        return 1;
+    }
+    for(p=line;*p!='\0';p++){
+        *p = (char) tolower((unsigned char) *p);
+    }
+    if(sscanf(line,"%15s %15s %15s %15s %15s",
+                   banner,obj,fmt,field,sym) != 5){
+        return 1;
+    }
+    if(strcmp(banner,"%%matrixmarket") != 0 || strcmp(obj,"matrix") != 0){
+        return 1;
+    }
+    do{
+        if(mcs_mm_next(f,line)){
+            return 1;
+        }
+    }while(line[0] == '%');
+    return 0;
+}
+
+int mcs_spmat_write_mm(const char* filename, mcs_spmat* A, mcs_status* st){
+    FILE* f = fopen(filename,"w");
+    long k;
+    if(f == NULL){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    fprintf(f,"%%%%MatrixMarket matrix coordinate real general\n");
+    fprintf(f,"%ld %ld %ld\n",A->r_len,A->c_len,A->nnz);
+    for(k=0;k<A->nnz;k++){
+        fprintf(f,"%ld %ld %.17g\n",A->r[k]+1,A->c[k]+1,A->dat[k]);
+    }
+    fclose(f);
+    return 0;
+}
+
+int mcs_spmat_read_mm(const char* filename, mcs_spmat** A, mcs_status* st){
+    FILE* f;
+    char line[MCS_MM_LINE_LEN];
+    char fmt[16], field[16], sym[16];
+    char* p;
+    char* q;
+    long r_len, c_len, nnz, i, j, k, len;
+    double v, mirror = 0.0;
+    int err = 0;
+    *A = NULL;
+    f = fopen(filename,"r");
+    if(f == NULL){
+        return mcs_raise(st,FILE_READ_ONLY);
+    }
+    if(mcs_mm_header(f,line,fmt,field,sym) || strcmp(fmt,"coordinate") != 0
+       || sscanf(line,"%ld %ld %ld",&r_len,&c_len,&nnz) != 3
+       || r_len < 0 || c_len < 0 || nnz < 0){
+        fclose(f);
+        return mcs_raise(st,MCS_MATRIX_FMT);
+    }
+    if(strcmp(sym,"symmetric") == 0){
+        mirror = 1.0;
+    }else if(strcmp(sym,"skew-symmetric") == 0){
+        mirror = -1.0;
+    }else if(strcmp(sym,"general") != 0){
+        err = 1;
+    }
+    if(strcmp(field,"real") != 0 && strcmp(field,"integer") != 0
+       && strcmp(field,"pattern") != 0){
+        err = 1;
+    }
+    if(err){
+        fclose(f);
+        return mcs_raise(st,MCS_MATRIX_FMT);
+    }
+    //off diagonal entries of symmetric files are stored twice
+    mcs_alloc_spmat(A,(mirror != 0.0 ? 2 : 1)*nnz+1,r_len,c_len);
+    len = 0;
+    for(k=0;k<nnz && !err;k++){
+        if(mcs_mm_next(f,line)){
+            err = 1;
+            break;
+        }
+        i = strtol(line,&p,10) - 1;
+        j = strtol(p,&q,10) - 1;
+        if(q == p || i < 0 || i >= r_len || j < 0 || j >= c_len){
+            err = 1;
+            break;
+        }
+        v = 1.0;
+        if(field[0] != 'p'){
+            v = strtod(q,&p);
+            if(p == q){
+                err = 1;
+                break;
+            }
+        }
+        (*A)->r[len] = i;
+        (*A)->c[len] = j;
+        (*A)->dat[len] = v;
+        len++;
+        if(mirror != 0.0 && i != j){
+            (*A)->r[len] = j;
+            (*A)->c[len] = i;
+            (*A)->dat[len] = mirror*v;
+            len++;
+        }
+    }
+    fclose(f);
+    if(err){
+        mcs_free_spmat(A);
+        *A = NULL;
+        return mcs_raise(st,MCS_MATRIX_FMT);
+    }
+    (*A)->nnz = len;
+    return 0;
+}
+
+int mcs_vec_write_mm(const char* filename, double* x, long n,
+                     mcs_status* st){
+    FILE* f = fopen(filename,"w");
+    long i;
+    if(f == NULL){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    fprintf(f,"%%%%MatrixMarket matrix array real general\n");
+    fprintf(f,"%ld 1\n",n);
+    for(i=0;i<n;i++){
+        fprintf(f,"%.17g\n",x[i]);
+    }
+    fclose(f);
+    return 0;
+}
+
+int mcs_vec_read_mm(const char* filename, double** x, long* n,
+                    mcs_status* st){
+    FILE* f;
+    char line[MCS_MM_LINE_LEN];
+    char fmt[16], field[16], sym[16];
+    char* p;
+    long i, cols;
+    *x = NULL;
+    f = fopen(filename,"r");
+    if(f == NULL){
+        return mcs_raise(st,FILE_READ_ONLY);
+    }
+    if(mcs_mm_header(f,line,fmt,field,sym) || strcmp(fmt,"array") != 0
+       || (strcmp(field,"real") != 0 && strcmp(field,"integer") != 0)
+       || strcmp(sym,"general") != 0
+       || sscanf(line,"%ld %ld",n,&cols) != 2 || *n < 0 || cols != 1){
+        fclose(f);
+        return mcs_raise(st,MCS_MATRIX_FMT);
+    }
+    *x = (double*) malloc(sizeof(double)*(*n+1));
+    for(i=0;i<*n;i++){
+        if(mcs_mm_next(f,line)){
+            break;
+        }
+        (*x)[i] = strtod(line,&p);
+        if(p == line){
+            break;
+        }
+    }
+    fclose(f);
+    if(i < *n){
+        free(*x);
+        *x = NULL;
+        return mcs_raise(st,MCS_MATRIX_FMT);
+    }
+    return 0;
+}
+
+int mcs_sys_write_bin(const char* filename, mcs_spmat* A, double* b,
+                      mcs_status* st){
+    FILE* f = fopen(filename,"wb");
+    mcs_sys_head head;
+    size_t nnz = (size_t) A->nnz;
+    int err = 0;
+    if(f == NULL){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    memset(&head,0,sizeof(mcs_sys_head));
+    memcpy(head.magic,MCS_SYS_MAGIC,8);
+    head.version = MCS_SYS_VERSION;
+    head.order = 1;
+    head.nnz = A->nnz;
+    head.r_len = A->r_len;
+    head.c_len = A->c_len;
+    head.has_b = (b != NULL);
+    err |= fwrite(&head,sizeof(mcs_sys_head),1,f) != 1;
+    err |= fwrite(A->r,sizeof(long),nnz,f) != nnz;
+    err |= fwrite(A->c,sizeof(long),nnz,f) != nnz;
+    err |= fwrite(A->dat,sizeof(double),nnz,f) != nnz;
+    if(b != NULL){
+        err |= fwrite(b,sizeof(double),A->r_len,f) != (size_t) A->r_len;
+    }
+    err |= fclose(f) != 0;
+    if(err){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    return 0;
+}
+
+int mcs_sys_map_bin(const char* filename, mcs_sys_map** S, mcs_status* st){
+    struct stat sb;
+    mcs_sys_head* head;
+    void* base;
+    size_t len, need;
+    long k;
+    int fd;
+    *S = NULL;
+    fd = open(filename,O_RDONLY);
+    if(fd < 0){
+        return mcs_raise(st,FILE_READ_ONLY);
+    }
+    if(fstat(fd,&sb) != 0 || sb.st_size < (off_t) sizeof(mcs_sys_head)){
+        close(fd);
+        return mcs_raise(st,MCS_MATRIX_FMT);
+    }
+    len = (size_t) sb.st_size;
+    //private pages, so solvers may scale or overwrite the values in place
+    base = mmap(NULL,len,PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,0);
+    close(fd);
+    if(base == MAP_FAILED){
+        return mcs_raise(st,FILE_READ_ONLY);
+    }
+    head = (mcs_sys_head*) base;
+    need = sizeof(mcs_sys_head);
+    //sizes too large for the file would overflow need, so reject them
+    if(head->nnz >= 0 && head->r_len >= 0
+       && (size_t) head->nnz <= len/(2*sizeof(long)+sizeof(double))
+       && (size_t) head->r_len <= len/sizeof(double)){
+        need += (2*sizeof(long)+sizeof(double))*((size_t) head->nnz);
+        need += head->has_b ? sizeof(double)*((size_t) head->r_len) : 0;
+    }else{
+        need = 0;
+    }
+    if(memcmp(head->magic,MCS_SYS_MAGIC,8) != 0
+       || head->version != MCS_SYS_VERSION || head->order != 1
+       || head->nnz < 0 || head->r_len < 0 || head->c_len < 0
+       || need != len){
+        munmap(base,len);
+        return mcs_raise(st,MCS_MATRIX_FMT);
+    }
+    *S = (mcs_sys_map*) malloc(sizeof(mcs_sys_map));
+    (*S)->base = base;
+    (*S)->len = len;
+    (*S)->A.nnz = head->nnz;
+    (*S)->A.r_len = head->r_len;
+    (*S)->A.c_len = head->c_len;
+    (*S)->A.pat = NULL;
+    (*S)->A.r = (long*) &(head[1]);
+    (*S)->A.c = &((*S)->A.r[head->nnz]);
+    (*S)->A.dat = (double*) &((*S)->A.c[head->nnz]);
+    (*S)->b = head->has_b ? &((*S)->A.dat[head->nnz]) : NULL;
+    //solvers index with r and c unchecked, so check them once here
+    for(k=0;k<head->nnz;k++){
+        if((*S)->A.r[k] < 0 || (*S)->A.r[k] >= head->r_len
+           || (*S)->A.c[k] < 0 || (*S)->A.c[k] >= head->c_len){
+            mcs_sys_unmap(S);
+            return mcs_raise(st,MCS_MATRIX_FMT);
+        }
+    }
+    return 0;
+}
+
+void mcs_sys_unmap(mcs_sys_map** S){
+    munmap((*S)->base,(*S)->len);
+    free(*S);
+    *S = NULL;
+}
+
+void mcs_sys_capture(const char* tag, mcs_spmat* A, double* b,
+                     double seconds){
+    char filename[FILENAME_MAX];
+    const char* dir = getenv("MCS_CAPTURE_DIR");
+    const char* lim = getenv("MCS_CAPTURE_SECONDS");
+    double min_seconds = MCS_CAPTURE_DEFAULT;
+    mcs_status st;
+    long count;
+    if(dir == NULL || dir[0] == '\0'){
+        return;
+    }
+    if(lim != NULL && lim[0] != '\0'){
+        min_seconds = atof(lim);
+    }
+    if(seconds < min_seconds){
+        return;
+    }
+    #pragma omp atomic capture
+    count = mcs_capture_count++;
+    snprintf(filename,FILENAME_MAX,"%s/%s_%ld_%ld.bin",
+                dir,tag,(long) getpid(),count);
+    mcs_status_init(&st);
+    if(mcs_sys_write_bin(filename,A,b,&st)){
+        printf("%s",mcs_error_str(st.err));
+    }
+}
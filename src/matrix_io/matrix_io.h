@@ -0,0 +1,162 @@
+#ifndef MCS_MATRIX_IO_H
+#define MCS_MATRIX_IO_H
+
+/*
+ * Saving and loading of sparse linear systems by Bram Rodgers.
+ *
+ * A system A*x = b is stored in one of two formats:
+ * ->Matrix Market text, which most solver packages can read. A is written
+ *   in coordinate format and b in array format, in separate files.
+ * ->A raw binary file holding A and b together. It is laid out as
+ *   a header followed by the row, column, and value arrays of A and then
+ *   b, so it is loaded with mmap and nothing is parsed or copied.
+ *
+ * The binary format is only read on machines with the same size of long
+ * and byte order as the one which wrote it. This is checked when loading.
+ *
+ * Systems may also be captured while a simulation runs. If the
+ * environment variable MCS_CAPTURE_DIR names a directory, then every
+ * linear solve which takes at least MCS_CAPTURE_SECONDS seconds
+ * (default MCS_CAPTURE_DEFAULT) is written there in the binary format,
+ * so that slow cases can be replayed offline with the replay driver.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include<stdio.h>
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../error_handling/error_handling.h"
+
+/*
+ * Longest line of a Matrix Market file which is read.
+ */
+#define MCS_MM_LINE_LEN 1024
+
+/*
+ * First 8 bytes and format version of the binary system file.
+ */
+#define MCS_SYS_MAGIC   "MCSSYS\r\n"
+#define MCS_SYS_VERSION 1
+
+/*
+ * Default slowest solve time in seconds which is not captured.
+ */
+#define MCS_CAPTURE_DEFAULT 1.0
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * Header of the binary system file. Every field is 8 bytes so the
+ * arrays which follow it are aligned.
+ */
+typedef struct _mcs_sys_head{
+    char magic[8];      /*MCS_SYS_MAGIC*/
+    long version;       /*MCS_SYS_VERSION*/
+    long order;         /*The long 1 as written, checks size and byte order*/
+    long nnz;           /*Number of coordinate entries of A*/
+    long r_len;         /*Number of rows of A*/
+    long c_len;         /*Number of columns of A*/
+    long has_b;         /*1 if r_len entries of b follow the values of A*/
+    long unused;
+} mcs_sys_head;
+
+/*
+ * A system loaded with mmap. A and b point into the mapped file.
+ * The pages are mapped copy on write, so A->dat and b may be changed
+ * without changing the file.
+ */
+typedef struct _mcs_sys_map{
+    void* base;     /*Start of the mapping*/
+    size_t len;     /*Length of the mapping in bytes*/
+    mcs_spmat A;    /*Must not be given to mcs_free_spmat*/
+    double* b;      /*NULL if the file has no right hand side*/
+} mcs_sys_map;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Write A to filename as a real general coordinate Matrix Market file.
+ * Repeated entries are written as they are and are summed by readers.
+ *
+ * Returns 0 on success. On failure returns 1 after recording the error
+ * in st, or exits if st is NULL.
+ */
+int mcs_spmat_write_mm(const char* filename, mcs_spmat* A, mcs_status* st);
+
+/*
+ * Read a coordinate Matrix Market file into a newly allocated A.
+ * real, integer, and pattern entries are read, with pattern entries
+ * set to 1. symmetric and skew-symmetric files are expanded to both
+ * triangles.
+ *
+ * Returns 0 on success. On failure *A is NULL and returns 1 after
+ * recording the error in st, or exits if st is NULL.
+ */
+int mcs_spmat_read_mm(const char* filename, mcs_spmat** A, mcs_status* st);
+
+/*
+ * Write the n entries of x to filename as a real array Matrix Market file.
+ *
+ * Returns 0 on success. On failure returns 1 after recording the error
+ * in st, or exits if st is NULL.
+ */
+int mcs_vec_write_mm(const char* filename, double* x, long n,
+                     mcs_status* st);
+
+/*
+ * Read a real array Matrix Market file with one column into a newly
+ * allocated x of *n entries.
+ *
+ * Returns 0 on success. On failure *x is NULL and returns 1 after
+ * recording the error in st, or exits if st is NULL.
+ */
+int mcs_vec_read_mm(const char* filename, double** x, long* n,
+                    mcs_status* st);
+
+/*
+ * Write A and the right hand side b to filename in the binary format.
+ * b has A->r_len entries, or is NULL to store A alone.
+ *
+ * Returns 0 on success. On failure returns 1 after recording the error
+ * in st, or exits if st is NULL.
+ */
+int mcs_sys_write_bin(const char* filename, mcs_spmat* A, double* b,
+                      mcs_status* st);
+
+/*
+ * Map a binary system file into memory. Free it with mcs_sys_unmap.
+ * Every row and column index is checked against the size of the matrix
+ * once, so a corrupt file is rejected here rather than in a solver.
+ *
+ * Returns 0 on success. On failure *S is NULL and returns 1 after
+ * recording the error in st, or exits if st is NULL.
+ */
+int mcs_sys_map_bin(const char* filename, mcs_sys_map** S, mcs_status* st);
+
+/*
+ * Unmap a system loaded with mcs_sys_map_bin.
+ */
+void mcs_sys_unmap(mcs_sys_map** S);
+
+/*
+ * Write A and b to MCS_CAPTURE_DIR if capturing is enabled and seconds
+ * is at least the capture threshold. The file is named after tag, the
+ * process, and a count of captures. Errors are printed and ignored so
+ * a simulation never stops because a capture failed.
+ */
+void mcs_sys_capture(const char* tag, mcs_spmat* A, double* b,
+                     double seconds);
+
+#endif
@@ -18,7 +18,30 @@
 #include<stdio.h>
 #include"circuit_elements/circuit_elements.h"
 #include"error_handling/error_handling.h"
+#include"profiling/profiling.h"
 #include"netlist_parser/netlist_parser.h"
+#include"sparse_matrix/sparse_matrix.h"
+#include"sparse_lu/sparse_lu.h"
+#include"mna_system/mna_system.h"
+#include"dc_analysis/dc_analysis.h"
+#include"ac_analysis/ac_analysis.h"
+#include"batch_runner/batch_runner.h"
+#include"waveform_writer/waveform_writer.h"
+#include"transient_analysis/transient_analysis.h"
+#include"model_reduction/model_reduction.h"
+#include"domain_decomp/domain_decomp.h"
+#include"amg_solver/amg_solver.h"
+#include"sim_context/sim_context.h"
+#include"switch_level/switch_level.h"
+#include"matrix_io/matrix_io.h"
+#include"spmv_plan/spmv_plan.h"
+#include"krylov_recycle/krylov_recycle.h"
+#include"stamp_codegen/stamp_codegen.h"
+#include"pss_analysis/pss_analysis.h"
+#include"checkpoint/checkpoint.h"
+#include"eco_update/eco_update.h"
+#include"adjoint_sens/adjoint_sens.h"
+#include"parareal/parareal.h"
 
 /*
  * Object and Struct Definitions:
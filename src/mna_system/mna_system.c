@@ -0,0 +1,644 @@
+/*
+ * Implementation for:
+ * Modified Nodal Analysis (MNA) equations for a netlist by Bram Rodgers.
+ * Based on Chapters 2 and 3 of the textbook
+ * ``Circuit Simulation'' by Farid N. Najm.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "mna_system.h"
+#include <string.h>
+/*
+ * Locally used helper functions:
+ */
+
+void mcs_mna_put(long* r, long* c, double* dat, long* nz,
+                 long row, long col, double v);
+double mcs_mna_volt(double* x, long i);
+void mcs_mna_element(mcs_mna* M, long k, double* x, long* r, long* c,
+                     double* dat, long* nz, double* rhs);
+long mcs_mna_assemble_G(mcs_mna* M, double* x, long* r, long* c,
+                        double* dat, double* b);
+long mcs_mna_assemble_C(mcs_mna* M, long* r, long* c, double* dat);
+int mcs_mna_describe(mcs_element* z, double* val, unsigned long* node);
+void mcs_mna_expand(mcs_mna* T, mcs_netlist* nl, const unsigned long* gmap,
+                    long* k, unsigned long* next);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Write one coordinate entry. Entries in a ground row or column are
+ * skipped. Any of r, c, or dat may be NULL, in which case the entry is
+ * only counted.
+ */
+void mcs_mna_put(long* r, long* c, double* dat, long* nz,
+                 long row, long col, double v){
+    if(row < 0 || col < 0){
+        return;
+    }
+    if(r != NULL){
+        r[*nz] = row;
+        c[*nz] = col;
+    }
+    if(dat != NULL){
+        dat[*nz] = v;
+    }
+    (*nz)++;
+}
+
+/*
+ * Voltage of unknown i, where ground and a NULL x are zero.
+ */
+double mcs_mna_volt(double* x, long i){
+    if(x == NULL || i < 0){
+        return 0.0;
+    }
+    return x[i];
+}
+
+/*
+ * Device models, see mna_system.h.
+ */
+MCS_MNA_MODELS
+
+/*
+ * Write the coordinate entries of G for the element at position k of
+ * M->dev linearized at x, counting them in nz. Any of r, c, or dat may be
+ * NULL. rhs gets the right hand side contributions at the three terminals
+ * followed by the one at the branch current unknown.
+ */
+void mcs_mna_element(mcs_mna* M, long k, double* x, long* r, long* c,
+                     double* dat, long* nz, double* rhs){
+    long t, u, p, n, br;
+    long* term = &(M->term[3*k]);
+    double g, vd, id, s;
+    double v[3], cur[3], J[3][3], Jm[2][3];
+    p = term[0];
+    n = term[1];
+    for(t=0;t<4;t++){
+        rhs[t] = 0.0;
+    }
+    for(t=0;t<3;t++){
+        v[t] = mcs_mna_volt(x,term[t]);
+    }
+    switch(M->dev[k]->elem.symbol){
+        case 'V'://Voltage Source
+            br = M->branch[k];
+            mcs_mna_put(r,c,dat,nz,p,br,1.0);
+            mcs_mna_put(r,c,dat,nz,n,br,-1.0);
+            mcs_mna_put(r,c,dat,nz,br,p,1.0);
+            mcs_mna_put(r,c,dat,nz,br,n,-1.0);
+            rhs[3] += M->val[k];
+            break;
+        case 'I'://Current Source, flows from node_pos to node_neg
+            rhs[0] -= M->val[k];
+            rhs[1] += M->val[k];
+            break;
+        case 'R'://Resistor
+            g = 1.0/M->val[k];
+            mcs_mna_put(r,c,dat,nz,p,p,g);
+            mcs_mna_put(r,c,dat,nz,p,n,-g);
+            mcs_mna_put(r,c,dat,nz,n,p,-g);
+            mcs_mna_put(r,c,dat,nz,n,n,g);
+            break;
+        case 'C'://Capacitor, only appears in C
+            break;
+        case 'L'://Inductor, a short circuit in G
+            br = M->branch[k];
+            mcs_mna_put(r,c,dat,nz,p,br,1.0);
+            mcs_mna_put(r,c,dat,nz,n,br,-1.0);
+            mcs_mna_put(r,c,dat,nz,br,p,1.0);
+            mcs_mna_put(r,c,dat,nz,br,n,-1.0);
+            break;
+        case 'D'://Diode
+            vd = v[0] - v[1];
+            mcs_mna_junction(MCS_DIODE_IS,vd,&id,&g);
+            mcs_mna_put(r,c,dat,nz,p,p,g);
+            mcs_mna_put(r,c,dat,nz,p,n,-g);
+            mcs_mna_put(r,c,dat,nz,n,p,-g);
+            mcs_mna_put(r,c,dat,nz,n,n,g);
+            id -= g*vd;
+            rhs[0] -= id;
+            rhs[1] += id;
+            break;
+        case 'Q'://BJT
+            s = (M->dev[k]->QN.dope == 'N') ? 1.0 : -1.0;
+            mcs_mna_bjt(s,v,cur,J);
+            for(t=0;t<3;t++){
+                for(u=0;u<3;u++){
+                    mcs_mna_put(r,c,dat,nz,term[t],term[u],J[t][u]);
+                    cur[t] -= J[t][u]*v[u];
+                }
+                rhs[t] -= cur[t];
+            }
+            break;
+        case 'M'://MOSFET, the gate draws no current
+            s = (M->dev[k]->MN.dope == 'N') ? 1.0 : -1.0;
+            mcs_mna_mosfet(s,v,cur,Jm);
+            for(t=0;t<2;t++){
+                for(u=0;u<3;u++){
+                    mcs_mna_put(r,c,dat,nz,term[2*t],term[u],Jm[t][u]);
+                    cur[t] -= Jm[t][u]*v[u];
+                }
+                rhs[2*t] -= cur[t];
+            }
+            break;
+        default:
+            mcs_error(MCS_DEV_READ_UNKNOWN);
+    }
+}
+
+/*
+ * Walk the circuit and write the coordinate entries of G linearized at x,
+ * as well as the right hand side b. Every pointer argument may be NULL.
+ * Returns the number of entries written.
+ */
+long mcs_mna_assemble_G(mcs_mna* M, double* x, long* r, long* c,
+                        double* dat, double* b){
+    long k, t;
+    long nz = 0;
+    double rhs[4];
+    if(b != NULL){
+        for(k=0;k<M->dim;k++){
+            b[k] = 0.0;
+        }
+    }
+    for(k=0;k<M->num_dev;k++){
+        mcs_mna_element(M,k,x,r,c,dat,&nz,rhs);
+        if(b == NULL){
+            continue;
+        }
+        for(t=0;t<3;t++){
+            if(M->term[3*k+t] >= 0){
+                b[M->term[3*k+t]] += rhs[t];
+            }
+        }
+        if(M->branch[k] >= 0){
+            b[M->branch[k]] += rhs[3];
+        }
+    }
+    for(k=0;k<M->num_nodes;k++){
+        mcs_mna_put(r,c,dat,&nz,k,k,M->gmin);
+    }
+    return nz;
+}
+
+/*
+ * Walk the circuit and write the coordinate entries of C.
+ * Every pointer argument may be NULL.
+ * Returns the number of entries written.
+ */
+long mcs_mna_assemble_C(mcs_mna* M, long* r, long* c, double* dat){
+    long k, p, n, br;
+    long nz = 0;
+    for(k=0;k<M->num_dev;k++){
+        p = M->term[3*k];
+        n = M->term[3*k+1];
+        switch(M->dev[k]->elem.symbol){
+            case 'C'://Capacitor
+                mcs_mna_put(r,c,dat,&nz,p,p,M->val[k]);
+                mcs_mna_put(r,c,dat,&nz,p,n,-M->val[k]);
+                mcs_mna_put(r,c,dat,&nz,n,p,-M->val[k]);
+                mcs_mna_put(r,c,dat,&nz,n,n,M->val[k]);
+                break;
+            case 'L'://Inductor branch equation v = L*(d/dt)i
+                br = M->branch[k];
+                mcs_mna_put(r,c,dat,&nz,br,br,-M->val[k]);
+                break;
+            default:
+                break;
+        }
+    }
+    return nz;
+}
+
+/*
+ * Write the value and the three nodes of element z into val and node.
+ * Unused nodes are 0. Returns 1 if z has a branch current unknown.
+ */
+int mcs_mna_describe(mcs_element* z, double* val, unsigned long* node){
+    *val = 0.0;
+    node[2] = 0;
+    switch(z->elem.symbol){
+        case 'V':
+        case 'I':
+        case 'R':
+        case 'C':
+        case 'L':
+            //V, I, R, C, and L share one memory layout.
+            *val = z->L.henry;
+            node[0] = z->L.node_pos;
+            node[1] = z->L.node_neg;
+            return (z->elem.symbol == 'V' || z->elem.symbol == 'L');
+        case 'D':
+            node[0] = z->D.node_pos;
+            node[1] = z->D.node_neg;
+            return 0;
+        case 'Q':
+            node[0] = z->QN.node_c;
+            node[1] = z->QN.node_b;
+            node[2] = z->QN.node_e;
+            return 0;
+        case 'M':
+            node[0] = z->MN.node_d;
+            node[1] = z->MN.node_g;
+            node[2] = z->MN.node_s;
+            return 0;
+        default:
+            mcs_error(MCS_DEV_READ_UNKNOWN);
+    }
+    return 0;
+}
+
+/*
+ * Append the elements of nl to T starting at position *k. Node l of nl is
+ * node gmap[l] of the circuit, or node l itself if gmap is NULL. The
+ * internal nodes of instances are numbered from *next on.
+ */
+void mcs_mna_expand(mcs_mna* T, mcs_netlist* nl, const unsigned long* gmap,
+                    long* k, unsigned long* next){
+    mcs_netlist* this_line;
+    mcs_element* z;
+    mcs_subckt* S;
+    unsigned long* cmap;
+    unsigned long node[3];
+    unsigned long l, n;
+    long t;
+    for(this_line = nl; this_line != NULL; this_line = this_line->next){
+        z = this_line->dev;
+        if(z->elem.symbol == 'X'){
+            //map the local nodes of the definition to circuit nodes
+            S = z->X.sub;
+            cmap = (unsigned long*) malloc(sizeof(unsigned long)
+                                           *(S->max_node+1));
+            for(l=0;l<=S->max_node;l++){
+                if(S->map[l] >= 0){
+                    cmap[l] = *next + (unsigned long) S->map[l];
+                }else if(S->map[l] == -1){
+                    cmap[l] = 0;
+                }else{
+                    n = z->X.node[-S->map[l]-2];
+                    cmap[l] = (gmap == NULL) ? n : gmap[n];
+                }
+            }
+            *next += (unsigned long) S->num_internal;
+            mcs_mna_expand(T,S->body,cmap,k,next);
+            free(cmap);
+            continue;
+        }
+        T->dev[*k] = z;
+        T->branch[*k] = -1;
+        if(mcs_mna_describe(z,&(T->val[*k]),node)){
+            T->branch[*k] = T->num_branch++;
+        }
+        for(t=0;t<3;t++){
+            n = (gmap == NULL) ? node[t] : gmap[node[t]];
+            T->term[3*(*k)+t] = ((long) n) - 1;
+        }
+        (*k)++;
+    }
+}
+
+void mcs_alloc_mna(mcs_mna** M, mcs_netlist* nl){
+    mcs_netlist* this_line;
+    mcs_element* z;
+    mcs_mna* T;
+    long k, t, n;
+    unsigned long buf[3];
+    unsigned long* node;
+    unsigned long next = 0;
+    double rhs[4];
+    T = (mcs_mna*) malloc(sizeof(mcs_mna));
+    T->num_dev = 0;
+    for(this_line = nl; this_line != NULL; this_line = this_line->next){
+        z = this_line->dev;
+        T->num_dev += (z->elem.symbol == 'X') ? z->X.sub->num_dev : 1;
+        //internal nodes of instances come after the top level nodes
+        n = mcs_element_nodes(z,buf,&node);
+        for(t=0;t<n;t++){
+            if(node[t] > next){
+                next = node[t];
+            }
+        }
+    }
+    next++;
+    T->dev = (mcs_element**) malloc(sizeof(mcs_element*)*(T->num_dev+1));
+    T->val = (double*) malloc(sizeof(double)*(T->num_dev+1));
+    T->term = (long*) malloc(sizeof(long)*(3*T->num_dev+1));
+    T->branch = (long*) malloc(sizeof(long)*(T->num_dev+1));
+    T->num_nodes = 0;
+    T->num_branch = 0;
+    T->gmin = MCS_GMIN;
+    T->gen_G = NULL;
+    k = 0;
+    mcs_mna_expand(T,nl,NULL,&k,&next);
+    T->num_nodes = ((long) next) - 1;
+    //branch currents are stored after the node voltages
+    for(k=0;k<T->num_dev;k++){
+        if(T->branch[k] >= 0){
+            T->branch[k] += T->num_nodes;
+        }
+    }
+    T->dim = T->num_nodes + T->num_branch;
+    T->G_off = (long*) malloc(sizeof(long)*(T->num_dev+1));
+    T->G_off[0] = 0;
+    for(k=0;k<T->num_dev;k++){
+        T->G_off[k+1] = T->G_off[k];
+        mcs_mna_element(T,k,NULL,NULL,NULL,NULL,&(T->G_off[k+1]),rhs);
+    }
+    T->nnz_G = mcs_mna_assemble_G(T,NULL,NULL,NULL,NULL,NULL);
+    T->nnz_C = mcs_mna_assemble_C(T,NULL,NULL,NULL);
+    *M = T;
+}
+
+void mcs_free_mna(mcs_mna** M){
+    free((*M)->G_off);
+    free((*M)->branch);
+    free((*M)->term);
+    free((*M)->val);
+    free((*M)->dev);
+    free(*M);
+}
+
+int mcs_mna_check(mcs_mna* M){
+    long k, t, nz;
+    double rhs[4];
+    char sym;
+    if(M->num_nodes < 0 || M->dim < M->num_nodes || M->G_off[0] != 0){
+        return 1;
+    }
+    for(k=0;k<M->num_dev;k++){
+        sym = M->dev[k]->elem.symbol;
+        if(sym == '\0' || strchr("VIRCLDQM",sym) == NULL){
+            return 1;
+        }
+        for(t=0;t<3;t++){
+            if(M->term[3*k+t] < -1 || M->term[3*k+t] >= M->num_nodes){
+                return 1;
+            }
+        }
+        if(M->branch[k] != -1 && (M->branch[k] < M->num_nodes
+                                  || M->branch[k] >= M->dim)){
+            return 1;
+        }
+    }
+    //the unknowns are in range, so the entries may now be counted
+    for(k=0;k<M->num_dev;k++){
+        nz = M->G_off[k];
+        mcs_mna_element(M,k,NULL,NULL,NULL,NULL,&nz,rhs);
+        if(nz != M->G_off[k+1]){
+            return 1;
+        }
+    }
+    if(mcs_mna_assemble_G(M,NULL,NULL,NULL,NULL,NULL) != M->nnz_G
+       || mcs_mna_assemble_C(M,NULL,NULL,NULL) != M->nnz_C){
+        return 1;
+    }
+    return 0;
+}
+
+long mcs_mna_find(mcs_mna* M, char symbol, unsigned long idx){
+    long k;
+    unsigned long this_idx;
+    for(k=0;k<M->num_dev;k++){
+        if(M->dev[k]->elem.symbol != symbol){
+            continue;
+        }
+        //BJTs and MOSFETs store the doping pattern before idx
+        if(symbol == 'Q' || symbol == 'M'){
+            this_idx = M->dev[k]->QN.idx;
+        }else{
+            this_idx = M->dev[k]->V.idx;
+        }
+        if(this_idx == idx){
+            return k;
+        }
+    }
+    return -1;
+}
+
+void mcs_mna_element_name(mcs_mna* M, long k, char* name){
+    mcs_element* z = M->dev[k];
+    if(z->elem.symbol == 'Q' || z->elem.symbol == 'M'){
+        sprintf(name,"%c%c%lu",z->QN.symbol,z->QN.dope,z->QN.idx);
+    }else{
+        sprintf(name,"%c%lu",z->V.symbol,z->V.idx);
+    }
+}
+
+void mcs_mna_unknown_name(mcs_mna* M, long i, char* name){
+    long k;
+    if(i < M->num_nodes){
+        sprintf(name,"v(%ld)",i+1);
+        return;
+    }
+    for(k=0;k<M->num_dev;k++){
+        if(M->branch[k] == i){
+            name[0] = 'i';
+            name[1] = '(';
+            mcs_mna_element_name(M,k,&(name[2]));
+            strcat(name,")");
+            return;
+        }
+    }
+}
+
+void mcs_mna_flat_element(mcs_mna* M, long k, mcs_element* z){
+    *z = *(M->dev[k]);
+    switch(z->elem.symbol){
+        case 'V':
+        case 'I':
+        case 'R':
+        case 'C':
+        case 'L':
+            z->L.henry = M->val[k];
+            z->L.node_pos = (unsigned long) (M->term[3*k]+1);
+            z->L.node_neg = (unsigned long) (M->term[3*k+1]+1);
+            break;
+        case 'D':
+            z->D.node_pos = (unsigned long) (M->term[3*k]+1);
+            z->D.node_neg = (unsigned long) (M->term[3*k+1]+1);
+            break;
+        case 'Q':
+        case 'M':
+            z->MN.node_d = (unsigned long) (M->term[3*k]+1);
+            z->MN.node_g = (unsigned long) (M->term[3*k+1]+1);
+            z->MN.node_s = (unsigned long) (M->term[3*k+2]+1);
+            break;
+    }
+}
+
+void mcs_mna_flatten(mcs_mna* M, mcs_netlist** nl){
+    mcs_netlist** this_line = nl;
+    mcs_netlist* prev_line = NULL;
+    long k;
+    *nl = NULL;
+    for(k=0;k<M->num_dev;k++){
+        mcs_alloc_netlist(this_line);
+        mcs_mna_flat_element(M,k,(*this_line)->dev);
+        (*this_line)->prev = prev_line;
+        prev_line = *this_line;
+        this_line = &((*this_line)->next);
+    }
+}
+
+int mcs_mna_is_linear(mcs_mna* M){
+    long k;
+    for(k=0;k<M->num_dev;k++){
+        switch(M->dev[k]->elem.symbol){
+            case 'V':
+            case 'I':
+            case 'R':
+            case 'C':
+            case 'L':
+                break;
+            default:
+                return 0;
+        }
+    }
+    return 1;
+}
+
+void mcs_mna_alloc_G(mcs_mna* M, mcs_spmat** G){
+    MCS_PROF_START(t_asm);
+    mcs_alloc_spmat(G,M->nnz_G,M->dim,M->dim);
+    mcs_mna_assemble_G(M,NULL,(*G)->r,(*G)->c,(*G)->dat,NULL);
+    MCS_PROF_STOP(MCS_PROF_ASSEMBLE,t_asm);
+}
+
+void mcs_mna_alloc_C(mcs_mna* M, mcs_spmat** C){
+    MCS_PROF_START(t_asm);
+    mcs_alloc_spmat(C,M->nnz_C,M->dim,M->dim);
+    mcs_mna_assemble_C(M,(*C)->r,(*C)->c,(*C)->dat);
+    MCS_PROF_STOP(MCS_PROF_ASSEMBLE,t_asm);
+}
+
+void mcs_mna_stamp_G(mcs_mna* M, double* x, double* G_dat, double* b){
+    double* b_own;
+    MCS_PROF_START(t_asm);
+    if(M->gen_G != NULL && x != NULL && G_dat != NULL){
+        //M is shared between threads, so the scratch belongs to this call
+        b_own = (b == NULL) ? (double*) malloc(sizeof(double)*(M->dim+1))
+                            : b;
+        M->gen_G(M->val,M->gmin,x,G_dat,b_own);
+        if(b == NULL){
+            free(b_own);
+        }
+        MCS_PROF_STOP(MCS_PROF_ASSEMBLE,t_asm);
+        return;
+    }
+    mcs_mna_assemble_G(M,x,NULL,NULL,G_dat,b);
+    MCS_PROF_STOP(MCS_PROF_ASSEMBLE,t_asm);
+}
+
+void mcs_mna_stamp_element(mcs_mna* M, long k, double* x,
+                           double* G_dat, double* rhs){
+    long nz = M->G_off[k];
+    mcs_mna_element(M,k,x,NULL,NULL,G_dat,&nz,rhs);
+}
+
+void mcs_mna_stamp_C(mcs_mna* M, double* C_dat){
+    MCS_PROF_START(t_asm);
+    mcs_mna_assemble_C(M,NULL,NULL,C_dat);
+    MCS_PROF_STOP(MCS_PROF_ASSEMBLE,t_asm);
+}
+
+void mcs_mna_add_source(mcs_mna* M, long k, double v, double* b){
+    long p = M->term[3*k];
+    long n = M->term[3*k+1];
+    switch(M->dev[k]->elem.symbol){
+        case 'V':
+            b[M->branch[k]] += v;
+            break;
+        case 'I':
+            if(p >= 0){
+                b[p] -= v;
+            }
+            if(n >= 0){
+                b[n] += v;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void mcs_mna_unit_source(mcs_mna* M, long k, double* b){
+    long i;
+    for(i=0;i<M->dim;i++){
+        b[i] = 0.0;
+    }
+    mcs_mna_add_source(M,k,1.0,b);
+}
+
+int mcs_mna_add_element(mcs_mna* M, mcs_element* e){
+    long k = M->num_dev;
+    long t;
+    unsigned long node[3];
+    double val, rhs[4];
+    int br = mcs_mna_describe(e,&val,node);
+    for(t=0;t<3;t++){
+        if((long) node[t] > M->num_nodes){
+            return 1;
+        }
+    }
+    M->dev = (mcs_element**) realloc(M->dev,sizeof(mcs_element*)*(k+2));
+    M->val = (double*) realloc(M->val,sizeof(double)*(k+2));
+    M->term = (long*) realloc(M->term,sizeof(long)*(3*k+4));
+    M->branch = (long*) realloc(M->branch,sizeof(long)*(k+2));
+    M->G_off = (long*) realloc(M->G_off,sizeof(long)*(k+2));
+    M->dev[k] = e;
+    M->val[k] = val;
+    for(t=0;t<3;t++){
+        M->term[3*k+t] = ((long) node[t]) - 1;
+    }
+    M->branch[k] = -1;
+    if(br){
+        //the new branch current goes after all the others
+        M->branch[k] = M->dim;
+        M->num_branch++;
+        M->dim++;
+    }
+    M->num_dev++;
+    M->G_off[k+1] = M->G_off[k];
+    mcs_mna_element(M,k,NULL,NULL,NULL,NULL,&(M->G_off[k+1]),rhs);
+    M->nnz_G += M->G_off[k+1] - M->G_off[k];
+    M->nnz_C = mcs_mna_assemble_C(M,NULL,NULL,NULL);
+    return 0;
+}
+
+void mcs_mna_remove_element(mcs_mna* M, long k){
+    long j;
+    long br = M->branch[k];
+    long m = M->G_off[k+1] - M->G_off[k];
+    for(j=k;j<M->num_dev-1;j++){
+        M->dev[j] = M->dev[j+1];
+        M->val[j] = M->val[j+1];
+        M->branch[j] = M->branch[j+1];
+        M->term[3*j] = M->term[3*j+3];
+        M->term[3*j+1] = M->term[3*j+4];
+        M->term[3*j+2] = M->term[3*j+5];
+        M->G_off[j+1] = M->G_off[j+2] - m;
+    }
+    M->num_dev--;
+    M->nnz_G -= m;
+    if(br >= 0){
+        for(j=0;j<M->num_dev;j++){
+            if(M->branch[j] > br){
+                M->branch[j]--;
+            }
+        }
+        M->num_branch--;
+        M->dim--;
+    }
+    M->nnz_C = mcs_mna_assemble_C(M,NULL,NULL,NULL);
+}
@@ -0,0 +1,315 @@
+#ifndef MCS_MNA_SYSTEM_H
+#define MCS_MNA_SYSTEM_H
+
+/*
+ * Modified Nodal Analysis (MNA) equations for a netlist by Bram Rodgers.
+ * Based on Chapters 2 and 3 of the textbook
+ * ``Circuit Simulation'' by Farid N. Najm.
+ *
+ * A netlist is written as the system
+ *      G*x + C*(d/dt)x = b
+ * where x holds the node voltages followed by the branch currents of
+ * the voltage sources and inductors. Node 0 is ground and is not stored,
+ * so node k is entry k-1 of x.
+ *
+ * Nonlinear devices are linearized at a given x, in which case G is the
+ * Jacobian and b holds the companion model currents for a Newton step.
+ *
+ * The coordinate entries of G and C are always written in the same order,
+ * so the sparsity pattern is computed once and only values are restamped.
+ *
+ * Subcircuit instances are expanded here. Their elements are not copied:
+ * every instance points M->dev at the elements of the shared definition,
+ * and only the unknowns in M->term and the values in M->val are kept per
+ * instance. The internal nodes of instances are numbered after the nodes
+ * of the top level netlist, in netlist order.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include<stdio.h>
+#include"math.h"
+#include"../circuit_elements/circuit_elements.h"
+#include"../netlist_parser/netlist_parser.h"
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../error_handling/error_handling.h"
+#include"../profiling/profiling.h"
+
+/*
+ * Device parameters. No model parameters are stored on the elements,
+ * so every semiconductor device uses these values.
+ */
+#define MCS_VT          0.025852 /*Thermal voltage at 300K, in Volts*/
+#define MCS_EXP_LIM     40.0     /*Junction exponentials are linear past this*/
+#define MCS_DIODE_IS    1.0e-14  /*Diode saturation current, in Amps*/
+#define MCS_BJT_IS      1.0e-16  /*BJT saturation current, in Amps*/
+#define MCS_BJT_BF      100.0    /*BJT forward current gain*/
+#define MCS_BJT_BR      1.0      /*BJT reverse current gain*/
+#define MCS_MOS_K       2.0e-4   /*MOSFET k'*(W/L), in Amps/Volt^2*/
+#define MCS_MOS_VTH     0.7      /*MOSFET threshold voltage magnitude*/
+#define MCS_MOS_LAMBDA  0.01     /*MOSFET channel length modulation*/
+
+/*
+ * Default conductance from every node to ground. Keeps nodes which are
+ * only attached to capacitors or to nothing at all from being singular.
+ */
+#define MCS_GMIN        1.0e-12
+
+/*
+ * Device models, shared by mna_system.c and the generated code of
+ * stamp_codegen.c, which writes the text of MCS_MNA_MODELS into its source.
+ *
+ * mcs_mna_junction gives the current i and conductance g of a pn junction
+ * at voltage v. The exponential is continued linearly past MCS_EXP_LIM so
+ * that Newton iterations which overshoot do not overflow.
+ *
+ * mcs_mna_bjt is the Ebers-Moll transport model of a BJT. s = 1 for NPN
+ * and s = -1 for PNP. v holds the collector, base, and emitter voltages.
+ * On exit cur holds the currents flowing into those terminals and J[t][u]
+ * is the derivative of the current into terminal t with respect to the
+ * voltage of terminal u.
+ *
+ * mcs_mna_mosfet is the square law model of a MOSFET. s = 1 for n-channel
+ * and s = -1 for p-channel. v holds the drain, gate, and source voltages.
+ * On exit cur holds the currents flowing into the drain and source and
+ * J[t][u] is the derivative of the current into drain (t=0) or source
+ * (t=1) with respect to the voltage of the drain, gate, or source. The
+ * terminal at the higher n-channel equivalent voltage is the drain.
+ */
+#define MCS_MNA_MODELS \
+static inline void mcs_mna_junction(double is, double v, double* i, \
+                                    double* g){ \
+    double a = v/MCS_VT; \
+    double e; \
+    if(a > MCS_EXP_LIM){ \
+        e = exp(MCS_EXP_LIM); \
+        *i = is*(e*(1.0 + a - MCS_EXP_LIM) - 1.0); \
+    }else{ \
+        e = exp(a); \
+        *i = is*(e - 1.0); \
+    } \
+    *g = is*e/MCS_VT; \
+} \
+static inline void mcs_mna_bjt(double s, double* v, double* cur, \
+                               double J[3][3]){ \
+    double i_f, g_f, i_r, g_r; \
+    int u; \
+    mcs_mna_junction(MCS_BJT_IS,s*(v[1]-v[2]),&i_f,&g_f); \
+    mcs_mna_junction(MCS_BJT_IS,s*(v[1]-v[0]),&i_r,&g_r); \
+    cur[0] = s*(i_f - i_r*(1.0 + 1.0/MCS_BJT_BR)); \
+    cur[1] = s*(i_f/MCS_BJT_BF + i_r/MCS_BJT_BR); \
+    cur[2] = -(cur[0] + cur[1]); \
+    J[0][0] = g_r*(1.0 + 1.0/MCS_BJT_BR); \
+    J[0][1] = g_f - g_r*(1.0 + 1.0/MCS_BJT_BR); \
+    J[0][2] = -g_f; \
+    J[1][0] = -g_r/MCS_BJT_BR; \
+    J[1][1] = g_f/MCS_BJT_BF + g_r/MCS_BJT_BR; \
+    J[1][2] = -g_f/MCS_BJT_BF; \
+    for(u=0;u<3;u++){ \
+        J[2][u] = -(J[0][u] + J[1][u]); \
+    } \
+} \
+static inline void mcs_mna_mosfet(double s, double* v, double* cur, \
+                                  double J[2][3]){ \
+    int hi = 0, lo = 2; \
+    double vgs, vds, vov, id, gm, gds, clm; \
+    if(s*v[0] < s*v[2]){ \
+        hi = 2; \
+        lo = 0; \
+    } \
+    vgs = s*(v[1] - v[lo]); \
+    vds = s*(v[hi] - v[lo]); \
+    vov = vgs - MCS_MOS_VTH; \
+    clm = 1.0 + MCS_MOS_LAMBDA*vds; \
+    if(vov <= 0.0){ \
+        id = 0.0; \
+        gm = 0.0; \
+        gds = 0.0; \
+    }else if(vds < vov){ \
+        id = MCS_MOS_K*(vov*vds - 0.5*vds*vds); \
+        gm = MCS_MOS_K*vds*clm; \
+        gds = MCS_MOS_K*(vov - vds)*clm + id*MCS_MOS_LAMBDA; \
+        id *= clm; \
+    }else{ \
+        id = 0.5*MCS_MOS_K*vov*vov; \
+        gm = MCS_MOS_K*vov*clm; \
+        gds = id*MCS_MOS_LAMBDA; \
+        id *= clm; \
+    } \
+    cur[hi/2] = s*id; \
+    cur[lo/2] = -s*id; \
+    J[hi/2][hi] = gds; \
+    J[hi/2][1] = gm; \
+    J[hi/2][lo] = -(gm + gds); \
+    J[lo/2][hi] = -gds; \
+    J[lo/2][1] = -gm; \
+    J[lo/2][lo] = gm + gds; \
+}
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * Stamping code generated for one circuit, see stamp_codegen.h. Writes G
+ * linearized at x into G_dat and the right hand side into b, exactly as
+ * mcs_mna_stamp_G does, where val and gmin are those of the circuit.
+ * None of the pointers may be NULL.
+ */
+typedef void (*mcs_mna_gen)(const double* val, double gmin, const double* x,
+                            double* G_dat, double* b);
+
+typedef struct _mcs_mna{
+    long num_dev;       /*Number of circuit elements*/
+    mcs_element** dev;  /*Each circuit element, in netlist order. Nodes of
+                          instance elements are local, see M->term*/
+    double* val;        /*volt, amp, ohm, farad, or henry of each element*/
+    long* term;         /*3 unknown indices per element, -1 is ground*/
+    long* branch;       /*Branch current unknown of each element, or -1*/
+    long num_nodes;     /*Number of non-ground nodes*/
+    long num_branch;    /*Number of branch currents*/
+    long dim;           /*num_nodes + num_branch*/
+    long nnz_G;         /*Number of coordinate entries of G*/
+    long nnz_C;         /*Number of coordinate entries of C*/
+    long* G_off;        /*First entry of G written by each element*/
+    double gmin;        /*Conductance from each node to ground*/
+    mcs_mna_gen gen_G;  /*Generated stamping code, or NULL*/
+} mcs_mna;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Build the MNA description of the netlist nl. The netlist must outlive M.
+ * Element values are copied into M->val, so changing M->val changes the
+ * circuit seen by the stamping functions without touching the netlist.
+ */
+void mcs_alloc_mna(mcs_mna** M, mcs_netlist* nl);
+
+/*
+ * Free an MNA description. The netlist is not freed.
+ */
+void mcs_free_mna(mcs_mna** M);
+
+/*
+ * Check an MNA description which was not built by mcs_alloc_mna, such as
+ * one read from a file: every element is one of V I R C L D Q M, every
+ * unknown in M->term and M->branch is in range, and M->G_off, M->nnz_G,
+ * and M->nnz_C agree with the elements. Returns 0 if M is consistent.
+ */
+int mcs_mna_check(mcs_mna* M);
+
+/*
+ * Return the position in M->dev of the element with the given symbol and
+ * numeric identifier, or -1 if it is not in the circuit.
+ */
+long mcs_mna_find(mcs_mna* M, char symbol, unsigned long idx);
+
+/*
+ * Write the netlist name of the element at position k of M->dev,
+ * such as R3 or QN2, into name.
+ */
+void mcs_mna_element_name(mcs_mna* M, long k, char* name);
+
+/*
+ * Write the name of unknown i into name. Node voltages are named like
+ * v(3) and branch currents like i(V1).
+ */
+void mcs_mna_unknown_name(mcs_mna* M, long i, char* name);
+
+/*
+ * Return 1 if the circuit contains only V, I, R, C, and L elements.
+ */
+int mcs_mna_is_linear(mcs_mna* M);
+
+/*
+ * Allocate the sparse matrix G and write its sparsity pattern.
+ * The values are those of G linearized at x = 0.
+ */
+void mcs_mna_alloc_G(mcs_mna* M, mcs_spmat** G);
+
+/*
+ * Allocate the sparse matrix C and write its sparsity pattern and values.
+ */
+void mcs_mna_alloc_C(mcs_mna* M, mcs_spmat** C);
+
+/*
+ * Write the values of G linearized at x into G_dat and the right hand
+ * side into b. If x is NULL then devices are linearized at x = 0.
+ * G_dat has M->nnz_G entries, ordered as in mcs_mna_alloc_G.
+ * b has M->dim entries. Either of G_dat or b may be NULL.
+ * Uses M->gen_G when it is set and x and G_dat are given, with scratch
+ * space of its own when b is NULL, so M is never written.
+ */
+void mcs_mna_stamp_G(mcs_mna* M, double* x, double* G_dat, double* b);
+
+/*
+ * Write the values of G for only the element at position k of M->dev,
+ * linearized at x, into G_dat[M->G_off[k]] up to G_dat[M->G_off[k+1]-1].
+ * rhs gets the 4 right hand side contributions of the element, which are
+ * added to b at the unknowns M->term[3*k], M->term[3*k+1], M->term[3*k+2],
+ * and M->branch[k] when those are not ground. Other entries are untouched.
+ */
+void mcs_mna_stamp_element(mcs_mna* M, long k, double* x,
+                           double* G_dat, double* rhs);
+
+/*
+ * Write the values of C into C_dat, ordered as in mcs_mna_alloc_C.
+ */
+void mcs_mna_stamp_C(mcs_mna* M, double* C_dat);
+
+/*
+ * Add to b the right hand side of the voltage or current source at
+ * position k of M->dev with the value v. Other elements are ignored.
+ */
+void mcs_mna_add_source(mcs_mna* M, long k, double v, double* b);
+
+/*
+ * Write into b the right hand side for a unit excitation of the
+ * voltage or current source at position k of M->dev, with every other
+ * source set to zero.
+ */
+void mcs_mna_unit_source(mcs_mna* M, long k, double* b);
+
+/*
+ * Append the element e to M. The caller also appends e to the netlist,
+ * so M->dev stays in netlist order. Every node of e must already be in
+ * the circuit. A voltage source or inductor gets a branch current after
+ * all the others, so M->dim grows by one.
+ * Returns 0, or 1 with M unchanged if e has a new node.
+ */
+int mcs_mna_add_element(mcs_mna* M, mcs_element* e);
+
+/*
+ * Remove the element at position k of M->dev, along with its branch
+ * current if it has one. Later branch currents move down by one. The
+ * element is not freed.
+ *
+ * After either edit the pattern of G and C has changed, so matrices,
+ * factors, and generated code made for M no longer fit it.
+ */
+void mcs_mna_remove_element(mcs_mna* M, long k);
+
+/*
+ * Write a copy of the element at position k of M->dev into z, with the
+ * circuit nodes of M->term and the value in M->val. Element names repeat
+ * across instances of one definition.
+ */
+void mcs_mna_flat_element(mcs_mna* M, long k, mcs_element* z);
+
+/*
+ * Write a new netlist holding a flat copy of every element of M, in the
+ * order of M->dev, which is freed with mcs_free_netlist as usual.
+ */
+void mcs_mna_flatten(mcs_mna* M, mcs_netlist** nl);
+
+#endif
@@ -0,0 +1,281 @@
+/*
+ * Implementation for:
+ * Model order reduction of RC interconnect for MicroCircSim
+ * by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "model_reduction.h"
+
+/*
+ * Adjacency of one node of the RC network. Ground keeps no adjacency,
+ * edges to ground are only stored on the other node.
+ */
+typedef struct _mcs_ticer_node{
+    long deg;       /*Number of neighbors*/
+    long cap;       /*Allocated length of nbr, g, and c*/
+    long* nbr;      /*Neighboring node numbers*/
+    double* g;      /*Conductance to each neighbor*/
+    double* c;      /*Capacitance to each neighbor*/
+    int keep;       /*1 if this node is a port*/
+    int gone;       /*1 once this node is eliminated*/
+} mcs_ticer_node;
+
+/*
+ * Locally used helper functions:
+ */
+
+void mcs_ticer_half(mcs_ticer_node* a, long b, double g, double c);
+void mcs_ticer_add(mcs_ticer_node* net, long a, long b, double g, double c);
+void mcs_ticer_unlink(mcs_ticer_node* a, long b);
+void mcs_ticer_eliminate(mcs_ticer_node* net, long n);
+mcs_netlist** mcs_ticer_append(mcs_netlist** tail, mcs_netlist** prev);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Add g and c to the edge from a to b, as seen from a.
+ */
+void mcs_ticer_half(mcs_ticer_node* a, long b, double g, double c){
+    long i;
+    for(i=0;i<a->deg;i++){
+        if(a->nbr[i] == b){
+            a->g[i] += g;
+            a->c[i] += c;
+            return;
+        }
+    }
+    if(a->deg == a->cap){
+        a->cap = 2*a->cap + 4;
+        a->nbr = (long*) realloc(a->nbr,sizeof(long)*a->cap);
+        a->g = (double*) realloc(a->g,sizeof(double)*a->cap);
+        a->c = (double*) realloc(a->c,sizeof(double)*a->cap);
+    }
+    a->nbr[a->deg] = b;
+    a->g[a->deg] = g;
+    a->c[a->deg] = c;
+    a->deg++;
+}
+
+/*
+ * Add conductance g and capacitance c between nodes a and b.
+ */
+void mcs_ticer_add(mcs_ticer_node* net, long a, long b, double g, double c){
+    if(a == b){
+        return;
+    }
+    if(a != 0){
+        mcs_ticer_half(&(net[a]),b,g,c);
+    }
+    if(b != 0){
+        mcs_ticer_half(&(net[b]),a,g,c);
+    }
+}
+
+/*
+ * Remove b from the neighbors of a.
+ */
+void mcs_ticer_unlink(mcs_ticer_node* a, long b){
+    long i;
+    for(i=0;i<a->deg;i++){
+        if(a->nbr[i] == b){
+            a->deg--;
+            a->nbr[i] = a->nbr[a->deg];
+            a->g[i] = a->g[a->deg];
+            a->c[i] = a->c[a->deg];
+            return;
+        }
+    }
+}
+
+/*
+ * Eliminate node n, connecting each pair of its neighbors.
+ */
+void mcs_ticer_eliminate(mcs_ticer_node* net, long n){
+    mcs_ticer_node* z = &(net[n]);
+    double G = 0.0;
+    long i, j;
+    for(i=0;i<z->deg;i++){
+        G += z->g[i];
+        if(z->nbr[i] != 0){
+            mcs_ticer_unlink(&(net[z->nbr[i]]),n);
+        }
+    }
+    for(i=0;i<z->deg;i++){
+        for(j=i+1;j<z->deg;j++){
+            mcs_ticer_add(net,z->nbr[i],z->nbr[j],
+                          z->g[i]*z->g[j]/G,
+                          (z->c[i]*z->g[j] + z->c[j]*z->g[i])/G);
+        }
+    }
+    z->deg = 0;
+    z->gone = 1;
+}
+
+/*
+ * Allocate a new netlist entry at *tail, linked after *prev.
+ * Returns the location of the next entry.
+ */
+mcs_netlist** mcs_ticer_append(mcs_netlist** tail, mcs_netlist** prev){
+    mcs_alloc_netlist(tail);
+    (*tail)->prev = *prev;
+    *prev = *tail;
+    return &((*tail)->next);
+}
+
+long mcs_ticer_reduce(mcs_netlist* nl,
+                      long num_port,
+                      unsigned long* port,
+                      double tau_max,
+                      long max_degree,
+                      mcs_netlist** out,
+                      unsigned long** node_map,
+                      mcs_status* st){
+    mcs_netlist* this_line;
+    mcs_netlist* prev = NULL;
+    mcs_netlist** tail = out;
+    mcs_ticer_node* net;
+    mcs_element* z;
+    unsigned long* map;
+    unsigned long max_node = 0, n, k;
+    unsigned long r_idx = 1, c_idx = 1;
+    long i, d, num_gone = 0;
+    int changed;
+    double G, C;
+    *out = NULL;
+    *node_map = NULL;
+    //find the largest node number
+    for(this_line = nl; this_line != NULL; this_line = this_line->next){
+        z = this_line->dev;
+        if(z->elem.symbol == 'X'){
+            mcs_raise(st,MCS_BAD_ARG);
+            return -1;
+        }
+        if(z->elem.symbol == 'Q' || z->elem.symbol == 'M'){
+            n = z->QN.node_c;
+            n = (z->QN.node_b > n) ? z->QN.node_b : n;
+            n = (z->QN.node_e > n) ? z->QN.node_e : n;
+        }else{
+            n = (z->V.node_pos > z->V.node_neg) ? z->V.node_pos
+                                                : z->V.node_neg;
+        }
+        max_node = (n > max_node) ? n : max_node;
+    }
+    for(i=0;i<num_port;i++){
+        if(port[i] > max_node){
+            mcs_raise(st,MCS_BAD_ARG);
+            return -1;
+        }
+    }
+    net = (mcs_ticer_node*) calloc(max_node+1,sizeof(mcs_ticer_node));
+    net[0].keep = 1;
+    for(i=0;i<num_port;i++){
+        net[port[i]].keep = 1;
+    }
+    //build the RC network and mark the nodes of every other element
+    for(this_line = nl; this_line != NULL; this_line = this_line->next){
+        z = this_line->dev;
+        switch(z->elem.symbol){
+            case 'R':
+                mcs_ticer_add(net,z->R.node_pos,z->R.node_neg,
+                              1.0/z->R.ohm,0.0);
+                break;
+            case 'C':
+                mcs_ticer_add(net,z->C.node_pos,z->C.node_neg,
+                              0.0,z->C.farad);
+                break;
+            case 'Q':
+            case 'M':
+                net[z->QN.node_c].keep = 1;
+                net[z->QN.node_b].keep = 1;
+                net[z->QN.node_e].keep = 1;
+                break;
+            default:
+                net[z->V.node_pos].keep = 1;
+                net[z->V.node_neg].keep = 1;
+        }
+    }
+    //eliminate quick nodes, low degree first to limit fill
+    for(d=1;d<=max_degree;d++){
+        do{
+            changed = 0;
+            for(n=1;n<=max_node;n++){
+                if(net[n].keep || net[n].gone || net[n].deg > d){
+                    continue;
+                }
+                G = 0.0;
+                C = 0.0;
+                for(i=0;i<net[n].deg;i++){
+                    G += net[n].g[i];
+                    C += net[n].c[i];
+                }
+                if(G > 0.0 && C < tau_max*G){
+                    mcs_ticer_eliminate(net,n);
+                    num_gone++;
+                    changed = 1;
+                }
+            }
+        }while(changed);
+    }
+    //renumber the kept nodes consecutively
+    map = (unsigned long*) malloc(sizeof(unsigned long)*(max_node+1));
+    map[0] = 0;
+    k = 1;
+    for(n=1;n<=max_node;n++){
+        map[n] = (net[n].gone) ? 0 : k++;
+    }
+    //copy every element other than R and C
+    for(this_line = nl; this_line != NULL; this_line = this_line->next){
+        z = this_line->dev;
+        if(z->elem.symbol == 'R' || z->elem.symbol == 'C'){
+            continue;
+        }
+        tail = mcs_ticer_append(tail,&prev);
+        *(prev->dev) = *z;
+        z = prev->dev;
+        if(z->elem.symbol == 'Q' || z->elem.symbol == 'M'){
+            z->QN.node_c = map[z->QN.node_c];
+            z->QN.node_b = map[z->QN.node_b];
+            z->QN.node_e = map[z->QN.node_e];
+        }else{
+            z->V.node_pos = map[z->V.node_pos];
+            z->V.node_neg = map[z->V.node_neg];
+        }
+    }
+    //write the reduced RC network, each edge once
+    for(n=1;n<=max_node;n++){
+        for(i=0;i<net[n].deg;i++){
+            k = net[n].nbr[i];
+            if(k != 0 && k < n){
+                continue;
+            }
+            if(net[n].g[i] > 0.0){
+                tail = mcs_ticer_append(tail,&prev);
+                mcs_init_resistor(&(prev->dev->R),r_idx++,map[n],map[k],
+                                  1.0/net[n].g[i]);
+            }
+            if(net[n].c[i] > 0.0){
+                tail = mcs_ticer_append(tail,&prev);
+                mcs_init_capacitor(&(prev->dev->C),c_idx++,map[n],map[k],
+                                   net[n].c[i]);
+            }
+        }
+    }
+    for(n=0;n<=max_node;n++){
+        free(net[n].c);
+        free(net[n].g);
+        free(net[n].nbr);
+    }
+    free(net);
+    *node_map = map;
+    return num_gone;
+}
@@ -0,0 +1,78 @@
+#ifndef MCS_MODEL_REDUCTION_H
+#define MCS_MODEL_REDUCTION_H
+
+/*
+ * Model order reduction of RC interconnect for MicroCircSim
+ * by Bram Rodgers.
+ *
+ * Implements TICER (Time Constant Equilibration Reduction) node
+ * elimination. A node of the RC network whose time constant
+ *      (sum of attached capacitances)/(sum of attached conductances)
+ * is small is eliminated. Each pair j, k of its neighbors gets the
+ * conductance g_j*g_k/G and the capacitance (c_j*g_k + c_k*g_j)/G,
+ * where g and c are the conductance and capacitance from the eliminated
+ * node to each neighbor and G is their total conductance.
+ *
+ * The conductances are an exact Schur complement, so DC behavior at the
+ * kept nodes is preserved exactly. The capacitances are accurate for
+ * frequencies well below 1/tau_max.
+ *
+ * The result is an ordinary netlist, so it replaces the original netlist
+ * in every other analysis.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../circuit_elements/circuit_elements.h"
+#include"../netlist_parser/netlist_parser.h"
+#include"../error_handling/error_handling.h"
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Reduce the R and C elements of nl with TICER and store the reduced
+ * netlist in *out. nl is unchanged.
+ *
+ * Nodes attached to any element other than R or C are ports and are never
+ * eliminated, and so are ground and the num_port nodes listed in port.
+ * A node is eliminated when its time constant is below tau_max and it
+ * has at most max_degree neighbors, which bounds the fill created.
+ *
+ * Kept nodes are renumbered consecutively. On exit (*node_map)[n] is the
+ * new number of original node n, or 0 if it was eliminated. *node_map is
+ * allocated with malloc and must be freed by the caller. Resistors and
+ * capacitors of *out are numbered from 1, other elements are copied.
+ *
+ * nl may not hold subcircuit instances. Flatten such a netlist first with
+ * mcs_mna_flatten.
+ *
+ * Returns the number of eliminated nodes. If nl holds a subcircuit
+ * instance or a port is not a node of nl, then returns -1 with *out and
+ * *node_map set to NULL after recording MCS_BAD_ARG in st. If st is NULL
+ * then mcs_error is called instead.
+ */
+long mcs_ticer_reduce(mcs_netlist* nl,
+                      long num_port,
+                      unsigned long* port,
+                      double tau_max,
+                      long max_degree,
+                      mcs_netlist** out,
+                      unsigned long** node_map,
+                      mcs_status* st);
+
+#endif
@@ -15,47 +15,112 @@
  * Locally used helper functions:
  */
 
-void mcs_netlist_str2struct(char* nl_line, mcs_netlist** nl);
-void mcs_parse_VIRCL(char* nl_line,
-                     unsigned long* idx_ptr,
-                     unsigned long* node_p_ptr,
-                     unsigned long* node_n_ptr,
-                     double* param_ptr);
-void mcs_parse_diode(char* nl_line,
-                     unsigned long* idx_ptr,
-                     unsigned long* node_p_ptr,
-                     unsigned long* node_n_ptr);
-void mcs_parse_transistor(char* nl_line,
-                          unsigned long* idx_ptr,
-                          unsigned long* node_1_ptr,
-                          unsigned long* node_2_ptr,
-                          unsigned long* node_3_ptr);
+int mcs_netlist_str2struct(char* nl_line,
+                           mcs_netlist** nl,
+                           mcs_subckt* defs,
+                           mcs_status* st);
+int mcs_parse_VIRCL(char* nl_line,
+                    unsigned long* idx_ptr,
+                    unsigned long* node_p_ptr,
+                    unsigned long* node_n_ptr,
+                    double* param_ptr,
+                    mcs_status* st);
+int mcs_parse_diode(char* nl_line,
+                    unsigned long* idx_ptr,
+                    unsigned long* node_p_ptr,
+                    unsigned long* node_n_ptr,
+                    mcs_status* st);
+int mcs_parse_transistor(char* nl_line,
+                         unsigned long* idx_ptr,
+                         unsigned long* node_1_ptr,
+                         unsigned long* node_2_ptr,
+                         unsigned long* node_3_ptr,
+                         mcs_status* st);
+/*
+ * Parse an instance line X<idx> n1 ... nk name into z, taking a reference
+ * to the definition name in the list defs.
+ */
+int mcs_parse_instance(char* nl_line,
+                       mcs_subckt* defs,
+                       mcs_element* z,
+                       mcs_status* st);
+/*
+ * Handle a line starting with '.', which opens the definition *open on
+ * .SUBCKT and moves it to the front of *defs on .ENDS.
+ */
+int mcs_netlist_dot(char* nl_line,
+                    mcs_subckt** defs,
+                    mcs_subckt** open,
+                    mcs_status* st);
+/*
+ * Find the definition with the given name, or return NULL.
+ */
+mcs_subckt* mcs_find_subckt(mcs_subckt* defs, const char* name);
+/*
+ * Count the nodes and elements of S once its body is complete.
+ */
+void mcs_finish_subckt(mcs_subckt* S);
+/*
+ * Write the definitions used by the instances in nl which have mark 0,
+ * those they use first, and set their mark to 1.
+ */
+int mcs_write_subckt_r(FILE* net_text,
+                       mcs_netlist* nl,
+                       char* nl_line,
+                       mcs_status* st);
+/*
+ * Set the mark of every definition used in nl back to 0.
+ */
+void mcs_clear_subckt(mcs_netlist* nl);
+/*
+ * Free one element, releasing the definition of an instance.
+ */
+void mcs_free_element(mcs_element* z);
 
 /*
  * Static Local Variables:
  */
 
+//Separators of the fields of subcircuit lines. The line ends in '\n' or
+//the end of file character, which must not become part of a name.
+static const char mcs_subckt_sep[] = {' ','\t','\r','\n',(char) EOF,'\0'};
+
 /*
  * Function Implementations:
  */
 
 
 void mcs_read_netlist(const char* filename, mcs_netlist** nl){
+    char nl_line[MCS_NETLIST_LINE_LEN+1];
+    mcs_read_netlist_r(filename,nl,nl_line,NULL);
+}
+
+int mcs_read_netlist_r(const char* filename,
+                       mcs_netlist** nl,
+                       char* nl_line,
+                       mcs_status* st){
     static const char r_only[2] = "r";
-    static char nl_line[MCS_NETLIST_LINE_LEN+1];
     int i = 0;
     int newline_idx = 0;
+    long line_num = 0;
+    int err = 0;
     mcs_netlist** this_line = nl;
     mcs_netlist* prev_line = NULL;
+    mcs_subckt* defs = NULL;        //definitions parsed so far
+    mcs_subckt* open = NULL;        //definition between .SUBCKT and .ENDS
+    mcs_subckt* next_def = NULL;
+    mcs_netlist** body_line = NULL;
+    mcs_netlist* body_prev = NULL;
     //pointer to location of the comment character '%'
     char* token_ptr = NULL;
     FILE* net_text = fopen(filename,r_only);
     if(net_text == NULL){ //if you cant open the file
-        mcs_error(FILE_READ_ONLY);//throw an error to stdout and exit.
+        return mcs_raise(st,FILE_READ_ONLY);//record it or exit.
     }
-    
+    MCS_PROF_START(t_parse);
     do{
         //reading a single line
+        line_num++;
         newline_idx = -1;
         for(i=0; i < MCS_NETLIST_LINE_LEN; i++){
             nl_line[i] = (char) fgetc(net_text);
@@ -69,8 +134,10 @@ void mcs_read_netlist(const char* filename, mcs_netlist** nl){
         if(newline_idx < 0){
             //if a newline or end of file comes after max line length,
             //then error out based on formatting error.
-            mcs_error(MCS_NETLIST_FMT);
+            err = mcs_raise(st,MCS_NETLIST_FMT);
+            break;
         }
+        MCS_PROF_COUNT(MCS_PROF_BYTES_READ,newline_idx+1);
         //nl_line contains a Cstring with 1 line of the parsed file now.
         token_ptr = strchr(nl_line, (int) '%' );
         //To ignore everything after the comment, just change the
@@ -103,34 +170,105 @@ void mcs_read_netlist(const char* filename, mcs_netlist** nl){
         if(*token_ptr == (char) EOF){
             break;
         }
+        if(*token_ptr == '.'){
+            err = mcs_netlist_dot(token_ptr, &defs, &open, st);
+            if(err){
+                break;
+            }
+            body_line = (open == NULL) ? NULL : &(open->body);
+            body_prev = NULL;
+            continue;
+        }
+        if(open != NULL){
+            //element lines of a definition go to its body
+            err = mcs_netlist_str2struct(token_ptr, body_line, defs, st);
+            if(err){
+                break;
+            }
+            (*body_line)->prev = body_prev;
+            body_prev = *body_line;
+            body_line = &((*body_line)->next);
+            continue;
+        }
         //The token ptr contains a pointer to a non space and non-newline char.
         //Now call the helper function which processes this
         //string into a netlist struct
-        mcs_netlist_str2struct(token_ptr, this_line);
+        err = mcs_netlist_str2struct(token_ptr, this_line, defs, st);
+        if(err){
+            break;
+        }
         (*this_line)->prev = prev_line;
         //Move on to next line of the file.
         prev_line = *this_line;
         this_line = &((*this_line)->next);
     }while(1);
+    MCS_PROF_STOP(MCS_PROF_PARSE,t_parse);
     fclose(net_text);
+    if(!err && open != NULL){//.SUBCKT without .ENDS
+        err = mcs_raise(st,MCS_NETLIST_FMT);
+    }
+    if(open != NULL){
+        mcs_release_subckt(open);
+    }
+    //drop the references of the parser, freeing unused definitions.
+    while(defs != NULL){
+        next_def = defs->next;
+        defs->next = NULL;
+        mcs_release_subckt(defs);
+        defs = next_def;
+    }
+    if(err){
+        //free the lines which were parsed before the bad one.
+        if(prev_line != NULL){
+            mcs_free_netlist(nl);
+        }
+        *nl = NULL;
+        st->line = line_num;
+    }
+    return err;
 }
 
 void mcs_write_netlist(char* filename, mcs_netlist* nl){
+    char nl_line[MCS_NETLIST_LINE_LEN+1];
+    mcs_write_netlist_r(filename,nl,nl_line,NULL);
+}
+
+int mcs_write_netlist_r(char* filename,
+                        mcs_netlist* nl,
+                        char* nl_line,
+                        mcs_status* st){
     static const char w_only[2] = "w";
-    static char nl_line[MCS_NETLIST_LINE_LEN+1];
     FILE* net_text = fopen(filename,w_only);
     mcs_netlist* this_line = nl;
-    while(this_line->next != NULL){
-        mcs_print_element(nl_line, this_line->dev);
+    int err = 0;
+    if(net_text == NULL){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    err = mcs_write_subckt_r(net_text,nl,nl_line,st);
+    mcs_clear_subckt(nl);
+    if(err){
+        fclose(net_text);
+        return 1;
+    }
+    while(this_line != NULL){
+        if(mcs_print_element_r(nl_line, this_line->dev, st)){
+            fclose(net_text);
+            return 1;
+        }
         fprintf(net_text,"%s\n",nl_line);
         this_line = this_line->next;
     }
-    mcs_print_element(nl_line, this_line->dev);
-    fprintf(net_text,"%s\n",nl_line);
     fclose(net_text);
+    return 0;
 }
 
 void mcs_print_element(char* nl_line, mcs_element* z){
+    mcs_print_element_r(nl_line,z,NULL);
+}
+
+int mcs_print_element_r(char* nl_line, mcs_element* z, mcs_status* st){
+    long p = 0;
+    int len = 0;
     //We assumme that the pointer nl_line has at least 81 characters allocated.
     //First step: read the char which is stored as the first
     //entry of the union z.
@@ -153,7 +291,7 @@ void mcs_print_element(char* nl_line, mcs_element* z){
                     z->QN.dope,z->QN.idx,z->QN.node_c,
                     z->QN.node_b,z->QN.node_e);
             }else{
-            mcs_error(MCS_DEV_WRITE_UNKNOWN);
+            return mcs_raise(st,MCS_DEV_WRITE_UNKNOWN);
             }
             break;
         case 'M'://MOSFET
@@ -162,18 +300,37 @@ void mcs_print_element(char* nl_line, mcs_element* z){
                     z->MN.dope,z->MN.idx,z->MN.node_d,
                     z->MN.node_g,z->MN.node_s);                
             }else{
-            mcs_error(MCS_DEV_WRITE_UNKNOWN);
+            return mcs_raise(st,MCS_DEV_WRITE_UNKNOWN);
+            }
+            break;
+        case 'X'://Subcircuit instance
+            len = snprintf(nl_line,MCS_NETLIST_LINE_LEN+1,"X%lu",z->X.idx);
+            for(p=0;p<z->X.sub->num_port;p++){
+                if(len > MCS_NETLIST_LINE_LEN){
+                    break;
+                }
+                len += snprintf(&(nl_line[len]),MCS_NETLIST_LINE_LEN+1-len,
+                                " %lu",z->X.node[p]);
+            }
+            if(len <= MCS_NETLIST_LINE_LEN){
+                len += snprintf(&(nl_line[len]),MCS_NETLIST_LINE_LEN+1-len,
+                                " %s",z->X.sub->name);
+            }
+            if(len > MCS_NETLIST_LINE_LEN){//would not fit on one line
+                return mcs_raise(st,MCS_DEV_WRITE_UNKNOWN);
             }
             break;
         default:
-            mcs_error(MCS_DEV_WRITE_UNKNOWN);
+            return mcs_raise(st,MCS_DEV_WRITE_UNKNOWN);
     }
+    return 0;
 }
 
 
 void mcs_alloc_netlist(mcs_netlist** nl){
     *nl = (mcs_netlist*) malloc(sizeof(mcs_netlist));
     (*nl)->dev = (mcs_element*) malloc(sizeof(mcs_element));
+    MCS_PROF_COUNT(MCS_PROF_ALLOCS,2);
     (*nl)->next = NULL;
     (*nl)->prev = NULL;
 }
@@ -187,7 +344,7 @@ void mcs_free_netlist(mcs_netlist** nl){
                 free(netlist->prev);
             }
             if(netlist->dev != NULL){
-                free(netlist->dev);
+                mcs_free_element(netlist->dev);
             }
             netlist = netlist->next;
         }
@@ -195,49 +352,295 @@ void mcs_free_netlist(mcs_netlist** nl){
             free(netlist->prev);
         }
         if(netlist->dev != NULL){
-            free(netlist->dev);
+            mcs_free_element(netlist->dev);
         }
         free(netlist);
     }
 }
 
+void mcs_free_element(mcs_element* z){
+    if(z->elem.symbol == 'X'){
+        mcs_release_subckt(z->X.sub);
+        free(z->X.node);
+    }
+    free(z);
+}
+
+void mcs_release_subckt(mcs_subckt* S){
+    S->refs--;
+    if(S->refs > 0){
+        return;
+    }
+    if(S->body != NULL){
+        mcs_free_netlist(&(S->body));
+    }
+    if(S->map != NULL){
+        free(S->map);
+    }
+    free(S->port);
+    free(S);
+}
+
+long mcs_element_nodes(mcs_element* z, unsigned long* buf,
+                       unsigned long** node){
+    *node = buf;
+    switch(z->elem.symbol){
+        case 'V':
+        case 'I':
+        case 'R':
+        case 'C':
+        case 'L':
+            buf[0] = z->L.node_pos;
+            buf[1] = z->L.node_neg;
+            return 2;
+        case 'D':
+            buf[0] = z->D.node_pos;
+            buf[1] = z->D.node_neg;
+            return 2;
+        case 'Q':
+        case 'M'://QN, QP, MN, and MP share one layout
+            buf[0] = z->MN.node_d;
+            buf[1] = z->MN.node_g;
+            buf[2] = z->MN.node_s;
+            return 3;
+        case 'X':
+            *node = z->X.node;
+            return z->X.sub->num_port;
+        default:
+            return 0;
+    }
+}
+
+mcs_subckt* mcs_find_subckt(mcs_subckt* defs, const char* name){
+    while(defs != NULL){
+        if(strcmp(defs->name,name) == 0){
+            return defs;
+        }
+        defs = defs->next;
+    }
+    return NULL;
+}
+
+int mcs_netlist_dot(char* nl_line,
+                    mcs_subckt** defs,
+                    mcs_subckt** open,
+                    mcs_status* st){
+    char* token_ptr = NULL;
+    char* end_ptr = NULL;
+    char* save_ptr = NULL;
+    mcs_subckt* S = NULL;
+    unsigned long n = 0;
+    long p = 0;
+    token_ptr = strtok_r(nl_line,mcs_subckt_sep,&save_ptr);
+    if(strcmp(token_ptr,".ENDS") == 0){
+        if(*open == NULL){//.ENDS without .SUBCKT
+            return mcs_raise(st,MCS_NETLIST_FMT);
+        }
+        mcs_finish_subckt(*open);
+        (*open)->next = *defs;
+        *defs = *open;
+        *open = NULL;
+        return 0;
+    }
+    if(strcmp(token_ptr,".SUBCKT") != 0){
+        return mcs_raise(st,MCS_DEV_READ_UNKNOWN);
+    }
+    token_ptr = strtok_r(NULL,mcs_subckt_sep,&save_ptr);
+    if(*open != NULL                              || //nested definition
+       token_ptr == NULL                          ||
+       strlen(token_ptr) > MCS_SUBCKT_NAME_LEN    ||
+       mcs_find_subckt(*defs,token_ptr) != NULL){    //defined twice
+        return mcs_raise(st,MCS_NETLIST_FMT);
+    }
+    S = (mcs_subckt*) malloc(sizeof(mcs_subckt));
+    //a line holds at most half as many fields as characters
+    S->port = (unsigned long*) malloc(sizeof(unsigned long)
+                                      *(MCS_NETLIST_LINE_LEN/2+1));
+    MCS_PROF_COUNT(MCS_PROF_ALLOCS,2);
+    strcpy(S->name,token_ptr);
+    S->num_port = 0;
+    S->max_node = 0;
+    S->map = NULL;
+    S->num_internal = 0;
+    S->num_dev = 0;
+    S->num_node = 0;
+    S->body = NULL;
+    S->refs = 1;//held by the parser until the end of the file
+    S->mark = 0;
+    S->next = NULL;
+    while((token_ptr = strtok_r(NULL,mcs_subckt_sep,&save_ptr)) != NULL){
+        errno = 0;
+        n = strtoul(token_ptr, &end_ptr, 10);
+        if((n == 0 && errno != 0) || (token_ptr == end_ptr)){
+            mcs_release_subckt(S);
+            return mcs_raise(st,MCS_NUM_PARSER);
+        }
+        //ports are distinct nodes other than ground
+        for(p=0;p<S->num_port;p++){
+            if(S->port[p] == n){
+                break;
+            }
+        }
+        if(n == 0 || p < S->num_port){
+            mcs_release_subckt(S);
+            return mcs_raise(st,MCS_NETLIST_FMT);
+        }
+        S->port[S->num_port] = n;
+        S->num_port++;
+    }
+    *open = S;
+    return 0;
+}
+
+void mcs_finish_subckt(mcs_subckt* S){
+    mcs_netlist* line = NULL;
+    unsigned long buf[3];
+    unsigned long* node = NULL;
+    unsigned long l = 0;
+    long p,n;
+    for(p=0;p<S->num_port;p++){
+        if(S->port[p] > S->max_node){
+            S->max_node = S->port[p];
+        }
+    }
+    for(line=S->body;line!=NULL;line=line->next){
+        n = mcs_element_nodes(line->dev,buf,&node);
+        for(p=0;p<n;p++){
+            if(node[p] > S->max_node){
+                S->max_node = node[p];
+            }
+        }
+        if(line->dev->elem.symbol == 'X'){
+            S->num_dev  += line->dev->X.sub->num_dev;
+            S->num_node += line->dev->X.sub->num_node;
+        }else{
+            S->num_dev++;
+        }
+    }
+    S->map = (long*) malloc(sizeof(long)*(S->max_node+1));
+    MCS_PROF_COUNT(MCS_PROF_ALLOCS,1);
+    for(l=0;l<=S->max_node;l++){
+        S->map[l] = -1;
+    }
+    for(p=0;p<S->num_port;p++){
+        S->map[S->port[p]] = -p-2;
+    }
+    //number the internal nodes in order of first use
+    for(line=S->body;line!=NULL;line=line->next){
+        n = mcs_element_nodes(line->dev,buf,&node);
+        for(p=0;p<n;p++){
+            if(node[p] != 0 && S->map[node[p]] == -1){
+                S->map[node[p]] = S->num_internal;
+                S->num_internal++;
+            }
+        }
+    }
+    S->num_node += S->num_internal;
+}
+
+int mcs_write_subckt_r(FILE* net_text,
+                       mcs_netlist* nl,
+                       char* nl_line,
+                       mcs_status* st){
+    mcs_subckt* S = NULL;
+    mcs_netlist* line = NULL;
+    long p = 0;
+    for(;nl!=NULL;nl=nl->next){
+        if(nl->dev->elem.symbol != 'X' || nl->dev->X.sub->mark != 0){
+            continue;
+        }
+        S = nl->dev->X.sub;
+        S->mark = 1;
+        if(mcs_write_subckt_r(net_text,S->body,nl_line,st)){
+            return 1;
+        }
+        fprintf(net_text,".SUBCKT %s",S->name);
+        for(p=0;p<S->num_port;p++){
+            fprintf(net_text," %lu",S->port[p]);
+        }
+        fprintf(net_text,"\n");
+        for(line=S->body;line!=NULL;line=line->next){
+            if(mcs_print_element_r(nl_line, line->dev, st)){
+                return 1;
+            }
+            fprintf(net_text,"%s\n",nl_line);
+        }
+        fprintf(net_text,".ENDS\n");
+    }
+    return 0;
+}
+
+void mcs_clear_subckt(mcs_netlist* nl){
+    for(;nl!=NULL;nl=nl->next){
+        if(nl->dev->elem.symbol == 'X' && nl->dev->X.sub->mark != 0){
+            nl->dev->X.sub->mark = 0;
+            mcs_clear_subckt(nl->dev->X.sub->body);
+        }
+    }
+}
 
 
 
-void mcs_netlist_str2struct(char* nl_line, mcs_netlist** nl){
+
+int mcs_netlist_str2struct(char* nl_line,
+                           mcs_netlist** nl,
+                           mcs_subckt* defs,
+                           mcs_status* st){
     unsigned long dev_idx,node1,node2,node3;
     double param;
+    int err = 0;
     //allocate the memory for this netlist entry
     mcs_alloc_netlist(nl);
     //read the first character of the netlist line, switching
     //on this char to initialize the netlist entry.
     switch(nl_line[0]){
         case 'V'://Voltage Source
-            mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param);
+            if(mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param,st)){
+                err = 1;
+                break;
+            }
             mcs_init_voltage(&((*nl)->dev->V),dev_idx,node1,node2,param);
             break;
         case 'I'://Current Source
-            mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param);
+            if(mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param,st)){
+                err = 1;
+                break;
+            }
             mcs_init_current(&((*nl)->dev->I),dev_idx,node1,node2,param);
             break;
         case 'R'://Resistor
-            mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param);
+            if(mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param,st)){
+                err = 1;
+                break;
+            }
             mcs_init_resistor(&((*nl)->dev->R),dev_idx,node1,node2,param);
             break;
         case 'C'://Capacitor
-            mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param);
+            if(mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param,st)){
+                err = 1;
+                break;
+            }
             mcs_init_capacitor(&((*nl)->dev->C),dev_idx,node1,node2,param);
             break;
         case 'L'://Inductor
-            mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param);
+            if(mcs_parse_VIRCL(nl_line,&dev_idx,&node1,&node2,&param,st)){
+                err = 1;
+                break;
+            }
             mcs_init_inductor(&((*nl)->dev->L),dev_idx,node1,node2,param);
             break;
         case 'D'://Diode
-            mcs_parse_diode(nl_line,&dev_idx,&node1,&node2);
+            if(mcs_parse_diode(nl_line,&dev_idx,&node1,&node2,st)){
+                err = 1;
+                break;
+            }
             mcs_init_diode(&((*nl)->dev->D),dev_idx,node1,node2);
             break;
         case 'Q'://BJT
-            mcs_parse_transistor(nl_line,&dev_idx,&node1,&node2,&node3);
+            if(mcs_parse_transistor(nl_line,&dev_idx,&node1,&node2,&node3,st)){
+                err = 1;
+                break;
+            }
             if(nl_line[1] == 'N'){
                 mcs_init_bjt_npn(&((*nl)->dev->QN),
                                         dev_idx,node1,node2,node3);
@@ -245,11 +648,14 @@ void mcs_netlist_str2struct(char* nl_line, mcs_netlist** nl){
                 mcs_init_bjt_pnp(&((*nl)->dev->QP),
                                         dev_idx,node1,node2,node3);
             }else{
-            mcs_error(MCS_DEV_READ_UNKNOWN);
+            err = mcs_raise(st,MCS_DEV_READ_UNKNOWN);
             }
             break;
         case 'M'://MOSFET
-            mcs_parse_transistor(nl_line,&dev_idx,&node1,&node2,&node3);
+            if(mcs_parse_transistor(nl_line,&dev_idx,&node1,&node2,&node3,st)){
+                err = 1;
+                break;
+            }
             if(nl_line[1] == 'N'){
                 mcs_init_mosfet_nc(&((*nl)->dev->MN),
                                         dev_idx,node1,node2,node3);
@@ -257,99 +663,189 @@ void mcs_netlist_str2struct(char* nl_line, mcs_netlist** nl){
                 mcs_init_mosfet_pc(&((*nl)->dev->MP),
                                         dev_idx,node1,node2,node3);
             }else{
-            mcs_error(MCS_DEV_READ_UNKNOWN);
+            err = mcs_raise(st,MCS_DEV_READ_UNKNOWN);
             }
             break;
+        case 'X'://Subcircuit instance
+            err = mcs_parse_instance(nl_line,defs,(*nl)->dev,st);
+            break;
         default:
-            mcs_error(MCS_DEV_READ_UNKNOWN);
+            err = mcs_raise(st,MCS_DEV_READ_UNKNOWN);
+    }
+    if(err){
+        //drop the entry so the caller only frees complete lines
+        free((*nl)->dev);
+        free(*nl);
+        *nl = NULL;
     }
+    return err;
 }
 
-void mcs_parse_VIRCL(char* nl_line,
-                     unsigned long* idx_ptr,
-                     unsigned long* node_p_ptr,
-                     unsigned long* node_n_ptr,
-                     double* param_ptr){
+int mcs_parse_VIRCL(char* nl_line,
+                    unsigned long* idx_ptr,
+                    unsigned long* node_p_ptr,
+                    unsigned long* node_n_ptr,
+                    double* param_ptr,
+                    mcs_status* st){
     char* token_ptr = &(nl_line[1]);
     char* end_ptr = NULL;
+    char* save_ptr = NULL;
     errno = 0;//reset error number to zero before calling
     *idx_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*idx_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    token_ptr = strtok_r(end_ptr," \t",&save_ptr);
+    if(token_ptr == NULL){//too few fields on this line
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
-    token_ptr = strtok(end_ptr," \t");
     *node_p_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*node_p_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    token_ptr = strtok_r(NULL," \t",&save_ptr);
+    if(token_ptr == NULL){//too few fields on this line
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
-    token_ptr = strtok(NULL," \t");
     errno = 0;
     *node_n_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*node_n_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    token_ptr = strtok_r(NULL," \t",&save_ptr);
+    if(token_ptr == NULL){//too few fields on this line
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
-    token_ptr = strtok(NULL," \t");
     errno = 0;
     *param_ptr = strtod(token_ptr,&end_ptr);
     if((*node_n_ptr == 0.0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
+    return 0;
 }
 
 
-void mcs_parse_diode(char* nl_line,
-                     unsigned long* idx_ptr,
-                     unsigned long* node_p_ptr,
-                     unsigned long* node_n_ptr){
+int mcs_parse_diode(char* nl_line,
+                    unsigned long* idx_ptr,
+                    unsigned long* node_p_ptr,
+                    unsigned long* node_n_ptr,
+                    mcs_status* st){
     char* token_ptr = &(nl_line[1]);
     char* end_ptr = NULL;
+    char* save_ptr = NULL;
     errno = 0;//reset error number to zero before calling
     *idx_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*idx_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    token_ptr = strtok_r(end_ptr," \t",&save_ptr);
+    if(token_ptr == NULL){//too few fields on this line
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
-    token_ptr = strtok(end_ptr," \t");
     errno = 0;
     *node_p_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*node_p_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    token_ptr = strtok_r(NULL," \t",&save_ptr);
+    if(token_ptr == NULL){//too few fields on this line
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
-    token_ptr = strtok(NULL," \t");
     errno = 0;
     *node_n_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*node_n_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
+    return 0;
 }
 
-void mcs_parse_transistor(char* nl_line,
-                          unsigned long* idx_ptr,
-                          unsigned long* node_1_ptr,
-                          unsigned long* node_2_ptr,
-                          unsigned long* node_3_ptr){
+int mcs_parse_transistor(char* nl_line,
+                         unsigned long* idx_ptr,
+                         unsigned long* node_1_ptr,
+                         unsigned long* node_2_ptr,
+                         unsigned long* node_3_ptr,
+                         mcs_status* st){
     char* token_ptr = &(nl_line[2]);
     char* end_ptr = NULL;
+    char* save_ptr = NULL;
     errno = 0;//reset error number to zero before calling
     *idx_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*idx_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    token_ptr = strtok_r(end_ptr," \t",&save_ptr);
+    if(token_ptr == NULL){//too few fields on this line
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
-    token_ptr = strtok(end_ptr," \t");
     errno = 0;
     *node_1_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*node_1_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    token_ptr = strtok_r(NULL," \t",&save_ptr);
+    if(token_ptr == NULL){//too few fields on this line
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
-    token_ptr = strtok(NULL," \t");
     errno = 0;
     *node_2_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*node_2_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    token_ptr = strtok_r(NULL," \t",&save_ptr);
+    if(token_ptr == NULL){//too few fields on this line
+        return mcs_raise(st,MCS_NUM_PARSER);
     }
-    token_ptr = strtok(NULL," \t");
     errno = 0;
     *node_3_ptr = strtoul(token_ptr, &end_ptr, 10);
     if((*node_3_ptr == 0 && errno != 0) || (token_ptr == end_ptr)){
-        mcs_error(MCS_NUM_PARSER);
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    return 0;
+}
+
+int mcs_parse_instance(char* nl_line,
+                       mcs_subckt* defs,
+                       mcs_element* z,
+                       mcs_status* st){
+    char* field[MCS_NETLIST_LINE_LEN/2+1];
+    char* token_ptr = &(nl_line[1]);
+    char* end_ptr = NULL;
+    char* save_ptr = NULL;
+    unsigned long idx = 0;
+    unsigned long* node = NULL;
+    mcs_subckt* S = NULL;
+    long num_field = 0;
+    long p = 0;
+    errno = 0;//reset error number to zero before calling
+    idx = strtoul(token_ptr, &end_ptr, 10);
+    if((idx == 0 && errno != 0) || (token_ptr == end_ptr)){
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    token_ptr = strtok_r(end_ptr,mcs_subckt_sep,&save_ptr);
+    while(token_ptr != NULL){
+        field[num_field] = token_ptr;
+        num_field++;
+        token_ptr = strtok_r(NULL,mcs_subckt_sep,&save_ptr);
+    }
+    if(num_field == 0){//no definition named
+        return mcs_raise(st,MCS_NUM_PARSER);
+    }
+    //the last field names the definition, the others are its nodes.
+    S = mcs_find_subckt(defs,field[num_field-1]);
+    if(S == NULL || S->num_port != num_field-1){
+        return mcs_raise(st,MCS_NETLIST_FMT);
+    }
+    node = (unsigned long*) malloc(sizeof(unsigned long)*(S->num_port+1));
+    for(p=0;p<S->num_port;p++){
+        errno = 0;
+        node[p] = strtoul(field[p], &end_ptr, 10);
+        if((node[p] == 0 && errno != 0) || (field[p] == end_ptr)){
+            free(node);
+            return mcs_raise(st,MCS_NUM_PARSER);
+        }
     }
+    MCS_PROF_COUNT(MCS_PROF_ALLOCS,1);
+    S->refs++;
+    mcs_init_instance(&(z->X),idx,S,node);
+    return 0;
 }
@@ -6,6 +6,18 @@
  * This netlist parser is based on Problem 1.1 on Page 10 of
  * the textbook ``Circuit Simulation'' by Farid N. Najm.
  *
+ * Repeated cells are written once as a subcircuit definition,
+ *      .SUBCKT name p1 p2 ... pk
+ *      (element lines, in local node numbers)
+ *      .ENDS
+ * and placed with instance lines such as
+ *      X3 n1 n2 ... nk name
+ * which connect local node p_i to node n_i. Local node 0 is ground, and
+ * the other local nodes are internal to each instance. A definition may
+ * hold instances of definitions made above it, and is parsed and stored
+ * once however many instances there are. The instance lines share it
+ * through a reference count, and it is freed with its last instance.
+ *
  * Original Draft Dated: 02, Jan 2021
  */
 
@@ -20,12 +32,18 @@
 #include<errno.h>
 #include"../circuit_elements/circuit_elements.h"
 #include"../error_handling/error_handling.h"
+#include"../profiling/profiling.h"
 
 /*
  * No line of a netlist file should be longer than 80 chars.
  */
 #define MCS_NETLIST_LINE_LEN 80
 
+/*
+ * Longest name of a subcircuit definition.
+ */
+#define MCS_SUBCKT_NAME_LEN 32
+
 /*
  * Linked List of Circuit Elements Struct Definition:
  */
@@ -38,6 +56,25 @@ typedef struct _mcs_netlist{
     struct _mcs_netlist* next;
 } mcs_netlist;
 
+/*
+ * A subcircuit definition.
+ */
+typedef struct _mcs_subckt{
+    char name[MCS_SUBCKT_NAME_LEN+1];   /*Name used by instance lines*/
+    long num_port;                      /*Number of ports*/
+    unsigned long* port;                /*Local node of each port*/
+    unsigned long max_node;             /*Largest local node*/
+    long* map;          /*Local node l is internal node map[l] >= 0,
+                          port -map[l]-2, or ground or unused if -1*/
+    long num_internal;                  /*Internal nodes, map[l] >= 0*/
+    long num_dev;       /*Elements of one instance, nested ones included*/
+    long num_node;      /*Internal nodes of one instance, nested included*/
+    mcs_netlist* body;                  /*Elements in local node numbers*/
+    long refs;                          /*Instances which share this*/
+    int mark;                           /*Scratch for mcs_write_netlist*/
+    struct _mcs_subckt* next;           /*Next definition while parsing*/
+} mcs_subckt;
+
 /*
  * Function Declarations:
  */
@@ -49,13 +86,36 @@ typedef struct _mcs_netlist{
  */
 void mcs_read_netlist(const char* filename, mcs_netlist** nl);
 
+/*
+ * Reentrant version of mcs_read_netlist. Lines are read into the caller's
+ * buffer nl_line, which has at least MCS_NETLIST_LINE_LEN+1 chars.
+ *
+ * Returns 0 on success. On an error, returns 1 with the error and line
+ * number recorded in st, and *nl set to NULL. If st is NULL then errors
+ * call mcs_error as in mcs_read_netlist.
+ */
+int mcs_read_netlist_r(const char* filename,
+                       mcs_netlist** nl,
+                       char* nl_line,
+                       mcs_status* st);
+
 /*
  * Write a netlist to a file.
  *
- * 
+ * The definitions of subcircuits with instances in the netlist are
+ * written first, each one once.
  */
 void mcs_write_netlist(char* filename, mcs_netlist* nl);
 
+/*
+ * Reentrant version of mcs_write_netlist, with the same buffer and
+ * status conventions as mcs_read_netlist_r.
+ */
+int mcs_write_netlist_r(char* filename,
+                        mcs_netlist* nl,
+                        char* nl_line,
+                        mcs_status* st);
+
 /*
  * Read the mcs_element struct and output its data to a Cstring.
  * It is assumed that nl_line has at least MCS_NETLIST_LINE_LEN+1 chars
@@ -63,6 +123,12 @@ void mcs_write_netlist(char* filename, mcs_netlist* nl);
  */
 void mcs_print_element(char* nl_line, mcs_element* z);
 
+/*
+ * Version of mcs_print_element which returns 1 and records the error in st
+ * for an unknown device, rather than exiting.
+ */
+int mcs_print_element_r(char* nl_line, mcs_element* z, mcs_status* st);
+
 /*
  * Allocate the memory required to store a netlist linked list element
  * Sets (*nl)->prev and (*nl)->next to NULL.
@@ -74,4 +140,18 @@ void mcs_alloc_netlist(mcs_netlist** nl);
  * Free every element of the Netlist linked list and set all pointers to NULL.
  */
 void mcs_free_netlist(mcs_netlist** nl);
+
+/*
+ * Drop one reference to the subcircuit definition S. It is freed along
+ * with its body once no instance refers to it.
+ */
+void mcs_release_subckt(mcs_subckt* S);
+
+/*
+ * Return the number of nodes of element z. Transistors and two terminal
+ * elements write their nodes into buf, which has 3 entries, and point
+ * *node at buf. Instances point *node at their own list of nodes.
+ */
+long mcs_element_nodes(mcs_element* z, unsigned long* buf,
+                       unsigned long** node);
 #endif
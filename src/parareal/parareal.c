@@ -0,0 +1,250 @@
+/*
+ * Implementation for:
+ * Time parallel transient analysis for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "parareal.h"
+#include <string.h>
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Take num_steps steps of T from the state x0 at time t0, leaving the
+ * final state in x1. If traj is not NULL, step j is stored at
+ * traj[j*dim]. Returns 0, or 1 if a step did not converge.
+ */
+int mcs_para_prop(mcs_tran* T,
+                  double t0,
+                  double* x0,
+                  long num_steps,
+                  double* x1,
+                  double* traj);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+int mcs_para_prop(mcs_tran* T,
+                  double t0,
+                  double* x0,
+                  long num_steps,
+                  double* x1,
+                  double* traj){
+    long dim = T->M->dim;
+    long j;
+    T->t = t0;
+    memcpy(T->x,x0,sizeof(double)*dim);
+    for(j=0;j<num_steps;j++){
+        if(mcs_tran_step(T) < 0){
+            return 1;
+        }
+        if(traj != NULL){
+            memcpy(&(traj[j*dim]),T->x,sizeof(double)*dim);
+        }
+    }
+    memcpy(x1,T->x,sizeof(double)*dim);
+    return 0;
+}
+
+void mcs_alloc_para(mcs_para** P,
+                    mcs_mna* M,
+                    double h,
+                    double t_stop,
+                    long num_slice,
+                    double* x0){
+    mcs_para* R;
+    long i, len;
+    R = (mcs_para*) malloc(sizeof(mcs_para));
+    R->M = M;
+    R->h = h;
+    R->num_slice = (num_slice > 0) ? num_slice : 1;
+    R->num_fine = lround(t_stop/(R->num_slice*h));
+    if(R->num_fine < 1){
+        R->num_fine = 1;
+    }
+    R->num_coarse = MCS_PARA_COARSE;
+    R->tol = MCS_PARA_TOL;
+    R->coarse_tol = MCS_PARA_COARSE_TOL;
+    R->max_iter = R->num_slice;
+    R->wave = NULL;
+    R->wave_data = NULL;
+    len = (R->num_slice+1)*M->dim;
+    R->U = (double*) malloc(sizeof(double)*(len+1));
+    R->G = (double*) malloc(sizeof(double)*(len+1));
+    R->F = (double*) malloc(sizeof(double)*(len+1));
+    R->x = (double*) malloc(sizeof(double)*(M->dim+1));
+    for(i=0;i<M->dim;i++){
+        R->U[i] = (x0 == NULL) ? 0.0 : x0[i];
+        R->x[i] = R->U[i];
+    }
+    R->num_iter = 0;
+    R->num_steps = 0;
+    *P = R;
+}
+
+void mcs_free_para(mcs_para** P){
+    free((*P)->x);
+    free((*P)->F);
+    free((*P)->G);
+    free((*P)->U);
+    free(*P);
+    *P = NULL;
+}
+
+void mcs_para_set_wave(mcs_para* P, mcs_source_wave wave, void* data){
+    P->wave = wave;
+    P->wave_data = data;
+}
+
+long mcs_para_run(mcs_para* P, mcs_wave* W){
+    mcs_mna* M = P->M;
+    mcs_tran* Gc;
+    long dim = M->dim;
+    long S = P->num_slice;
+    double T_sl = P->num_fine*P->h;     //length of a slice
+    double H = T_sl/P->num_coarse;      //coarse step
+    double* U = P->U;
+    double* Gv = P->G;
+    double* Fv = P->F;
+    double* buf = NULL;
+    double* g;
+    long first = 0;     //boundaries up to U_first are exact
+    long batch = 0;
+    long num_fail = 0;
+    long num_steps = 0;
+    long num_singular = 0;
+    long n, i, j;
+    int done = 0;
+    double d;
+    mcs_status st;
+    mcs_status_init(&st);
+    if(mcs_alloc_tran(&Gc,M,H,U,&st)){
+        return -1;
+    }
+    mcs_tran_set_wave(Gc,P->wave,P->wave_data);
+    Gc->tol = P->coarse_tol;
+    g = (double*) malloc(sizeof(double)*(dim+1));
+    //coarse sweep for the first boundaries
+    for(n=0;n<S && !num_fail;n++){
+        num_fail += mcs_para_prop(Gc,n*T_sl,&(U[n*dim]),P->num_coarse,
+                                  &(Gv[(n+1)*dim]),NULL);
+        memcpy(&(U[(n+1)*dim]),&(Gv[(n+1)*dim]),sizeof(double)*dim);
+    }
+    P->num_iter = 0;
+    done = (num_fail > 0);
+    if(W != NULL){
+        //slices whose fine steps fit in MCS_PARA_WRITE_MEM bytes
+        batch = MCS_PARA_WRITE_MEM/(sizeof(double)*P->num_fine*dim);
+        batch = (batch < 1) ? 1 : ((batch > S) ? S : batch);
+        buf = (double*) malloc(sizeof(double)*(batch*P->num_fine*dim+1));
+    }
+    #pragma omp parallel private(n,i,j,d)
+    {
+        mcs_tran* Fn;
+        mcs_status st_fine;
+        long b0, b1;
+        mcs_status_init(&st_fine);
+        if(mcs_alloc_tran(&Fn,M,P->h,U,&st_fine)){
+            #pragma omp atomic
+            num_singular++;
+        }else{
+            mcs_tran_set_wave(Fn,P->wave,P->wave_data);
+        }
+        //every thread has to see a failed fine step matrix before the loop
+        #pragma omp barrier
+        #pragma omp single
+        {
+            if(num_singular > 0){
+                num_fail++;
+                done = 1;
+            }
+        }
+        while(!done){
+            //fine sweep of every slice which is not exact yet
+            #pragma omp for schedule(dynamic) reduction(+:num_fail,num_steps)
+            for(n=first;n<S;n++){
+                num_fail += mcs_para_prop(Fn,n*T_sl,&(U[n*dim]),
+                                          P->num_fine,&(Fv[(n+1)*dim]),NULL);
+                num_steps += P->num_fine;
+            }
+            #pragma omp single
+            {
+                P->num_iter++;
+                done = (num_fail > 0);
+                //U_first is exact, so the next boundary is its fine value
+                d = 0.0;
+                for(i=0;i<dim;i++){
+                    j = (first+1)*dim+i;
+                    d = fmax(d,fabs(Fv[j]-U[j])/(1.0+fabs(Fv[j])));
+                    U[j] = Fv[j];
+                }
+                for(n=first+1;n<S && !done;n++){
+                    if(mcs_para_prop(Gc,n*T_sl,&(U[n*dim]),P->num_coarse,
+                                     g,NULL)){
+                        num_fail++;
+                        done = 1;
+                        break;
+                    }
+                    for(i=0;i<dim;i++){
+                        j = (n+1)*dim+i;
+                        Fv[j] = g[i] + Fv[j] - Gv[j];
+                        Gv[j] = g[i];
+                        d = fmax(d,fabs(Fv[j]-U[j])/(1.0+fabs(Fv[j])));
+                        U[j] = Fv[j];
+                    }
+                }
+                first++;
+                if(d <= P->tol || first >= S || P->num_iter >= P->max_iter){
+                    done = 1;
+                }
+            }
+        }
+        //one more fine sweep from the converged boundaries for W
+        for(b0=0;W != NULL && !num_fail && b0<S;b0+=batch){
+            b1 = (b0+batch < S) ? b0+batch : S;
+            #pragma omp for schedule(dynamic) reduction(+:num_fail,num_steps)
+            for(n=b0;n<b1;n++){
+                num_fail += mcs_para_prop(Fn,n*T_sl,&(U[n*dim]),
+                                  P->num_fine,&(Fv[(n+1)*dim]),
+                                  &(buf[(n-b0)*P->num_fine*dim]));
+                num_steps += P->num_fine;
+            }
+            #pragma omp single
+            {
+                if(b0 == 0){
+                    mcs_wave_write(W,0.0,U);
+                }
+                for(n=b0;n<b1 && !num_fail;n++){
+                    for(j=0;j<P->num_fine;j++){
+                        mcs_wave_write(W,(n*P->num_fine+j+1)*P->h,
+                                   &(buf[((n-b0)*P->num_fine+j)*dim]));
+                    }
+                }
+            }
+        }
+        if(Fn != NULL){
+            mcs_free_tran(&Fn);
+        }
+    }
+    P->num_steps = num_steps;
+    memcpy(P->x,(W != NULL) ? &(Fv[S*dim]) : &(U[S*dim]),
+           sizeof(double)*dim);
+    if(buf != NULL){
+        free(buf);
+    }
+    free(g);
+    mcs_free_tran(&Gc);
+    if(num_fail > 0){
+        return -1;
+    }
+    return P->num_iter;
+}
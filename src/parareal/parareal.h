@@ -0,0 +1,121 @@
+#ifndef MCS_PARAREAL_H
+#define MCS_PARAREAL_H
+
+/*
+ * Time parallel transient analysis for MicroCircSim by Bram Rodgers.
+ * Based on ``Resolution d'EDP par un schema en temps parareel''
+ * by J.-L. Lions, Y. Maday, and G. Turinici.
+ *
+ * The window [0, t_stop] is cut into slices with boundary states U_n.
+ * A coarse propagator G takes a few large backward Euler steps with a
+ * relaxed Newton tolerance across one slice, and the fine propagator F
+ * takes the steps of length h which mcs_tran_run would take. Starting
+ * from a coarse sweep U_(n+1) = G(U_n), each iteration runs F on every
+ * slice at once, one slice per OpenMP thread, then corrects the
+ * boundaries in order with
+ *      U_(n+1) = G(U_n) + F(U_n_old) - G(U_n_old),
+ * which only costs coarse steps. Iteration k makes slice k exact, so
+ * the slices before it are not integrated again, and the iterations stop
+ * once no boundary moves by more than tol*(1+|U_n[i]|).
+ *
+ * The result is the serial fine solution to within tol. It costs about
+ * (iterations)*(fine steps)/(slices) time steps of wall clock time, so it
+ * pays when few iterations are needed and there are idle cores, as with
+ * long transients of moderate sized circuits.
+ *
+ * Every thread has its own mcs_tran, so source waveforms are called from
+ * several threads at once and must not change shared state.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../mna_system/mna_system.h"
+#include"../transient_analysis/transient_analysis.h"
+#include"../waveform_writer/waveform_writer.h"
+
+/*
+ * Defaults of a parareal analysis.
+ */
+#define MCS_PARA_TOL        1.0e-6  /*Change of the boundaries to stop at*/
+#define MCS_PARA_COARSE_TOL 1.0e-5  /*Newton tolerance of coarse steps*/
+#define MCS_PARA_COARSE     1       /*Coarse steps per slice*/
+
+/*
+ * Bytes of fine steps held for writing at once by mcs_para_run.
+ */
+#define MCS_PARA_WRITE_MEM  (1L << 28)
+
+/*
+ * Object and Struct Definitions:
+ */
+
+typedef struct _mcs_para{
+    mcs_mna* M;                 /*The circuit being simulated*/
+    double h;                   /*Fine time step*/
+    long num_slice;             /*Number of time slices*/
+    long num_fine;              /*Fine steps per slice*/
+    long num_coarse;            /*Coarse steps per slice*/
+    double tol;                 /*Change of the boundaries to stop at*/
+    double coarse_tol;          /*Newton tolerance of coarse steps*/
+    long max_iter;              /*Parareal iteration limit*/
+    mcs_source_wave wave;       /*Source waveforms, or NULL*/
+    void* wave_data;            /*Passed to wave*/
+    double* U;                  /*Slice boundaries, (num_slice+1)*M->dim*/
+    double* G;                  /*Coarse propagation of each slice*/
+    double* F;                  /*Fine propagation of each slice*/
+    double* x;                  /*Solution at the end of the window*/
+    long num_iter;              /*Parareal iterations of the last run*/
+    long num_steps;             /*Fine steps of the last run, all threads*/
+} mcs_para;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Set up a parareal analysis of M from the state x0 at time 0 to t_stop,
+ * with num_slice slices and fine step h. If x0 is NULL the circuit
+ * starts from x = 0. Each slice gets the whole number of fine steps
+ * closest to t_stop/(num_slice*h), at least 1, so the window ends at
+ * num_slice*num_fine*h. Tolerances and step counts are the defaults above
+ * and may be changed in the struct before running.
+ */
+void mcs_alloc_para(mcs_para** P,
+                    mcs_mna* M,
+                    double h,
+                    double t_stop,
+                    long num_slice,
+                    double* x0);
+
+/*
+ * Free a parareal analysis. The circuit is not freed.
+ */
+void mcs_free_para(mcs_para** P);
+
+/*
+ * Use the waveform function wave for all sources, as in
+ * mcs_tran_set_wave.
+ */
+void mcs_para_set_wave(mcs_para* P, mcs_source_wave wave, void* data);
+
+/*
+ * Integrate the window, leaving the final state in P->x. If W is not NULL,
+ * the starting point and every fine step are written to W, which takes
+ * one more fine sweep of every slice from the converged boundaries.
+ *
+ * Returns the number of parareal iterations, or -1 if a time step did not
+ * converge or the coarse or fine step matrix is singular. Stops after
+ * max_iter iterations even if the boundaries still move.
+ */
+long mcs_para_run(mcs_para* P, mcs_wave* W);
+
+#endif
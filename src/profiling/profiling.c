@@ -0,0 +1,130 @@
+/*
+ * Implementation for:
+ * Phase timers and event counters for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "profiling.h"
+#include <time.h>
+#include <sys/resource.h>
+
+/*
+ * Locally used helper functions:
+ */
+
+void mcs_prof_register();
+void mcs_prof_at_exit();
+
+/*
+ * Static Local Variables:
+ */
+
+static const char* mcs_prof_phase_name[MCS_PROF_NUM_PHASE] = {
+    "parse", "assemble", "spmatvec", "bicgstab",
+    "lu_analyze", "lu_factor", "lu_solve"
+};
+
+static const char* mcs_prof_counter_name[MCS_PROF_NUM_COUNTER] = {
+    "matvecs", "dots", "iters", "allocs", "bytes_read"
+};
+
+static long mcs_prof_calls[MCS_PROF_NUM_PHASE];
+static double mcs_prof_seconds[MCS_PROF_NUM_PHASE];
+static long mcs_prof_counts[MCS_PROF_NUM_COUNTER];
+static int mcs_prof_registered = 0;
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Register mcs_prof_at_exit with atexit, once.
+ */
+void mcs_prof_register(){
+    int done;
+    //other threads may set the flag, so it is only read atomically
+    #pragma omp atomic read
+    done = mcs_prof_registered;
+    if(done){
+        return;
+    }
+    #pragma omp critical(mcs_prof_register)
+    {
+        if(!mcs_prof_registered){
+            atexit(&mcs_prof_at_exit);
+            #pragma omp atomic write
+            mcs_prof_registered = 1;
+        }
+    }
+}
+
+/*
+ * Write the totals to the file named by MCS_PROFILE_FILE, or stderr.
+ */
+void mcs_prof_at_exit(){
+    char* filename = getenv("MCS_PROFILE_FILE");
+    FILE* out = NULL;
+    if(filename != NULL){
+        out = fopen(filename,"w");
+    }
+    if(out == NULL){
+        mcs_prof_dump(stderr);
+        return;
+    }
+    mcs_prof_dump(out);
+    fclose(out);
+}
+
+double mcs_prof_now(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return ((double) ts.tv_sec) + 1.0e-9*((double) ts.tv_nsec);
+}
+
+void mcs_prof_add_time(enum MCS_PROF_PHASE phase, double seconds){
+    mcs_prof_register();
+    #pragma omp atomic
+    mcs_prof_calls[phase]++;
+    #pragma omp atomic
+    mcs_prof_seconds[phase] += seconds;
+}
+
+void mcs_prof_add_count(enum MCS_PROF_COUNTER counter, long n){
+    mcs_prof_register();
+    #pragma omp atomic
+    mcs_prof_counts[counter] += n;
+}
+
+void mcs_prof_dump(FILE* out){
+    struct rusage ru;
+    long k;
+    getrusage(RUSAGE_SELF,&ru);
+    fprintf(out,"{\"phases\": {");
+    for(k=0;k<MCS_PROF_NUM_PHASE;k++){
+        fprintf(out,"%s\"%s\": {\"calls\": %ld, \"seconds\": %.6e}",
+                (k > 0) ? ", " : "",mcs_prof_phase_name[k],
+                mcs_prof_calls[k],mcs_prof_seconds[k]);
+    }
+    fprintf(out,"}, \"counters\": {");
+    for(k=0;k<MCS_PROF_NUM_COUNTER;k++){
+        fprintf(out,"%s\"%s\": %ld",(k > 0) ? ", " : "",
+                mcs_prof_counter_name[k],mcs_prof_counts[k]);
+    }
+    //ru_maxrss is in kilobytes on Linux
+    fprintf(out,"}, \"peak_rss_kb\": %ld}\n",(long) ru.ru_maxrss);
+    fflush(out);
+}
+
+void mcs_prof_reset(){
+    long k;
+    for(k=0;k<MCS_PROF_NUM_PHASE;k++){
+        mcs_prof_calls[k] = 0;
+        mcs_prof_seconds[k] = 0.0;
+    }
+    for(k=0;k<MCS_PROF_NUM_COUNTER;k++){
+        mcs_prof_counts[k] = 0;
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef MCS_PROFILING_H
+#define MCS_PROFILING_H
+
+/*
+ * Phase timers and event counters for MicroCircSim by Bram Rodgers.
+ *
+ * The library is instrumented with the macros below. They expand to
+ * nothing unless MCS_PROFILE is defined when compiling, so a normal
+ * build carries no profiling code at all. To profile, rebuild with
+ *      make clean; make arch PROF=-DMCS_PROFILE
+ *
+ * With profiling on, the totals are written as JSON when the program
+ * exits. They go to the file named by the environment variable
+ * MCS_PROFILE_FILE, or to stderr if it is not set. The JSON holds the
+ * number of calls and the seconds spent in each phase, every counter,
+ * and the peak resident memory of the process.
+ *
+ * Totals are shared by all threads and updated atomically. Phases which
+ * run on several threads at once add up the time of every thread.
+ * Phases may nest, for example bicgstab time includes its spmatvec time.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include<stdio.h>
+
+/*
+ * Timed phases of a simulation.
+ */
+enum MCS_PROF_PHASE{
+    MCS_PROF_PARSE          =  0,   /*mcs_read_netlist*/
+    MCS_PROF_ASSEMBLE       =  1,   /*Writing the MNA matrices*/
+    MCS_PROF_SPMATVEC       =  2,   /*Sparse matrix vector products*/
+    MCS_PROF_BICGSTAB       =  3,   /*Iterative solves*/
+    MCS_PROF_LU_ANALYZE     =  4,   /*Symbolic LU analysis*/
+    MCS_PROF_LU_FACTOR      =  5,   /*Numeric LU factorization*/
+    MCS_PROF_LU_SOLVE       =  6,   /*Triangular solves*/
+    MCS_PROF_NUM_PHASE      =  7
+};
+
+/*
+ * Counted events.
+ */
+enum MCS_PROF_COUNTER{
+    MCS_PROF_MATVECS        =  0,   /*Sparse matrix vector products*/
+    MCS_PROF_DOTS           =  1,   /*Vector dot products*/
+    MCS_PROF_ITERS          =  2,   /*Iterative solver iterations*/
+    MCS_PROF_ALLOCS         =  3,   /*Calls to malloc by alloc functions*/
+    MCS_PROF_BYTES_READ     =  4,   /*Bytes of netlist text read*/
+    MCS_PROF_NUM_COUNTER    =  5
+};
+
+#ifdef MCS_PROFILE
+/*
+ * Declare the timer t and start it.
+ */
+#define MCS_PROF_START(t) double t = mcs_prof_now()
+/*
+ * Add the time since MCS_PROF_START(t) to phase.
+ */
+#define MCS_PROF_STOP(phase,t) mcs_prof_add_time((phase),mcs_prof_now()-(t))
+/*
+ * Add n to counter.
+ */
+#define MCS_PROF_COUNT(counter,n) mcs_prof_add_count((counter),(long) (n))
+#else
+#define MCS_PROF_START(t)
+#define MCS_PROF_STOP(phase,t)
+#define MCS_PROF_COUNT(counter,n)
+#endif
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Seconds on a monotonic clock.
+ */
+double mcs_prof_now();
+
+/*
+ * Add one call taking the given seconds to phase. The first call also
+ * arranges for the totals to be written when the program exits.
+ */
+void mcs_prof_add_time(enum MCS_PROF_PHASE phase, double seconds);
+
+/*
+ * Add n to counter.
+ */
+void mcs_prof_add_count(enum MCS_PROF_COUNTER counter, long n);
+
+/*
+ * Write the totals so far to out as one JSON object.
+ */
+void mcs_prof_dump(FILE* out);
+
+/*
+ * Set every total to zero.
+ */
+void mcs_prof_reset();
+
+#endif
@@ -0,0 +1,288 @@
+/*
+ * Implementation for:
+ * Periodic steady state analysis for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "pss_analysis.h"
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Return the factors of G_k + C/h for step k.
+ */
+mcs_splu_numeric* mcs_pss_lu(mcs_pss* P, long k);
+
+/*
+ * Factor P->T->A into the factors of step k. If the shared pivot order
+ * is unstable for these values, step k gets its own symbolic analysis.
+ * Returns 0, or 1 if A is singular.
+ */
+int mcs_pss_factor(mcs_pss* P, long k);
+
+/*
+ * Integrate one period from P->x0, storing every state and the factors
+ * of every step. Autonomous circuits also get P->dphi.
+ * Returns 0 on success, or 1 if a step did not converge or could not be
+ * factored.
+ */
+int mcs_pss_period(mcs_pss* P);
+
+/*
+ * Linear map of the Newton update, w = (M - I)*v. For autonomous
+ * circuits v and w have one more entry, for the period, and the last row
+ * is the phase condition.
+ */
+void mcs_pss_apply(void* data, double* v, double* w);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+mcs_splu_numeric* mcs_pss_lu(mcs_pss* P, long k){
+    if(P->T->linear){
+        return P->T->N;
+    }
+    return P->F[k];
+}
+
+int mcs_pss_factor(mcs_pss* P, long k){
+    mcs_spmat* A = P->T->A;
+    mcs_splu_symbolic* S = (P->S_own[k] != NULL) ? P->S_own[k] : P->S;
+    if(P->F[k] == NULL){
+        mcs_alloc_splu(S,&(P->F[k]));
+    }
+    if(mcs_splu_factor(P->F[k],A->dat) == 0){
+        return 0;
+    }
+    mcs_free_splu(&(P->F[k]));
+    P->F[k] = NULL;
+    if(P->S_own[k] != NULL){
+        mcs_free_splu_symbolic(&(P->S_own[k]));
+    }
+    if(mcs_splu_analyze_r(A,&(P->S_own[k]))){
+        return 1;
+    }
+    mcs_alloc_splu(P->S_own[k],&(P->F[k]));
+    return mcs_splu_factor(P->F[k],A->dat);
+}
+
+int mcs_pss_period(mcs_pss* P){
+    mcs_tran* T = P->T;
+    long dim = P->M->dim;
+    long i, k;
+    double* x_prev;
+    T->t = 0.0;
+    for(i=0;i<dim;i++){
+        T->x[i] = P->x0[i];
+    }
+    for(k=0;k<P->num_steps;k++){
+        if(mcs_tran_step(T) < 0){
+            return 1;
+        }
+        for(i=0;i<dim;i++){
+            P->traj[k*dim+i] = T->x[i];
+        }
+        if(!T->linear){
+            mcs_tran_linearize(T);
+            if(mcs_pss_factor(P,k)){
+                return 1;
+            }
+        }
+    }
+    if(!P->autonomous){
+        return 0;
+    }
+    //with h = period/num_steps, step k is differentiated by h as
+    //(G_k + C/h)*s_(k+1) = (C/h)*(s_k + (x_(k+1) - x_k)/h)
+    for(i=0;i<dim;i++){
+        P->y[i] = 0.0;
+    }
+    for(k=0;k<P->num_steps;k++){
+        x_prev = (k == 0) ? P->x0 : &(P->traj[(k-1)*dim]);
+        for(i=0;i<dim;i++){
+            P->z[i] = P->y[i] + (P->traj[k*dim+i] - x_prev[i])/T->h;
+        }
+        mcs_spmv_apply(T->Cv,P->z,P->y);
+        mcs_splu_solve(mcs_pss_lu(P,k),P->y,P->y);
+    }
+    for(i=0;i<dim;i++){
+        P->dphi[i] = P->y[i]/P->num_steps;
+    }
+    return 0;
+}
+
+void mcs_pss_apply(void* data, double* v, double* w){
+    mcs_pss* P = (mcs_pss*) data;
+    long dim = P->M->dim;
+    long i, k;
+    for(i=0;i<dim;i++){
+        P->y[i] = v[i];
+    }
+    for(k=0;k<P->num_steps;k++){
+        mcs_spmv_apply(P->T->Cv,P->y,P->z);
+        mcs_splu_solve(mcs_pss_lu(P,k),P->z,P->y);
+    }
+    for(i=0;i<dim;i++){
+        w[i] = P->y[i] - v[i];
+    }
+    if(P->autonomous){
+        for(i=0;i<dim;i++){
+            w[i] += v[dim]*P->dphi[i];
+        }
+        w[dim] = v[P->phase];
+    }
+    P->num_matvec++;
+}
+
+int mcs_alloc_pss(mcs_pss** P, mcs_mna* M, double period, long num_steps,
+                  double* x0, mcs_status* st){
+    mcs_pss* R;
+    long i, dim = M->dim;
+    R = (mcs_pss*) malloc(sizeof(mcs_pss));
+    R->M = M;
+    R->num_steps = num_steps;
+    R->period = period;
+    R->autonomous = 0;
+    R->phase = 0;
+    R->tol = MCS_PSS_TOL;
+    R->max_iter = MCS_PSS_MAX_ITER;
+    R->num_iter = 0;
+    R->num_matvec = 0;
+    R->x0 = (double*) malloc(sizeof(double)*(dim+1));
+    for(i=0;i<dim;i++){
+        R->x0[i] = (x0 == NULL) ? 0.0 : x0[i];
+    }
+    *P = NULL;
+    if(mcs_alloc_tran(&(R->T),M,period/num_steps,R->x0,st)){
+        free(R->x0);
+        free(R);
+        return 1;
+    }
+    R->traj = (double*) malloc(sizeof(double)*(num_steps*dim+1));
+    R->S = NULL;
+    R->S_own = (mcs_splu_symbolic**)
+               calloc(num_steps+1,sizeof(mcs_splu_symbolic*));
+    R->F = (mcs_splu_numeric**) calloc(num_steps+1,sizeof(mcs_splu_numeric*));
+    R->dphi = (double*) malloc(sizeof(double)*(dim+1));
+    R->r = (double*) malloc(sizeof(double)*(dim+2));
+    R->dx = (double*) malloc(sizeof(double)*(dim+2));
+    R->y = (double*) malloc(sizeof(double)*(dim+1));
+    R->z = (double*) malloc(sizeof(double)*(dim+1));
+    R->work = (double*) malloc(sizeof(double)*(6*(dim+1)+1));
+    if(!R->T->linear && mcs_splu_analyze_r(R->T->A,&(R->S))){
+        mcs_free_pss(&R);
+        return mcs_raise(st,MCS_SINGULAR_MATRIX);
+    }
+    *P = R;
+    return 0;
+}
+
+void mcs_free_pss(mcs_pss** P){
+    long k;
+    for(k=0;k<(*P)->num_steps;k++){
+        if((*P)->F[k] != NULL){
+            mcs_free_splu(&((*P)->F[k]));
+        }
+        if((*P)->S_own[k] != NULL){
+            mcs_free_splu_symbolic(&((*P)->S_own[k]));
+        }
+    }
+    if((*P)->S != NULL){
+        mcs_free_splu_symbolic(&((*P)->S));
+    }
+    free((*P)->F);
+    free((*P)->S_own);
+    free((*P)->work);
+    free((*P)->z);
+    free((*P)->y);
+    free((*P)->dx);
+    free((*P)->r);
+    free((*P)->dphi);
+    free((*P)->traj);
+    mcs_free_tran(&((*P)->T));
+    free((*P)->x0);
+    free(*P);
+    *P = NULL;
+}
+
+void mcs_pss_autonomous(mcs_pss* P, long phase){
+    P->autonomous = 1;
+    P->phase = phase;
+}
+
+long mcs_pss_solve(mcs_pss* P){
+    long dim = P->M->dim;
+    long n = dim + P->autonomous;
+    long i, iter;
+    double nr, tau;
+    double* x_end = &(P->traj[(P->num_steps-1)*dim]);
+    int converged;
+    P->num_matvec = 0;
+    for(iter=0;iter<=P->max_iter;iter++){
+        P->num_iter = iter;
+        if(mcs_pss_period(P)){
+            return -1;
+        }
+        //the right hand side of the Newton step is x0 - phi(x0)
+        converged = 1;
+        nr = 0.0;
+        for(i=0;i<dim;i++){
+            P->r[i] = P->x0[i] - x_end[i];
+            if(fabs(P->r[i]) > P->tol*(1.0+fabs(x_end[i]))){
+                converged = 0;
+            }
+            nr += P->r[i]*P->r[i];
+        }
+        if(converged){
+            return iter;
+        }
+        if(iter == P->max_iter){
+            break;
+        }
+        if(P->autonomous){
+            P->r[dim] = 0.0;
+        }
+        for(i=0;i<n;i++){
+            P->dx[i] = 0.0;
+        }
+        mcs_bicgstab_r(&mcs_pss_apply,P,P->r,P->dx,P->work,n,
+                       MCS_PSS_KRYLOV_RED*sqrt(nr/n),MCS_PSS_KRYLOV_ITER);
+        for(i=0;i<n;i++){
+            if(!isfinite(P->dx[i])){
+                return -1;
+            }
+        }
+        for(i=0;i<dim;i++){
+            P->x0[i] += P->dx[i];
+        }
+        if(P->autonomous){
+            //keep the period within a factor of 2 per iteration
+            tau = P->dx[dim];
+            if(tau > P->period){
+                tau = P->period;
+            }else if(tau < -0.5*P->period){
+                tau = -0.5*P->period;
+            }
+            P->period += tau;
+            mcs_tran_set_step(P->T,P->period/P->num_steps);
+        }
+    }
+    return -1;
+}
+
+void mcs_pss_write(mcs_pss* P, mcs_wave* W){
+    long k, dim = P->M->dim;
+    mcs_wave_write(W,0.0,P->x0);
+    for(k=0;k<P->num_steps;k++){
+        mcs_wave_write(W,(k+1)*P->T->h,&(P->traj[k*dim]));
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef MCS_PSS_ANALYSIS_H
+#define MCS_PSS_ANALYSIS_H
+
+/*
+ * Periodic steady state analysis for MicroCircSim by Bram Rodgers.
+ * Based on the shooting Newton method of Aprille and Trick, with
+ * matrix free Krylov solves as in Telichevesky, Kundert, and White.
+ *
+ * Let phi(x0) be the state after one period of the transient analysis
+ * started from x0. The periodic steady state is the root of
+ *      phi(x0) - x0 = 0,
+ * which is found with Newton's method. The Jacobian is M - I, where the
+ * monodromy matrix M = d(phi)/d(x0) is the product over the time steps of
+ *      (G_k + C/h)^(-1)*(C/h),
+ * with G_k linearized at the end of step k. M is never formed. The factors
+ * of every step are kept while a period is integrated, and the Newton
+ * update is solved with mcs_bicgstab_r, where each product with M is one
+ * sparse product and one pair of triangular solves per time step.
+ *
+ * A driven circuit has the period of its sources, which are given to
+ * the transient analysis in P->T with mcs_tran_set_wave. An autonomous
+ * circuit such as an oscillator has an unknown period, which is then
+ * solved for along with x0. The phase condition holds one unknown of x0
+ * fixed, and x0 should start near the orbit, such as at the end of a short
+ * transient, since the DC operating point is also a periodic solution.
+ *
+ * A few Newton iterations each cost about one period of simulation plus
+ * the Krylov solve, instead of the many periods needed for transients to
+ * die out.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../mna_system/mna_system.h"
+#include"../sparse_lu/sparse_lu.h"
+#include"../transient_analysis/transient_analysis.h"
+#include"../waveform_writer/waveform_writer.h"
+
+/*
+ * Default relative tolerance of the periodicity condition and iteration
+ * limit of the shooting Newton method.
+ */
+#define MCS_PSS_TOL         1.0e-6
+#define MCS_PSS_MAX_ITER    30
+
+/*
+ * Each Krylov solve reduces the RMS residual of the Newton step by this
+ * factor, in at most MCS_PSS_KRYLOV_ITER iterations.
+ */
+#define MCS_PSS_KRYLOV_RED  1.0e-3
+#define MCS_PSS_KRYLOV_ITER 200
+
+/*
+ * Object and Struct Definitions:
+ */
+
+typedef struct _mcs_pss{
+    mcs_mna* M;                 /*The circuit*/
+    mcs_tran* T;                /*Transient analysis of one period*/
+    long num_steps;             /*Time steps per period*/
+    double period;              /*Length of the period*/
+    int autonomous;             /*1 if the period is an unknown*/
+    long phase;                 /*Unknown of x0 held by the phase condition*/
+    double* x0;                 /*Initial state of the period*/
+    double* traj;               /*State after each step, num_steps by dim*/
+    mcs_splu_symbolic* S;       /*Symbolic analysis shared by the factors*/
+    mcs_splu_symbolic** S_own;  /*Analysis of step k where S is unstable*/
+    mcs_splu_numeric** F;       /*Factors of G_k + C/h of each step*/
+    double* dphi;               /*d(phi)/d(period) of autonomous circuits*/
+    double* r;                  /*Newton residual, dim+1 entries*/
+    double* dx;                 /*Newton update, dim+1 entries*/
+    double* y;                  /*Monodromy product workspace*/
+    double* z;                  /*Monodromy product workspace*/
+    double* work;               /*mcs_bicgstab_r workspace*/
+    double tol;                 /*Relative tolerance of phi(x0) = x0*/
+    long max_iter;              /*Shooting Newton iteration limit*/
+    long num_iter;              /*Newton iterations of the last solve*/
+    long num_matvec;            /*Products with M of the last solve*/
+} mcs_pss;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Set up a periodic steady state analysis of M with the given period,
+ * integrated in num_steps backward Euler steps. The first guess of the
+ * initial state is x0, or x = 0 if x0 is NULL.
+ *
+ * Returns 0. If the step matrix at x0 has no pivot order, then returns 1
+ * with *P set to NULL after recording MCS_SINGULAR_MATRIX in st. If st is
+ * NULL then mcs_error is called instead.
+ */
+int mcs_alloc_pss(mcs_pss** P, mcs_mna* M, double period, long num_steps,
+                  double* x0, mcs_status* st);
+
+/*
+ * Free a periodic steady state analysis. The circuit is not freed.
+ */
+void mcs_free_pss(mcs_pss** P);
+
+/*
+ * Treat the circuit as autonomous, solving for the period as well as the
+ * initial state. Unknown phase of x0 is held at its current value.
+ */
+void mcs_pss_autonomous(mcs_pss* P, long phase);
+
+/*
+ * Solve for the periodic steady state, leaving the initial state in
+ * P->x0 and the period in P->period. Returns the number of shooting
+ * Newton iterations, or -1 if the method did not converge or a time step
+ * failed.
+ */
+long mcs_pss_solve(mcs_pss* P);
+
+/*
+ * Write the last period which was integrated to W, from time 0 to
+ * P->period. After mcs_pss_solve succeeds this is the steady state.
+ */
+void mcs_pss_write(mcs_pss* P, mcs_wave* W);
+
+#endif
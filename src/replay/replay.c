@@ -0,0 +1,254 @@
+/*
+ * Implementation for:
+ * Solver replay driver for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "replay.h"
+#include<string.h>
+
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Linear map of mcs_bicgstab_r for the sparse matrix data.
+ */
+void mcs_replay_apply(void* data, double* v, double* w);
+
+/*
+ * Write the name of the right hand side file of the Matrix Market
+ * matrix file filename into rhs, which has FILENAME_MAX characters.
+ */
+void mcs_replay_rhs_name(const char* filename, char* rhs);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+void mcs_replay_apply(void* data, double* v, double* w){
+    mcs_spmatvec('n',(mcs_spmat*) data,v,w);
+}
+
+void mcs_replay_rhs_name(const char* filename, char* rhs){
+    const char* dot = strrchr(filename,'.');
+    const char* slash = strrchr(filename,'/');
+    int len = (int) strlen(filename);
+    if(dot != NULL && (slash == NULL || dot > slash)){
+        len = (int) (dot - filename);
+    }else{
+        dot = "";
+    }
+    snprintf(rhs,FILENAME_MAX,"%.*s_b%s",len,filename,dot);
+}
+
+int mcs_replay_load(const char* filename, mcs_replay_sys* R,
+                    mcs_status* st){
+    char rhs[FILENAME_MAX];
+    size_t len = strlen(filename);
+    mcs_status st_b;
+    double* ones;
+    long i, n;
+    R->map = NULL;
+    R->A = NULL;
+    R->b = NULL;
+    if(len >= 4 && strcmp(&(filename[len-4]),".bin") == 0){
+        if(mcs_sys_map_bin(filename,&(R->map),st)){
+            return 1;
+        }
+        R->A = &(R->map->A);
+        R->b = R->map->b;
+    }else{
+        if(mcs_spmat_read_mm(filename,&(R->A),st)){
+            return 1;
+        }
+        mcs_replay_rhs_name(filename,rhs);
+        mcs_status_init(&st_b);
+        if(mcs_vec_read_mm(rhs,&(R->b),&n,&st_b) == 0
+           && n != R->A->r_len){
+            free(R->b);
+            R->b = NULL;
+            mcs_raise(&st_b,MCS_MATRIX_FMT);
+        }
+        if(st_b.failed && st_b.err != FILE_READ_ONLY){
+            mcs_free_spmat(&(R->A));
+            return mcs_raise(st,st_b.err);
+        }
+    }
+    if(R->b == NULL){
+        //no right hand side was saved, so use one with a known solution
+        ones = (double*) malloc(sizeof(double)*(R->A->c_len+1));
+        R->b = (double*) malloc(sizeof(double)*(R->A->r_len+1));
+        for(i=0;i<R->A->c_len;i++){
+            ones[i] = 1.0;
+        }
+        mcs_spmatvec('n',R->A,ones,R->b);
+        free(ones);
+    }
+    return 0;
+}
+
+void mcs_replay_free(mcs_replay_sys* R){
+    if(R->map != NULL){
+        if(R->b != R->map->b){
+            free(R->b);
+        }
+        mcs_sys_unmap(&(R->map));
+    }else{
+        free(R->b);
+        mcs_free_spmat(&(R->A));
+    }
+    R->A = NULL;
+    R->b = NULL;
+}
+
+void mcs_replay_run(FILE* out, const char* file, mcs_replay_sys* R,
+                    const char* name, long reps, double tol){
+    mcs_spmat* A = R->A;
+    mcs_splu_symbolic* S;
+    mcs_splu_numeric* N;
+    mcs_amg* H;
+    mcs_gcro* G = NULL;
+    mcs_status st;
+    double *x, *r, *work;
+    double t0, t_setup = 0.0, t_solve = 0.0, nb = 0.0, nr = 0.0;
+    long n = A->r_len, i, k, iter = 0;
+    int ok = (A->r_len == A->c_len);
+    x = (double*) malloc(sizeof(double)*(n+1));
+    r = (double*) malloc(sizeof(double)*(n+1));
+    work = (double*) malloc(sizeof(double)*(6*n+1));
+    if(ok && strcmp(name,"amg") == 0){
+        ok = mcs_amg_is_spd(A);
+    }
+    for(k=0;k<reps && ok;k++){
+        for(i=0;i<n;i++){
+            x[i] = 0.0;
+        }
+        if(strcmp(name,"bicgstab") == 0){
+            t0 = mcs_prof_now();
+            iter = mcs_bicgstab_r(mcs_replay_apply,A,R->b,x,work,n,tol,
+                                  MCS_REPLAY_MAX_ITER);
+            t_solve += mcs_prof_now() - t0;
+            ok = (iter >= 0);
+        }else if(strcmp(name,"lu") == 0){
+            t0 = mcs_prof_now();
+            if(mcs_splu_analyze_r(A,&S)){
+                ok = 0;
+                break;
+            }
+            mcs_alloc_splu(S,&N);
+            t_setup += mcs_prof_now() - t0;
+            t0 = mcs_prof_now();
+            ok = (mcs_splu_factor(N,A->dat) == 0);
+            mcs_splu_solve(N,R->b,x);
+            t_solve += mcs_prof_now() - t0;
+            mcs_free_splu(&N);
+            mcs_free_splu_symbolic(&S);
+            iter = 1;
+        }else if(strcmp(name,"amg") == 0){
+            t0 = mcs_prof_now();
+            mcs_status_init(&st);
+            if(mcs_alloc_amg(A,&H,&st)){
+                ok = 0;
+                break;
+            }
+            t_setup += mcs_prof_now() - t0;
+            t0 = mcs_prof_now();
+            iter = mcs_amg_pcg(H,R->b,x,tol,MCS_REPLAY_MAX_ITER);
+            t_solve += mcs_prof_now() - t0;
+            mcs_free_amg(&H);
+            ok = (iter >= 0);
+        }else if(strcmp(name,"gcro") == 0){
+            if(G == NULL){
+                t0 = mcs_prof_now();
+                mcs_alloc_gcro(&G,n,MCS_GCRO_M,MCS_GCRO_K);
+                t_setup += mcs_prof_now() - t0;
+            }
+            t0 = mcs_prof_now();
+            iter = mcs_spmat_gcro(G,A,R->b,x,tol,MCS_REPLAY_MAX_ITER);
+            t_solve += mcs_prof_now() - t0;
+            ok = (iter >= 0);
+        }else{
+            ok = 0;
+        }
+    }
+    fprintf(out,"{\"file\": \"%s\", \"dim\": %ld, \"nnz\": %ld, "
+                "\"solver\": \"%s\", ",file,n,A->nnz,name);
+    if(ok){
+        mcs_spmatvec('n',A,x,r);
+        for(i=0;i<n;i++){
+            nb += R->b[i]*R->b[i];
+            nr += (R->b[i]-r[i])*(R->b[i]-r[i]);
+        }
+        fprintf(out,"\"setup\": %.6e, \"solve\": %.6e, \"iter\": %ld, "
+                    "\"resid\": %.6e}\n",t_setup/reps,t_solve/reps,iter,
+                    nb > 0.0 ? sqrt(nr/nb) : sqrt(nr));
+    }else{
+        fprintf(out,"\"setup\": null, \"solve\": null, \"iter\": null, "
+                    "\"resid\": null}\n");
+    }
+    fflush(out);
+    if(G != NULL){
+        mcs_free_gcro(&G);
+    }
+    free(work);
+    free(r);
+    free(x);
+}
+
+/*
+ * Usage: replay.x [-s solver,...] [-r reps] [-t tol] file...
+ * The solvers default to bicgstab,lu,amg, and reps defaults to 1.
+ * Returns 1 if any file could not be loaded.
+ */
+int main(int argc, char** argv){
+    const char* solvers = "bicgstab,lu,amg";
+    char* list;
+    char* name;
+    char* save_ptr;
+    mcs_replay_sys R;
+    mcs_status st;
+    double tol = MCS_REPLAY_TOL;
+    long reps = 1;
+    int a, fail = 0;
+    for(a=1;a<argc && argv[a][0]=='-';a++){
+        if(strcmp(argv[a],"-s") == 0 && a+1 < argc){
+            solvers = argv[++a];
+        }else if(strcmp(argv[a],"-r") == 0 && a+1 < argc){
+            reps = atol(argv[++a]);
+        }else if(strcmp(argv[a],"-t") == 0 && a+1 < argc){
+            tol = atof(argv[++a]);
+        }else{
+            printf("Usage: %s [-s solver,...] [-r reps] [-t tol] file...\n",
+                        argv[0]);
+            return 1;
+        }
+    }
+    if(reps < 1){
+        reps = 1;
+    }
+    list = (char*) malloc(sizeof(char)*(strlen(solvers)+1));
+    for(;a<argc;a++){
+        mcs_status_init(&st);
+        if(mcs_replay_load(argv[a],&R,&st)){
+            printf("%s:%s",argv[a],mcs_error_str(st.err));
+            fail = 1;
+            continue;
+        }
+        strcpy(list,solvers);
+        for(name=strtok_r(list,",",&save_ptr);name!=NULL;
+            name=strtok_r(NULL,",",&save_ptr)){
+            mcs_replay_run(stdout,argv[a],&R,name,reps,tol);
+        }
+        mcs_replay_free(&R);
+    }
+    free(list);
+    return fail;
+}
@@ -0,0 +1,95 @@
+#ifndef MCS_REPLAY_H
+#define MCS_REPLAY_H
+
+/*
+ * Solver replay driver for MicroCircSim by Bram Rodgers.
+ *
+ * Loads saved linear systems A*x = b and times solving them, so that
+ * systems captured from slow simulations (see matrix_io.h) form
+ * a reproducible performance corpus. Each system file is either:
+ * ->A binary system file ending in .bin, which is loaded with mmap.
+ * ->A coordinate Matrix Market file. The right hand side is read from
+ *   the array Matrix Market file of the same name with _b before the
+ *   extension, such as G_b.mtx for G.mtx, if there is one. Otherwise
+ *   b is A times a vector of ones.
+ *
+ * The solvers which may be timed are:
+ * ->bicgstab:  the iteration of mcs_spmat_bicgstab, limited to
+ *              MCS_REPLAY_MAX_ITER iterations so it always stops.
+ * ->lu:        mcs_splu_analyze_r and mcs_alloc_splu as setup, then
+ *              mcs_splu_factor and mcs_splu_solve.
+ * ->amg:       mcs_alloc_amg as setup, then mcs_amg_pcg. Only run when
+ *              mcs_amg_is_spd holds for A.
+ * ->gcro:      mcs_spmat_gcro with a relative tolerance. One recycling
+ *              session is kept across the repeats, and the iteration
+ *              count is the number of products of the last repeat.
+ *
+ * Every solve of every system is printed as one line of JSON, with times
+ * in seconds averaged over the repeats, the iteration count, and the
+ * relative residual |b - A*x|/|b|. Solvers which failed or were skipped
+ * have a null solve time.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include<stdio.h>
+#include"math.h"
+#include"../micro_circ_sim.h"
+
+/*
+ * Default tolerance of the iterative solvers. mcs_amg_pcg compares it with
+ * the relative residual, and mcs_bicgstab_r with the RMS residual.
+ */
+#define MCS_REPLAY_TOL      1.0e-9
+
+/*
+ * Iteration limit of the iterative solvers.
+ */
+#define MCS_REPLAY_MAX_ITER 10000
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * A loaded system. A and b point into map for binary files, and are
+ * owned by the struct otherwise.
+ */
+typedef struct _mcs_replay_sys{
+    mcs_sys_map* map;   /*NULL for Matrix Market files*/
+    mcs_spmat* A;
+    double* b;
+} mcs_replay_sys;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Load the system in filename into R. Returns 0 on success, or 1 after
+ * recording the error in st.
+ */
+int mcs_replay_load(const char* filename, mcs_replay_sys* R,
+                    mcs_status* st);
+
+/*
+ * Free the storage of a system loaded with mcs_replay_load.
+ */
+void mcs_replay_free(mcs_replay_sys* R);
+
+/*
+ * Time solving the system R with the solver called name, repeated reps
+ * times, and print one line of JSON to out. file labels the line.
+ */
+void mcs_replay_run(FILE* out, const char* file, mcs_replay_sys* R,
+                    const char* name, long reps, double tol);
+
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Implementation for:
+ * A reentrant simulation context for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "sim_context.h"
+/*
+ * Locally used helper functions:
+ */
+
+void mcs_ctx_drop(mcs_ctx* ctx);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Free the circuit and solver state of ctx, keeping its status.
+ */
+void mcs_ctx_drop(mcs_ctx* ctx){
+    if(ctx->N != NULL){
+        mcs_free_splu(&(ctx->N));
+        mcs_free_splu_symbolic(&(ctx->S));
+        ctx->N = NULL;
+        ctx->S = NULL;
+    }
+    if(ctx->G != NULL){
+        mcs_free_spmat(&(ctx->G));
+    }
+    if(ctx->gen != NULL){
+        mcs_free_codegen(&(ctx->gen));
+    }
+    if(ctx->M != NULL){
+        mcs_free_mna(&(ctx->M));
+        free(ctx->x);
+        free(ctx->work);
+    }
+    if(ctx->nl != NULL){
+        mcs_free_netlist(&(ctx->nl));
+    }
+    ctx->nl = NULL;
+    ctx->M = NULL;
+    ctx->G = NULL;
+    ctx->x = NULL;
+    ctx->work = NULL;
+}
+
+void mcs_alloc_ctx(mcs_ctx** ctx){
+    *ctx = (mcs_ctx*) malloc(sizeof(mcs_ctx));
+    mcs_status_init(&((*ctx)->st));
+    (*ctx)->nl = NULL;
+    (*ctx)->M = NULL;
+    (*ctx)->gen = NULL;
+    (*ctx)->G = NULL;
+    (*ctx)->S = NULL;
+    (*ctx)->N = NULL;
+    (*ctx)->x = NULL;
+    (*ctx)->work = NULL;
+}
+
+void mcs_free_ctx(mcs_ctx** ctx){
+    mcs_ctx_drop(*ctx);
+    free(*ctx);
+    *ctx = NULL;
+}
+
+void mcs_ctx_clear(mcs_ctx* ctx){
+    mcs_status_init(&(ctx->st));
+}
+
+const char* mcs_ctx_error(mcs_ctx* ctx){
+    if(!ctx->st.failed){
+        return NULL;
+    }
+    return mcs_error_str(ctx->st.err);
+}
+
+int mcs_ctx_load(mcs_ctx* ctx, const char* filename){
+    long i;
+    mcs_ctx_drop(ctx);
+    if(mcs_read_netlist_r(filename,&(ctx->nl),ctx->nl_line,&(ctx->st))){
+        return 1;
+    }
+    mcs_alloc_mna(&(ctx->M),ctx->nl);
+    ctx->x = (double*) malloc(sizeof(double)*(ctx->M->dim+1));
+    ctx->work = (double*) malloc(sizeof(double)*(4*ctx->M->dim+1));
+    for(i=0;i<ctx->M->dim;i++){
+        ctx->x[i] = 0.0;
+    }
+    return 0;
+}
+
+int mcs_ctx_codegen(mcs_ctx* ctx){
+    if(ctx->M == NULL){
+        return mcs_raise(&(ctx->st),DEFAULT_ERR);
+    }
+    if(ctx->gen != NULL){
+        return 0;
+    }
+    return mcs_alloc_codegen(ctx->M,&(ctx->gen),&(ctx->st));
+}
+
+int mcs_ctx_dc_op(mcs_ctx* ctx, double tol, long max_iter){
+    if(ctx->M == NULL){
+        return mcs_raise(&(ctx->st),DEFAULT_ERR);
+    }
+    if(ctx->N == NULL){
+        if(ctx->G == NULL){
+            mcs_mna_alloc_G(ctx->M,&(ctx->G));
+        }
+        //choose the pivot order with the values at the initial guess
+        mcs_mna_stamp_G(ctx->M,ctx->x,ctx->G->dat,NULL);
+        if(mcs_splu_analyze_r(ctx->G,&(ctx->S))){
+            return mcs_raise(&(ctx->st),MCS_SINGULAR_MATRIX);
+        }
+        mcs_alloc_splu(ctx->S,&(ctx->N));
+    }
+    if(mcs_dc_homotopy(ctx->M,ctx->G,ctx->N,ctx->x,ctx->work,
+                       tol,max_iter) < 0){
+        return mcs_raise(&(ctx->st),MCS_NO_CONVERGE);
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#ifndef MCS_SIM_CONTEXT_H
+#define MCS_SIM_CONTEXT_H
+
+/*
+ * A reentrant simulation context for MicroCircSim by Bram Rodgers.
+ *
+ * A context owns everything one simulation needs: the parser line buffer,
+ * the netlist, its MNA description, the DC matrix with its LU factors,
+ * and an error status. Nothing is shared between contexts, so one process
+ * may run many simulations at once, one context per thread.
+ *
+ * The mcs_ctx_ functions never exit the process. They return 0 on
+ * success, and otherwise return 1 with the error kept in ctx->st until
+ * mcs_ctx_clear is called. After an error the context may be reused.
+ *
+ * Loading a netlist drops the previous circuit, while repeated DC solves
+ * of one circuit reuse its sparsity pattern, pivot order, and the last
+ * solution as the initial guess. The MNA description in ctx->M can be
+ * given to the other analyses, which keep their state in their own
+ * structs.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"../error_handling/error_handling.h"
+#include"../netlist_parser/netlist_parser.h"
+#include"../mna_system/mna_system.h"
+#include"../sparse_lu/sparse_lu.h"
+#include"../dc_analysis/dc_analysis.h"
+#include"../stamp_codegen/stamp_codegen.h"
+
+/*
+ * Object and Struct Definitions:
+ */
+
+typedef struct _mcs_ctx{
+    mcs_status st;                      /*Error status of this simulation*/
+    char nl_line[MCS_NETLIST_LINE_LEN+1]; /*Parser line buffer*/
+    mcs_netlist* nl;                    /*The loaded netlist, or NULL*/
+    mcs_mna* M;                         /*MNA description of nl, or NULL*/
+    mcs_codegen* gen;                   /*Generated stamping code, or NULL*/
+    mcs_spmat* G;                       /*DC matrix, or NULL until solved*/
+    mcs_splu_symbolic* S;               /*Symbolic analysis of G*/
+    mcs_splu_numeric* N;                /*Numeric factors of G*/
+    double* x;                          /*Last DC solution, M->dim entries*/
+    double* work;                       /*Newton workspace*/
+} mcs_ctx;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Allocate an empty context with a clear status.
+ */
+void mcs_alloc_ctx(mcs_ctx** ctx);
+
+/*
+ * Free a context along with every object it owns.
+ */
+void mcs_free_ctx(mcs_ctx** ctx);
+
+/*
+ * Clear the error status of ctx.
+ */
+void mcs_ctx_clear(mcs_ctx* ctx);
+
+/*
+ * Return the message of the error recorded in ctx, or NULL if there is
+ * none. ctx->st.line holds the netlist line of a parser error.
+ */
+const char* mcs_ctx_error(mcs_ctx* ctx);
+
+/*
+ * Read the netlist in filename and build its MNA description, replacing
+ * the circuit held by ctx. ctx->x is set to zero.
+ */
+int mcs_ctx_load(mcs_ctx* ctx, const char* filename);
+
+/*
+ * Stamp the loaded circuit with generated code from now on, see
+ * stamp_codegen.h. The first call for a circuit which is not cached runs
+ * the compiler. Records MCS_CODEGEN if the code cannot be built, in which
+ * case the generic stamping code is kept.
+ */
+int mcs_ctx_codegen(mcs_ctx* ctx);
+
+/*
+ * Solve for the DC operating point of the loaded circuit, starting from
+ * ctx->x and leaving the result in ctx->x. tol and max_iter are as in
+ * mcs_dc_op. Records MCS_SINGULAR_MATRIX if G has no pivot order, and
+ * MCS_NO_CONVERGE if Newton's method and continuation both fail.
+ */
+int mcs_ctx_dc_op(mcs_ctx* ctx, double tol, long max_iter);
+
+#endif
@@ -0,0 +1,804 @@
+/*
+ * Implementation for:
+ * Sparse LU factorization of real and complex matrices by Bram Rodgers.
+ * Left-looking Gilbert-Peierls elimination with threshold partial pivoting.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "sparse_lu.h"
+#include <complex.h>
+
+/*
+ * States of a node of the minimum degree quotient graph. A variable is
+ * not eliminated yet, an element is an eliminated node whose clique is
+ * still in use, and a node which is gone is ordered and merged away.
+ * Dense nodes are left out of the graph and ordered last.
+ */
+#define MCS_SPLU_VAR   0
+#define MCS_SPLU_ELEM  1
+#define MCS_SPLU_GONE  2
+#define MCS_SPLU_DENSE 3
+
+/*
+ * Locally used helper functions:
+ */
+
+void mcs_splu_compress(mcs_spmat* A, long* qinv, mcs_splu_symbolic* S,
+                       double* Ax);
+void mcs_splu_mindeg(mcs_splu_symbolic* S, long* q);
+long mcs_splu_degree(long i, long** adj, long* len, long* state,
+                     long* stamp, long tag);
+void mcs_splu_dlink(long i, long* deg, long* dhead, long* dnext,
+                    long* dprev);
+void mcs_splu_dunlink(long i, long* deg, long* dhead, long* dnext,
+                      long* dprev);
+long mcs_splu_reach(mcs_splu_symbolic* S, long k, long* xi, long* stack,
+                    long* pos, long* mark);
+void mcs_splu_grow(long** idx, double** val, long* cap, long need);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Sort the coordinate entries of A by column, sum duplicates, and fill
+ * S->Ap, S->Ai, S->map. Column j of A is stored as column qinv[j], or as
+ * column j if qinv is NULL. The summed values are stored in Ax, which
+ * needs A->nnz entries of memory.
+ */
+void mcs_splu_compress(mcs_spmat* A, long* qinv, mcs_splu_symbolic* S,
+                       double* Ax){
+    long n = S->n;
+    long j, k, t, slot;
+    long* cnt = (long*) malloc(sizeof(long)*(n+1));
+    long* order = (long*) malloc(sizeof(long)*(A->nnz+1));
+    long* mark = (long*) malloc(sizeof(long)*n);
+    long* col = (long*) malloc(sizeof(long)*(A->nnz+1));
+    for(j=0;j<=n;j++){
+        cnt[j] = 0;
+    }
+    for(k=0;k<A->nnz;k++){
+        col[k] = (qinv == NULL) ? A->c[k] : qinv[A->c[k]];
+        cnt[col[k]+1]++;
+    }
+    for(j=0;j<n;j++){
+        cnt[j+1] += cnt[j];
+        mark[j] = -1;
+    }
+    //counting sort of the coordinate entries by column
+    for(k=0;k<A->nnz;k++){
+        order[cnt[col[k]]++] = k;
+    }
+    //cnt[j] is now the end of column j, so cnt[j-1] is its start.
+    slot = 0;
+    t = 0;
+    for(j=0;j<n;j++){
+        S->Ap[j] = slot;
+        for(;t<cnt[j];t++){
+            k = order[t];
+            if(mark[A->r[k]] < S->Ap[j]){
+                //first time row A->r[k] appears in column j
+                mark[A->r[k]] = slot;
+                S->Ai[slot] = A->r[k];
+                Ax[slot] = 0.0;
+                slot++;
+            }
+            S->map[k] = mark[A->r[k]];
+            Ax[S->map[k]] += A->dat[k];
+        }
+    }
+    S->Ap[n] = slot;
+    free(col);
+    free(mark);
+    free(order);
+    free(cnt);
+}
+
+/*
+ * Minimum degree ordering of the pattern of A + A^(T), with A the
+ * compressed matrix S->Ap, S->Ai in natural column order. Writes the
+ * order into q.
+ *
+ * The graph is kept in quotient form. When a node is eliminated it turns
+ * into an element, whose list holds the variables of the clique its
+ * elimination creates, so fill edges are never stored one by one. The
+ * list of a variable holds the variables and elements it touches, and
+ * its degree is the size of the union of those variables and cliques.
+ * Elements touching the pivot are merged into the new element, and a
+ * variable left touching only the new element is ordered right after
+ * the pivot, as eliminating it creates no fill.
+ */
+void mcs_splu_mindeg(mcs_splu_symbolic* S, long* q){
+    long n = S->n;
+    long** adj;
+    long *len, *cap, *state, *deg, *dnext, *dprev, *dhead, *stamp, *lp;
+    long i, j, k, p, t, v, d, nq, nlp, mindeg, dense, tag;
+    adj = (long**) malloc(sizeof(long*)*(n+1));
+    len = (long*) malloc(sizeof(long)*(n+1));
+    cap = (long*) malloc(sizeof(long)*(n+1));
+    state = (long*) malloc(sizeof(long)*(n+1));
+    deg = (long*) malloc(sizeof(long)*(n+1));
+    dnext = (long*) malloc(sizeof(long)*(n+1));
+    dprev = (long*) malloc(sizeof(long)*(n+1));
+    dhead = (long*) malloc(sizeof(long)*(n+1));
+    stamp = (long*) malloc(sizeof(long)*(n+1));
+    lp = (long*) malloc(sizeof(long)*(n+1));
+    for(i=0;i<n;i++){
+        len[i] = 0;
+        cap[i] = 4;
+        adj[i] = (long*) malloc(sizeof(long)*cap[i]);
+        state[i] = MCS_SPLU_VAR;
+        stamp[i] = -1;
+    }
+    //adjacency of A + A^(T) without the diagonal, then drop duplicates
+    for(j=0;j<n;j++){
+        for(p=S->Ap[j];p<S->Ap[j+1];p++){
+            i = S->Ai[p];
+            if(i != j){
+                mcs_splu_grow(&(adj[i]),NULL,&(cap[i]),len[i]+1);
+                adj[i][len[i]++] = j;
+                mcs_splu_grow(&(adj[j]),NULL,&(cap[j]),len[j]+1);
+                adj[j][len[j]++] = i;
+            }
+        }
+    }
+    dense = (long) (MCS_SPLU_DENSE_SCALE*sqrt((double) n));
+    dense = (dense > MCS_SPLU_DENSE_MIN) ? dense : MCS_SPLU_DENSE_MIN;
+    for(i=0;i<n;i++){
+        d = 0;
+        for(t=0;t<len[i];t++){
+            if(stamp[adj[i][t]] != i){
+                stamp[adj[i][t]] = i;
+                adj[i][d++] = adj[i][t];
+            }
+        }
+        len[i] = d;
+        if(d > dense){
+            state[i] = MCS_SPLU_DENSE;
+        }
+    }
+    tag = n;
+    for(i=0;i<=n;i++){
+        dhead[i] = -1;
+    }
+    for(i=0;i<n;i++){
+        if(state[i] != MCS_SPLU_VAR){
+            continue;
+        }
+        d = 0;
+        for(t=0;t<len[i];t++){
+            if(state[adj[i][t]] == MCS_SPLU_VAR){
+                adj[i][d++] = adj[i][t];
+            }
+        }
+        len[i] = d;
+        deg[i] = d;
+        mcs_splu_dlink(i,deg,dhead,dnext,dprev);
+    }
+    nq = 0;
+    mindeg = 0;
+    while(1){
+        while(mindeg < n && dhead[mindeg] == -1){
+            mindeg++;
+        }
+        if(mindeg >= n){
+            break;
+        }
+        p = dhead[mindeg];
+        mcs_splu_dunlink(p,deg,dhead,dnext,dprev);
+        q[nq++] = p;
+        //gather the clique of p, merging the elements it touches
+        tag++;
+        stamp[p] = tag;
+        nlp = 0;
+        for(t=0;t<len[p];t++){
+            j = adj[p][t];
+            if(state[j] == MCS_SPLU_VAR && stamp[j] != tag){
+                stamp[j] = tag;
+                lp[nlp++] = j;
+            }else if(state[j] == MCS_SPLU_ELEM){
+                for(k=0;k<len[j];k++){
+                    v = adj[j][k];
+                    if(state[v] == MCS_SPLU_VAR && stamp[v] != tag){
+                        stamp[v] = tag;
+                        lp[nlp++] = v;
+                    }
+                }
+                state[j] = MCS_SPLU_GONE;
+                free(adj[j]);
+                adj[j] = NULL;
+                len[j] = 0;
+            }
+        }
+        mcs_splu_grow(&(adj[p]),NULL,&(cap[p]),nlp);
+        for(t=0;t<nlp;t++){
+            adj[p][t] = lp[t];
+        }
+        len[p] = nlp;
+        //variables of the clique now reach each other through element p
+        for(t=0;t<nlp;t++){
+            i = lp[t];
+            mcs_splu_dunlink(i,deg,dhead,dnext,dprev);
+            d = 0;
+            for(k=0;k<len[i];k++){
+                j = adj[i][k];
+                if(state[j] == MCS_SPLU_ELEM ||
+                   (state[j] == MCS_SPLU_VAR && stamp[j] != tag)){
+                    adj[i][d++] = j;
+                }
+            }
+            mcs_splu_grow(&(adj[i]),NULL,&(cap[i]),d+1);
+            adj[i][d++] = p;
+            len[i] = d;
+        }
+        state[p] = MCS_SPLU_ELEM;
+        for(t=0;t<nlp;t++){
+            i = lp[t];
+            if(len[i] == 1){
+                state[i] = MCS_SPLU_GONE;
+                q[nq++] = i;
+            }
+        }
+        d = 0;
+        for(t=0;t<nlp;t++){
+            if(state[lp[t]] == MCS_SPLU_VAR){
+                adj[p][d++] = lp[t];
+            }
+        }
+        len[p] = d;
+        for(t=0;t<len[p];t++){
+            i = adj[p][t];
+            deg[i] = mcs_splu_degree(i,adj,len,state,stamp,++tag);
+            mcs_splu_dlink(i,deg,dhead,dnext,dprev);
+            mindeg = (deg[i] < mindeg) ? deg[i] : mindeg;
+        }
+    }
+    //dense rows and columns go last
+    for(i=0;i<n;i++){
+        if(state[i] == MCS_SPLU_DENSE){
+            q[nq++] = i;
+        }
+    }
+    for(i=0;i<n;i++){
+        free(adj[i]);
+    }
+    free(lp);
+    free(stamp);
+    free(dhead);
+    free(dprev);
+    free(dnext);
+    free(deg);
+    free(state);
+    free(cap);
+    free(len);
+    free(adj);
+}
+
+/*
+ * Number of distinct variables other than i that variable i touches,
+ * directly or through an element. Uses stamp[v] == tag as the seen mark,
+ * so tag must not have been used before.
+ */
+long mcs_splu_degree(long i, long** adj, long* len, long* state,
+                     long* stamp, long tag){
+    long t, k, j, v;
+    long d = 0;
+    stamp[i] = tag;
+    for(t=0;t<len[i];t++){
+        j = adj[i][t];
+        if(state[j] == MCS_SPLU_VAR && stamp[j] != tag){
+            stamp[j] = tag;
+            d++;
+        }else if(state[j] == MCS_SPLU_ELEM){
+            for(k=0;k<len[j];k++){
+                v = adj[j][k];
+                if(state[v] == MCS_SPLU_VAR && stamp[v] != tag){
+                    stamp[v] = tag;
+                    d++;
+                }
+            }
+        }
+    }
+    return d;
+}
+
+/*
+ * Insert node i at the front of the list of nodes with degree deg[i].
+ */
+void mcs_splu_dlink(long i, long* deg, long* dhead, long* dnext,
+                    long* dprev){
+    dprev[i] = -1;
+    dnext[i] = dhead[deg[i]];
+    if(dnext[i] != -1){
+        dprev[dnext[i]] = i;
+    }
+    dhead[deg[i]] = i;
+}
+
+/*
+ * Remove node i from the list of nodes with degree deg[i].
+ */
+void mcs_splu_dunlink(long i, long* deg, long* dhead, long* dnext,
+                      long* dprev){
+    if(dprev[i] != -1){
+        dnext[dprev[i]] = dnext[i];
+    }else{
+        dhead[deg[i]] = dnext[i];
+    }
+    if(dnext[i] != -1){
+        dprev[dnext[i]] = dprev[i];
+    }
+}
+
+/*
+ * Find the rows of x = L \ A(:,k) which may be nonzero, using the columns
+ * of L computed so far. Row i of A(:,k) makes every row below the unit
+ * diagonal of the column of L that row i was pivoted in nonzero, and so
+ * on, so the rows are found by a depth first search from each row of
+ * A(:,k). They are written to xi[top] up to xi[n-1] with every row ahead
+ * of the rows it reaches, which is the order the triangular solve needs.
+ * Returns top. The search path is kept in stack and pos, and mark[i] is
+ * set to k once row i is found.
+ */
+long mcs_splu_reach(mcs_splu_symbolic* S, long k, long* xi, long* stack,
+                    long* pos, long* mark){
+    long top = S->n;
+    long depth, p, i, col, end;
+    for(p=S->Ap[k];p<S->Ap[k+1];p++){
+        i = S->Ai[p];
+        if(mark[i] == k){
+            continue;
+        }
+        mark[i] = k;
+        col = S->pinv[i];
+        stack[0] = i;
+        pos[0] = (col < 0) ? 0 : S->Lp[col]+1;
+        depth = 0;
+        while(depth >= 0){
+            col = S->pinv[stack[depth]];
+            end = (col < 0) ? 0 : S->Lp[col+1];
+            while(pos[depth] < end && mark[S->Li[pos[depth]]] == k){
+                pos[depth]++;
+            }
+            if(pos[depth] < end){
+                //descend into the first row not found yet
+                i = S->Li[pos[depth]++];
+                mark[i] = k;
+                col = S->pinv[i];
+                depth++;
+                stack[depth] = i;
+                pos[depth] = (col < 0) ? 0 : S->Lp[col]+1;
+            }else{
+                xi[--top] = stack[depth];
+                depth--;
+            }
+        }
+    }
+    return top;
+}
+
+/*
+ * Make sure the factor arrays idx and val have at least need entries.
+ * val may be NULL.
+ */
+void mcs_splu_grow(long** idx, double** val, long* cap, long need){
+    if(need <= *cap){
+        return;
+    }
+    while(*cap < need){
+        *cap *= 2;
+    }
+    *idx = (long*) realloc(*idx, sizeof(long)*(*cap));
+    if(val != NULL){
+        *val = (double*) realloc(*val, sizeof(double)*(*cap));
+    }
+}
+
+void mcs_splu_analyze(mcs_spmat* A, mcs_splu_symbolic** S){
+    if(mcs_splu_analyze_r(A,S)){
+        mcs_error(MCS_SINGULAR_MATRIX);
+    }
+}
+
+int mcs_splu_analyze_r(mcs_spmat* A, mcs_splu_symbolic** S){
+    long n = A->r_len;
+    long i, k, p, q, top, ipiv, lnz, unz, lcap, ucap;
+    double a, piv;
+    double *Ax, *Lx, *x;
+    long *xi, *stack, *pos, *mark, *qinv;
+    mcs_splu_symbolic* T;
+    MCS_PROF_START(t_lu);
+    T = (mcs_splu_symbolic*) malloc(sizeof(mcs_splu_symbolic));
+    T->n = n;
+    T->nnz = A->nnz;
+    T->Ap = (long*) malloc(sizeof(long)*(n+1));
+    T->Ai = (long*) malloc(sizeof(long)*(A->nnz+1));
+    T->map = (long*) malloc(sizeof(long)*(A->nnz+1));
+    T->pinv = (long*) malloc(sizeof(long)*n);
+    T->q = (long*) malloc(sizeof(long)*(n+1));
+    T->Lp = (long*) malloc(sizeof(long)*(n+1));
+    T->Up = (long*) malloc(sizeof(long)*(n+1));
+    Ax = (double*) malloc(sizeof(double)*(A->nnz+1));
+    //order the columns on the natural pattern, then compress in that order
+    mcs_splu_compress(A,NULL,T,Ax);
+    mcs_splu_mindeg(T,T->q);
+    qinv = (long*) malloc(sizeof(long)*(n+1));
+    for(k=0;k<n;k++){
+        qinv[T->q[k]] = k;
+    }
+    mcs_splu_compress(A,qinv,T,Ax);
+    free(qinv);
+    lcap = 2*T->Ap[n] + n + 1;
+    ucap = lcap;
+    T->Li = (long*) malloc(sizeof(long)*lcap);
+    T->Ui = (long*) malloc(sizeof(long)*ucap);
+    Lx = (double*) malloc(sizeof(double)*lcap);
+    x = (double*) malloc(sizeof(double)*n);
+    xi = (long*) malloc(sizeof(long)*n);
+    stack = (long*) malloc(sizeof(long)*n);
+    pos = (long*) malloc(sizeof(long)*n);
+    mark = (long*) malloc(sizeof(long)*n);
+    for(i=0;i<n;i++){
+        T->pinv[i] = -1;
+        mark[i] = -1;
+        x[i] = 0.0;
+    }
+    lnz = 0;
+    unz = 0;
+    for(k=0;k<n;k++){
+        T->Lp[k] = lnz;
+        T->Up[k] = unz;
+        mcs_splu_grow(&(T->Li),&Lx,&lcap,lnz+n);
+        mcs_splu_grow(&(T->Ui),NULL,&ucap,unz+n);
+        //x = L \ A(:,k) restricted to the reach of A(:,k)
+        top = mcs_splu_reach(T,k,xi,stack,pos,mark);
+        for(p=T->Ap[k];p<T->Ap[k+1];p++){
+            x[T->Ai[p]] = Ax[p];
+        }
+        for(p=top;p<n;p++){
+            i = xi[p];
+            if(T->pinv[i] < 0){
+                continue;
+            }
+            for(q=T->Lp[T->pinv[i]]+1;q<T->Lp[T->pinv[i]+1];q++){
+                x[T->Li[q]] -= Lx[q]*x[i];
+            }
+        }
+        //search the unpivoted rows for the largest candidate
+        ipiv = -1;
+        a = -1.0;
+        for(p=top;p<n;p++){
+            i = xi[p];
+            if(T->pinv[i] < 0){
+                if(fabs(x[i]) > a){
+                    a = fabs(x[i]);
+                    ipiv = i;
+                }
+            }else{
+                T->Ui[unz++] = T->pinv[i];
+            }
+        }
+        if(ipiv < 0 || a <= 0.0){
+            break;
+        }
+        //prefer the diagonal, row q[k], when it is large enough
+        i = T->q[k];
+        if(T->pinv[i] < 0 && mark[i] == k &&
+           fabs(x[i]) >= MCS_SPLU_DIAG_TOL*a){
+            ipiv = i;
+        }
+        piv = x[ipiv];
+        T->Ui[unz++] = k;
+        T->pinv[ipiv] = k;
+        T->Li[lnz] = ipiv;
+        Lx[lnz++] = 1.0;
+        for(p=top;p<n;p++){
+            i = xi[p];
+            if(T->pinv[i] < 0){
+                T->Li[lnz] = i;
+                Lx[lnz++] = x[i]/piv;
+            }
+            x[i] = 0.0;
+        }
+    }
+    free(mark);
+    free(pos);
+    free(stack);
+    free(xi);
+    free(x);
+    free(Lx);
+    free(Ax);
+    if(k < n){
+        //column k has no pivot
+        T->Lp[n] = lnz;
+        T->Up[n] = unz;
+        mcs_free_splu_symbolic(&T);
+        *S = NULL;
+        MCS_PROF_STOP(MCS_PROF_LU_ANALYZE,t_lu);
+        return 1;
+    }
+    T->Lp[n] = lnz;
+    T->Up[n] = unz;
+    //store the row indices of L in pivoted order
+    for(p=0;p<lnz;p++){
+        T->Li[p] = T->pinv[T->Li[p]];
+    }
+    T->Li = (long*) realloc(T->Li,sizeof(long)*(lnz+1));
+    T->Ui = (long*) realloc(T->Ui,sizeof(long)*(unz+1));
+    *S = T;
+    MCS_PROF_STOP(MCS_PROF_LU_ANALYZE,t_lu);
+    return 0;
+}
+
+void mcs_free_splu_symbolic(mcs_splu_symbolic** S){
+    free((*S)->Ui);
+    free((*S)->Up);
+    free((*S)->Li);
+    free((*S)->Lp);
+    free((*S)->q);
+    free((*S)->pinv);
+    free((*S)->map);
+    free((*S)->Ai);
+    free((*S)->Ap);
+    free(*S);
+}
+
+void mcs_alloc_splu(mcs_splu_symbolic* S, mcs_splu_numeric** N){
+    *N = (mcs_splu_numeric*) malloc(sizeof(mcs_splu_numeric));
+    (*N)->S = S;
+    (*N)->Ax = (double*) malloc(sizeof(double)*(S->Ap[S->n]+1));
+    (*N)->Lx = (double*) malloc(sizeof(double)*(S->Lp[S->n]+1));
+    (*N)->Ux = (double*) malloc(sizeof(double)*(S->Up[S->n]+1));
+    (*N)->w = (double*) malloc(sizeof(double)*(S->n+1));
+}
+
+void mcs_free_splu(mcs_splu_numeric** N){
+    free((*N)->w);
+    free((*N)->Ux);
+    free((*N)->Lx);
+    free((*N)->Ax);
+    free(*N);
+}
+
+int mcs_splu_factor(mcs_splu_numeric* N, double* dat){
+    mcs_splu_symbolic* S = N->S;
+    double* w = N->w;
+    long j, k, p, q;
+    double xj, piv, a;
+    MCS_PROF_START(t_lu);
+    for(p=0;p<S->Ap[S->n];p++){
+        N->Ax[p] = 0.0;
+    }
+    for(k=0;k<S->nnz;k++){
+        N->Ax[S->map[k]] += dat[k];
+    }
+    for(k=0;k<S->n;k++){
+        for(p=S->Up[k];p<S->Up[k+1];p++){
+            w[S->Ui[p]] = 0.0;
+        }
+        for(p=S->Lp[k];p<S->Lp[k+1];p++){
+            w[S->Li[p]] = 0.0;
+        }
+        for(p=S->Ap[k];p<S->Ap[k+1];p++){
+            w[S->pinv[S->Ai[p]]] += N->Ax[p];
+        }
+        //the U pattern is in topological order, diagonal last.
+        for(p=S->Up[k];p<S->Up[k+1]-1;p++){
+            j = S->Ui[p];
+            xj = w[j];
+            N->Ux[p] = xj;
+            for(q=S->Lp[j]+1;q<S->Lp[j+1];q++){
+                w[S->Li[q]] -= N->Lx[q]*xj;
+            }
+        }
+        piv = w[k];
+        a = fabs(piv);
+        for(p=S->Lp[k]+1;p<S->Lp[k+1];p++){
+            if(fabs(w[S->Li[p]]) > a){
+                a = fabs(w[S->Li[p]]);
+            }
+        }
+        if(a == 0.0 || fabs(piv) < MCS_SPLU_REFACTOR_TOL*a){
+            MCS_PROF_STOP(MCS_PROF_LU_FACTOR,t_lu);
+            return 1;
+        }
+        N->Ux[S->Up[k+1]-1] = piv;
+        N->Lx[S->Lp[k]] = 1.0;
+        for(p=S->Lp[k]+1;p<S->Lp[k+1];p++){
+            N->Lx[p] = w[S->Li[p]]/piv;
+        }
+    }
+    MCS_PROF_STOP(MCS_PROF_LU_FACTOR,t_lu);
+    return 0;
+}
+
+void mcs_splu_solve(mcs_splu_numeric* N, double* b, double* x){
+    mcs_splu_symbolic* S = N->S;
+    double* w = N->w;
+    long j, p;
+    double xj;
+    MCS_PROF_START(t_lu);
+    for(j=0;j<S->n;j++){
+        w[S->pinv[j]] = b[j];
+    }
+    for(j=0;j<S->n;j++){
+        xj = w[j];
+        for(p=S->Lp[j]+1;p<S->Lp[j+1];p++){
+            w[S->Li[p]] -= N->Lx[p]*xj;
+        }
+    }
+    for(j=S->n-1;j>=0;j--){
+        w[j] /= N->Ux[S->Up[j+1]-1];
+        xj = w[j];
+        for(p=S->Up[j];p<S->Up[j+1]-1;p++){
+            w[S->Ui[p]] -= N->Ux[p]*xj;
+        }
+    }
+    for(j=0;j<S->n;j++){
+        x[S->q[j]] = w[j];
+    }
+    MCS_PROF_STOP(MCS_PROF_LU_SOLVE,t_lu);
+}
+
+void mcs_splu_tsolve(mcs_splu_numeric* N, double* b, double* x){
+    mcs_splu_symbolic* S = N->S;
+    double* w = N->w;
+    long j, p;
+    double wj;
+    MCS_PROF_START(t_lu);
+    //A = P^(T)*L*U*Q^(T), so A^(T)*x = b is U^(T)*L^(T)*(P*x) = Q^(T)*b.
+    for(j=0;j<S->n;j++){
+        wj = b[S->q[j]];
+        for(p=S->Up[j];p<S->Up[j+1]-1;p++){
+            wj -= N->Ux[p]*w[S->Ui[p]];
+        }
+        w[j] = wj/N->Ux[S->Up[j+1]-1];
+    }
+    for(j=S->n-1;j>=0;j--){
+        wj = w[j];
+        for(p=S->Lp[j]+1;p<S->Lp[j+1];p++){
+            wj -= N->Lx[p]*w[S->Li[p]];
+        }
+        w[j] = wj;
+    }
+    for(j=0;j<S->n;j++){
+        x[j] = w[S->pinv[j]];
+    }
+    MCS_PROF_STOP(MCS_PROF_LU_SOLVE,t_lu);
+}
+
+void mcs_alloc_zsplu(mcs_splu_symbolic* S, mcs_zsplu_numeric** N){
+    *N = (mcs_zsplu_numeric*) malloc(sizeof(mcs_zsplu_numeric));
+    (*N)->S = S;
+    (*N)->Ax = (double _Complex*)
+                    malloc(sizeof(double _Complex)*(S->Ap[S->n]+1));
+    (*N)->Lx = (double _Complex*)
+                    malloc(sizeof(double _Complex)*(S->Lp[S->n]+1));
+    (*N)->Ux = (double _Complex*)
+                    malloc(sizeof(double _Complex)*(S->Up[S->n]+1));
+    (*N)->w = (double _Complex*)
+                    malloc(sizeof(double _Complex)*(S->n+1));
+}
+
+void mcs_free_zsplu(mcs_zsplu_numeric** N){
+    free((*N)->w);
+    free((*N)->Ux);
+    free((*N)->Lx);
+    free((*N)->Ax);
+    free(*N);
+}
+
+int mcs_zsplu_factor(mcs_zsplu_numeric* N, double _Complex* dat){
+    mcs_splu_symbolic* S = N->S;
+    double _Complex* w = N->w;
+    long j, k, p, q;
+    double _Complex xj, piv;
+    double a;
+    MCS_PROF_START(t_lu);
+    for(p=0;p<S->Ap[S->n];p++){
+        N->Ax[p] = 0.0;
+    }
+    for(k=0;k<S->nnz;k++){
+        N->Ax[S->map[k]] += dat[k];
+    }
+    for(k=0;k<S->n;k++){
+        for(p=S->Up[k];p<S->Up[k+1];p++){
+            w[S->Ui[p]] = 0.0;
+        }
+        for(p=S->Lp[k];p<S->Lp[k+1];p++){
+            w[S->Li[p]] = 0.0;
+        }
+        for(p=S->Ap[k];p<S->Ap[k+1];p++){
+            w[S->pinv[S->Ai[p]]] += N->Ax[p];
+        }
+        for(p=S->Up[k];p<S->Up[k+1]-1;p++){
+            j = S->Ui[p];
+            xj = w[j];
+            N->Ux[p] = xj;
+            for(q=S->Lp[j]+1;q<S->Lp[j+1];q++){
+                w[S->Li[q]] -= N->Lx[q]*xj;
+            }
+        }
+        piv = w[k];
+        a = cabs(piv);
+        for(p=S->Lp[k]+1;p<S->Lp[k+1];p++){
+            if(cabs(w[S->Li[p]]) > a){
+                a = cabs(w[S->Li[p]]);
+            }
+        }
+        if(a == 0.0 || cabs(piv) < MCS_SPLU_REFACTOR_TOL*a){
+            MCS_PROF_STOP(MCS_PROF_LU_FACTOR,t_lu);
+            return 1;
+        }
+        N->Ux[S->Up[k+1]-1] = piv;
+        N->Lx[S->Lp[k]] = 1.0;
+        for(p=S->Lp[k]+1;p<S->Lp[k+1];p++){
+            N->Lx[p] = w[S->Li[p]]/piv;
+        }
+    }
+    MCS_PROF_STOP(MCS_PROF_LU_FACTOR,t_lu);
+    return 0;
+}
+
+void mcs_zsplu_solve(mcs_zsplu_numeric* N, double _Complex* b,
+                                            double _Complex* x){
+    mcs_splu_symbolic* S = N->S;
+    double _Complex* w = N->w;
+    long j, p;
+    double _Complex xj;
+    MCS_PROF_START(t_lu);
+    for(j=0;j<S->n;j++){
+        w[S->pinv[j]] = b[j];
+    }
+    for(j=0;j<S->n;j++){
+        xj = w[j];
+        for(p=S->Lp[j]+1;p<S->Lp[j+1];p++){
+            w[S->Li[p]] -= N->Lx[p]*xj;
+        }
+    }
+    for(j=S->n-1;j>=0;j--){
+        w[j] /= N->Ux[S->Up[j+1]-1];
+        xj = w[j];
+        for(p=S->Up[j];p<S->Up[j+1]-1;p++){
+            w[S->Ui[p]] -= N->Ux[p]*xj;
+        }
+    }
+    for(j=0;j<S->n;j++){
+        x[S->q[j]] = w[j];
+    }
+    MCS_PROF_STOP(MCS_PROF_LU_SOLVE,t_lu);
+}
+
+void mcs_zsplu_tsolve(mcs_zsplu_numeric* N, double _Complex* b,
+                                             double _Complex* x){
+    mcs_splu_symbolic* S = N->S;
+    double _Complex* w = N->w;
+    long j, p;
+    double _Complex wj;
+    MCS_PROF_START(t_lu);
+    for(j=0;j<S->n;j++){
+        wj = b[S->q[j]];
+        for(p=S->Up[j];p<S->Up[j+1]-1;p++){
+            wj -= N->Ux[p]*w[S->Ui[p]];
+        }
+        w[j] = wj/N->Ux[S->Up[j+1]-1];
+    }
+    for(j=S->n-1;j>=0;j--){
+        wj = w[j];
+        for(p=S->Lp[j]+1;p<S->Lp[j+1];p++){
+            wj -= N->Lx[p]*w[S->Li[p]];
+        }
+        w[j] = wj;
+    }
+    for(j=0;j<S->n;j++){
+        x[j] = w[S->pinv[j]];
+    }
+    MCS_PROF_STOP(MCS_PROF_LU_SOLVE,t_lu);
+}
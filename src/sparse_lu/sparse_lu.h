@@ -0,0 +1,194 @@
+#ifndef MCS_SPARSE_LU_H
+#define MCS_SPARSE_LU_H
+
+/*
+ * Sparse LU factorization of real and complex matrices by Bram Rodgers.
+ * Left-looking Gilbert-Peierls elimination with threshold partial pivoting.
+ *
+ * The factorization is split in two stages:
+ * ->A symbolic analysis which compresses the coordinate pattern, orders the
+ *   columns, picks the pivot order, and records the patterns of L and U.
+ *  |->Computed once per sparsity pattern.
+ * ->A numeric factorization which reuses the symbolic analysis.
+ *  |->Computed once per set of matrix values. Real and complex values
+ *     share the same symbolic analysis.
+ *
+ * Columns are ordered by minimum degree on the pattern of A + A^(T),
+ * with the elimination graph kept in quotient form so that fill is
+ * stored as cliques rather than edges. Rows are pivoted with a
+ * preference for the diagonal of each column, so for circuit matrices,
+ * whose diagonal is mostly nonzero, the pivot order is close to the
+ * symmetric ordering and the fill of L and U stays near that of a
+ * Cholesky factor in the same order. With P and Q the row and column
+ * permutations, the factors are P*A*Q = L*U.
+ *
+ * A symbolic analysis is only read by the numeric routines, so many
+ * threads may factor different values against one symbolic analysis.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../error_handling/error_handling.h"
+#include"../profiling/profiling.h"
+
+/*
+ * During analysis, the diagonal is kept as the pivot whenever its magnitude
+ * is at least MCS_SPLU_DIAG_TOL times the largest candidate in its column.
+ */
+#define MCS_SPLU_DIAG_TOL 0.1
+
+/*
+ * A numeric factorization reusing a pivot order is rejected when the pivot
+ * is smaller than MCS_SPLU_REFACTOR_TOL times the largest entry of its column.
+ */
+#define MCS_SPLU_REFACTOR_TOL 1.0e-8
+
+/*
+ * Rows and columns of A + A^(T) with more than MCS_SPLU_DENSE_MIN entries,
+ * and more than MCS_SPLU_DENSE_SCALE*sqrt(n) entries, are ordered last,
+ * as they would make every minimum degree update slow.
+ */
+#define MCS_SPLU_DENSE_MIN   16
+#define MCS_SPLU_DENSE_SCALE 10.0
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * Symbolic analysis of a square sparse matrix. All factor row indices
+ * are stored in pivoted order. The compressed matrix holds the columns
+ * of A in the order q, so its column k is column q[k] of A.
+ */
+typedef struct _mcs_splu_symbolic{
+    long n;     /*Number of rows and columns of the matrix*/
+    long nnz;   /*Number of coordinate format entries of the source matrix*/
+    long* Ap;   /*Column pointers of the compressed source matrix*/
+    long* Ai;   /*Row indices of the compressed source matrix*/
+    long* map;  /*map[k] is the compressed slot of coordinate entry k*/
+    long* pinv; /*pinv[i] is the pivot position of row i*/
+    long* q;    /*q[k] is the column of the matrix factored at step k*/
+    long* Lp;   /*Column pointers of L. Unit diagonal stored first.*/
+    long* Li;   /*Row indices of L*/
+    long* Up;   /*Column pointers of U. Diagonal stored last.*/
+    long* Ui;   /*Row indices of U in topological order*/
+} mcs_splu_symbolic;
+
+/*
+ * Numeric factors with real values.
+ */
+typedef struct _mcs_splu_numeric{
+    mcs_splu_symbolic* S; /*The symbolic analysis these factors use*/
+    double* Ax;           /*Values of the compressed source matrix*/
+    double* Lx;           /*Values of L*/
+    double* Ux;           /*Values of U*/
+    double* w;            /*Workspace vector of length S->n*/
+} mcs_splu_numeric;
+
+/*
+ * Numeric factors with complex values.
+ */
+typedef struct _mcs_zsplu_numeric{
+    mcs_splu_symbolic* S; /*The symbolic analysis these factors use*/
+    double _Complex* Ax;  /*Values of the compressed source matrix*/
+    double _Complex* Lx;  /*Values of L*/
+    double _Complex* Ux;  /*Values of U*/
+    double _Complex* w;   /*Workspace vector of length S->n*/
+} mcs_zsplu_numeric;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Compute the symbolic analysis of the square sparse matrix A.
+ * The pivot order is chosen using the magnitudes of the summed entries
+ * of A->dat, so A is expected to hold representative values.
+ * Duplicate coordinates in A are summed.
+ *
+ * Calls mcs_error(MCS_SINGULAR_MATRIX) if no pivot can be found.
+ */
+void mcs_splu_analyze(mcs_spmat* A, mcs_splu_symbolic** S);
+
+/*
+ * Version of mcs_splu_analyze which returns 1 with *S set to NULL if no
+ * pivot can be found, rather than exiting. Returns 0 on success.
+ */
+int mcs_splu_analyze_r(mcs_spmat* A, mcs_splu_symbolic** S);
+
+/*
+ * Free a symbolic analysis.
+ */
+void mcs_free_splu_symbolic(mcs_splu_symbolic** S);
+
+/*
+ * Allocate real numeric factors for the symbolic analysis S.
+ * S must outlive the numeric factors.
+ */
+void mcs_alloc_splu(mcs_splu_symbolic* S, mcs_splu_numeric** N);
+
+/*
+ * Free real numeric factors. The symbolic analysis is not freed.
+ */
+void mcs_free_splu(mcs_splu_numeric** N);
+
+/*
+ * Factor the matrix whose coordinate format values are dat, using the
+ * pattern and pivot order of N->S. dat has N->S->nnz entries ordered
+ * the same as the matrix given to mcs_splu_analyze.
+ *
+ * Returns 0 on success. Returns 1 if a pivot is too small for the fixed
+ * pivot order, in which case the values need a new symbolic analysis.
+ */
+int mcs_splu_factor(mcs_splu_numeric* N, double* dat);
+
+/*
+ * Solve A*x = b using the factors in N. b and x may be the same array.
+ */
+void mcs_splu_solve(mcs_splu_numeric* N, double* b, double* x);
+
+/*
+ * Solve A^(T)*x = b using the factors in N, at the cost of one
+ * mcs_splu_solve. b and x may be the same array.
+ */
+void mcs_splu_tsolve(mcs_splu_numeric* N, double* b, double* x);
+
+/*
+ * Allocate complex numeric factors for the symbolic analysis S.
+ * S must outlive the numeric factors.
+ */
+void mcs_alloc_zsplu(mcs_splu_symbolic* S, mcs_zsplu_numeric** N);
+
+/*
+ * Free complex numeric factors. The symbolic analysis is not freed.
+ */
+void mcs_free_zsplu(mcs_zsplu_numeric** N);
+
+/*
+ * Complex version of mcs_splu_factor.
+ */
+int mcs_zsplu_factor(mcs_zsplu_numeric* N, double _Complex* dat);
+
+/*
+ * Complex version of mcs_splu_solve.
+ */
+void mcs_zsplu_solve(mcs_zsplu_numeric* N, double _Complex* b,
+                                            double _Complex* x);
+
+/*
+ * Complex version of mcs_splu_tsolve. The transpose is not conjugated.
+ */
+void mcs_zsplu_tsolve(mcs_zsplu_numeric* N, double _Complex* b,
+                                             double _Complex* x);
+
+#endif
@@ -9,18 +9,26 @@
  * Macros and Includes go here: (Some common ones included)
  */
 #include "sparse_matrix.h"
+#include <complex.h>
 #include "vector_math.h"
 /*
  * Locally used helper functions:
  */
 
-void mcs_apply_linmap(double* x, double* y);
+void mcs_apply_spmat(void* A, double* x, double* y);
+void mcs_apply_fn(void* L, double* x, double* y);
 
 /*
- * Static Local Variables:
+ * Wrapper which passes a function pointer through the void* data argument
+ * of mcs_bicgstab_r.
  */
+typedef struct _mcs_linmap_fn{
+    void (*L)(double*,double*);
+} mcs_linmap_fn;
 
-mcs_spmat* lin_map;
+/*
+ * Static Local Variables:
+ */
 
 /*
  * Function Implementations:
@@ -30,6 +38,7 @@ void mcs_spmatvec(char tran, mcs_spmat* A, double* x, double* y){
     long* r_arr;
     long* c_arr;
     long i, nr;//, nc;
+    MCS_PROF_START(t_mv);
     if(tran == 't' || tran == 'T'){
         r_arr = A->c;
         c_arr = A->r;
@@ -47,10 +56,47 @@ void mcs_spmatvec(char tran, mcs_spmat* A, double* x, double* y){
     for(i=0;i<A->nnz;i++){
         y[r_arr[i]] += A->dat[i]*x[c_arr[i]];
     }
+    MCS_PROF_COUNT(MCS_PROF_MATVECS,1);
+    MCS_PROF_STOP(MCS_PROF_SPMATVEC,t_mv);
 }
 
-void mcs_apply_lin_map(double* x, double* y){
-    mcs_spmatvec('n',lin_map,x,y);
+void mcs_zspmatvec(char tran, mcs_zspmat* A, double _Complex* x,
+                                             double _Complex* y){
+    long* r_arr;
+    long* c_arr;
+    long i, nr;
+    MCS_PROF_START(t_mv);
+    if(tran == 't' || tran == 'T' || tran == 'h' || tran == 'H'){
+        r_arr = A->c;
+        c_arr = A->r;
+        nr = A->c_len;
+    }else{
+        r_arr = A->r;
+        c_arr = A->c;
+        nr = A->r_len;
+    }
+    for(i=0;i<nr;i++){
+        y[i] = 0.0;
+    }
+    if(tran == 'h' || tran == 'H'){
+        for(i=0;i<A->nnz;i++){
+            y[r_arr[i]] += conj(A->dat[i])*x[c_arr[i]];
+        }
+    }else{
+        for(i=0;i<A->nnz;i++){
+            y[r_arr[i]] += A->dat[i]*x[c_arr[i]];
+        }
+    }
+    MCS_PROF_COUNT(MCS_PROF_MATVECS,1);
+    MCS_PROF_STOP(MCS_PROF_SPMATVEC,t_mv);
+}
+
+void mcs_apply_spmat(void* A, double* x, double* y){
+    mcs_spmatvec('n',(mcs_spmat*) A,x,y);
+}
+
+void mcs_apply_fn(void* L, double* x, double* y){
+    ((mcs_linmap_fn*) L)->L(x,y);
 }
 
 void mcs_bicgstab(void (*L)(double*,double*),
@@ -59,35 +105,65 @@ void mcs_bicgstab(void (*L)(double*,double*),
                         double* work,
                         long N,
                         double tol){
+    mcs_linmap_fn f;
+    f.L = L;
+    mcs_bicgstab_r(&mcs_apply_fn,&f,b,x,work,N,tol,0);
+}
+
+long mcs_bicgstab_r(void (*L)(void*,double*,double*),
+                    void* data,
+                    double* b,
+                    double* x,
+                    double* work,
+                    long N,
+                    double tol,
+                    long max_iter){
     /********From Xianyi Zeng's lecture notes at UT El Paso*********/
     double a, w, be, rho_old, rho_new, norm2;
     double *r_j, *r_0, *p_j, *v_j, *s_j, *t_j;
-    //long N = A->r_len;
-    long i=0;
+    long i=0, iter=0;
     r_j = work;
     p_j = &(work[N]);
     v_j = &(work[2*N]);
     s_j = &(work[3*N]);
     t_j = &(work[4*N]);
     r_0 = &(work[5*N]);
-    L(x,r_0);
+    MCS_PROF_START(t_cg);
+    L(data,x,r_0);
     mcs_vector_add(b,r_0,-1.0,r_0,i,N);
     mcs_vector_copy(r_0,r_j,i,N);
     mcs_vector_copy(r_0,p_j,i,N);
     mcs_vector_dot(r_j,r_0,rho_old,i,N);
+    if(rho_old == 0.0){
+        //x already solves the system
+        MCS_PROF_STOP(MCS_PROF_BICGSTAB,t_cg);
+        return 0;
+    }
     do{
-        L(p_j,v_j);
+        if(max_iter > 0 && iter >= max_iter){
+            iter = -1;
+            break;
+        }
+        iter++;
+        L(data,p_j,v_j);
         mcs_vector_dot(v_j,r_0,a,i,N);
         a = rho_old / a;
         mcs_vector_add(r_j,v_j,-a,s_j,i,N);
-        L(s_j,t_j);
+        L(data,s_j,t_j);
         mcs_vector_dot(t_j,t_j,norm2,i,N);
+        if(norm2 == 0.0){
+            //s_j is zero, so x + a*p_j is the solution
+            mcs_vector_add(x,p_j,a,x,i,N);
+            break;
+        }
         mcs_vector_dot(t_j,s_j,w,i,N);
         w = w/norm2;
         mcs_vector_combo2(x,p_j,a,s_j,w,x,i,N);
         mcs_vector_add(s_j,t_j,-w,r_j,i,N);
         mcs_vector_dot(r_j,r_j,norm2,i,N);
         norm2 /= N;
+        MCS_PROF_COUNT(MCS_PROF_ITERS,1);
+        MCS_PROF_COUNT(MCS_PROF_DOTS,5);
         if(sqrt(norm2) < tol){break;}
         mcs_vector_dot(r_j,r_0,rho_new,i,N);
         be = (a/w)*(rho_new/rho_old);
@@ -95,17 +171,19 @@ void mcs_bicgstab(void (*L)(double*,double*),
         w = -w*be;
         mcs_vector_combo2(r_j,p_j,be,v_j,w,p_j,i,N);
     }while(1);
+    MCS_PROF_COUNT(MCS_PROF_DOTS,1);
+    MCS_PROF_STOP(MCS_PROF_BICGSTAB,t_cg);
     /****************END LECTURE NOTES REFERENCE********************/
+    return iter;
 }
 
+
 void mcs_spmat_bicgstab(mcs_spmat* A,
                         double* b,
                         double* x,
                         double* work,
                         double tol){
-    extern mcs_spmat* lin_map;
-    lin_map = A;
-    mcs_bicgstab(&mcs_apply_lin_map,b,x,work,A->r_len,tol);
+    mcs_bicgstab_r(&mcs_apply_spmat,A,b,x,work,A->r_len,tol,0);
 }
 
 
@@ -120,10 +198,104 @@ void mcs_alloc_spmat(mcs_spmat** A,
     (*A)->nnz = nnz;
     (*A)->r_len = numRow;
     (*A)->c_len = numCol;
+    (*A)->pat = NULL;
+    MCS_PROF_COUNT(MCS_PROF_ALLOCS,4);
 }
 
 
 void mcs_free_spmat(mcs_spmat** A){
+    mcs_sppat* P = (*A)->pat;
+    long ref;
+    if(P == NULL){
+        free((*A)->c);
+        free((*A)->r);
+    }else{
+        #pragma omp critical(mcs_sppat_ref)
+        {
+            ref = --(P->ref);
+        }
+        if(ref == 0){
+            free(P->c);
+            free(P->r);
+            free(P);
+        }
+    }
+    free((*A)->dat);
+    free(*A);
+}
+
+
+void mcs_spmat_share(mcs_spmat* A, mcs_spmat** B){
+    long k;
+    #pragma omp critical(mcs_sppat_ref)
+    {
+        if(A->pat == NULL){
+            A->pat = (mcs_sppat*) malloc(sizeof(mcs_sppat));
+            A->pat->r = A->r;
+            A->pat->c = A->c;
+            A->pat->nnz = A->nnz;
+            A->pat->r_len = A->r_len;
+            A->pat->c_len = A->c_len;
+            A->pat->ref = 1;
+        }
+        A->pat->ref++;
+    }
+    *B = (mcs_spmat*) malloc(sizeof(mcs_spmat));
+    **B = *A;
+    (*B)->dat = (double*) malloc(sizeof(double)*(A->nnz+1));
+    MCS_PROF_COUNT(MCS_PROF_ALLOCS,2);
+    for(k=0;k<A->nnz;k++){
+        (*B)->dat[k] = 0.0;
+    }
+}
+
+
+void mcs_spmat_view(mcs_spmat* A, double* dat, mcs_spmat* V){
+    *V = *A;
+    V->dat = dat;
+}
+
+
+void mcs_spmat_zero(mcs_spmat* A){
+    long k;
+    for(k=0;k<A->nnz;k++){
+        A->dat[k] = 0.0;
+    }
+}
+
+
+void mcs_spmat_scale(double alpha, mcs_spmat* A){
+    long k;
+    for(k=0;k<A->nnz;k++){
+        A->dat[k] *= alpha;
+    }
+}
+
+
+void mcs_spmat_axpy(double alpha, mcs_spmat* A, mcs_spmat* B){
+    long k;
+    for(k=0;k<A->nnz;k++){
+        B->dat[k] += alpha*A->dat[k];
+    }
+}
+
+
+void mcs_alloc_zspmat(mcs_zspmat** A,
+                      long nnz,
+                      long numRow,
+                      long numCol){
+    *A = (mcs_zspmat*) malloc(sizeof(mcs_zspmat));
+    (*A)->dat = (double _Complex*) malloc(sizeof(double _Complex)*nnz);
+    MCS_PROF_COUNT(MCS_PROF_ALLOCS,4);
+    (*A)->r = (long*) malloc(sizeof(long)*nnz);
+    (*A)->c = (long*) malloc(sizeof(long)*nnz);
+    (*A)->nnz = nnz;
+    (*A)->r_len = numRow;
+    (*A)->c_len = numCol;
+}
+
+
+void mcs_free_zspmat(mcs_zspmat** A){
     free((*A)->c);
     free((*A)->r);
     free((*A)->dat);
@@ -16,9 +16,27 @@
  */
 #include<stdlib.h>
 #include"math.h"
+#include"../profiling/profiling.h"
+
+/*
+ * A sparsity pattern shared by several sparse matrices. The row and column
+ * arrays are never changed once shared, and are freed with the last
+ * matrix which uses them.
+ */
+
+typedef struct _mcs_sppat{
+    long* r;
+    long* c;
+    long nnz;
+    long r_len;
+    long c_len;
+    long ref;   /*Number of matrices using this pattern*/
+} mcs_sppat;
 
 /*
  * A struct for Coordinate array format sparse matrix:
+ * If pat is NULL then r and c belong to this matrix alone. Otherwise
+ * r and c are those of the shared pattern pat.
  */
 
 typedef struct _mcs_spmat{
@@ -28,8 +46,22 @@ typedef struct _mcs_spmat{
     long nnz;
     long r_len;
     long c_len;
+    mcs_sppat* pat;
 } mcs_spmat;
 
+/*
+ * A struct for Coordinate array format sparse matrix with complex entries:
+ */
+
+typedef struct _mcs_zspmat{
+    double _Complex* dat;
+    long* r;
+    long* c;
+    long nnz;
+    long r_len;
+    long c_len;
+} mcs_zspmat;
+
 /*
  * Function Declarations:
  */
@@ -46,6 +78,22 @@ typedef struct _mcs_spmat{
  */
 void mcs_spmatvec(char tran, mcs_spmat* A, double* x, double* y);
 
+/*
+ * Do complex matrix-vector multiplication of the form
+ * y = A * x
+ * or
+ * y = A^(T) * x
+ * or
+ * y = A^(H) * x
+ * Where A is sparse. Output stored in y.
+ *
+ * If tran = 't' or 'T' then y = A^(T) * x is computed. If tran = 'h' or 'H'
+ * then the conjugate transpose y = A^(H) * x is computed.
+ * Otherwise y = A * x is computed.
+ */
+void mcs_zspmatvec(char tran, mcs_zspmat* A, double _Complex* x,
+                                             double _Complex* y);
+
 
 
 /*
@@ -72,6 +120,24 @@ void mcs_bicgstab(void (*L)(double*,double*),
                         long N,
                         double tol);
 
+/*
+ * Reentrant version of mcs_bicgstab. The linear map is computed by
+ * L(data,v,w), so any state it needs is passed through data rather than
+ * through global variables.
+ *
+ * If max_iter > 0 then at most max_iter iterations are taken.
+ *
+ * Returns the number of iterations, or -1 if max_iter was reached.
+ */
+long mcs_bicgstab_r(void (*L)(void*,double*,double*),
+                    void* data,
+                    double* b,
+                    double* x,
+                    double* work,
+                    long N,
+                    double tol,
+                    long max_iter);
+
 /*
  * For the sparse matrix A, solve the system of equations A*x = b for a given b
  * using the stabilized biconjugate gradient method.
@@ -101,8 +167,58 @@ void mcs_alloc_spmat(mcs_spmat** A,
                      long numCol);
 
 /*
- * Free a sparse matrix struct. Calls 4 frees.
+ * Free a sparse matrix struct. Calls 4 frees. If the pattern of A is
+ * shared, then the row and column arrays are only freed along with the
+ * last matrix using them.
  */
 void mcs_free_spmat(mcs_spmat** A);
 
+/*
+ * Allocate the sparse matrix B with the same sparsity pattern as A and its
+ * own values, which are set to zero. The row and column arrays are not
+ * copied, A and B point to the same ones. Calls 2 mallocs, plus 1 the
+ * first time the pattern of A is shared.
+ *
+ * B is freed with mcs_free_spmat as usual. A may be freed before B.
+ */
+void mcs_spmat_share(mcs_spmat* A, mcs_spmat** B);
+
+/*
+ * Fill the struct V with a view of the pattern of A and the values dat,
+ * which has A->nnz entries. Nothing is allocated, so this is cheap enough
+ * to do inside a loop, and every thread may keep its own view of one
+ * pattern. V is valid while A is, and must not be given to mcs_free_spmat.
+ */
+void mcs_spmat_view(mcs_spmat* A, double* dat, mcs_spmat* V);
+
+/*
+ * Set all values of A to zero, keeping its sparsity pattern.
+ */
+void mcs_spmat_zero(mcs_spmat* A);
+
+/*
+ * Multiply all values of A by alpha, keeping its sparsity pattern.
+ */
+void mcs_spmat_scale(double alpha, mcs_spmat* A);
+
+/*
+ * Compute B = B + alpha*A in place, where A and B have the same sparsity
+ * pattern, such as matrices made by mcs_spmat_share or mcs_spmat_view.
+ */
+void mcs_spmat_axpy(double alpha, mcs_spmat* A, mcs_spmat* B);
+
+/*
+ * Allocate a complex sparse matrix struct without initializing the entries
+ * of the row or column arrays. Calls 4 mallocs.
+ */
+void mcs_alloc_zspmat(mcs_zspmat** A,
+                      long nnz,
+                      long numRow,
+                      long numCol);
+
+/*
+ * Free a complex sparse matrix struct. Calls 4 frees.
+ */
+void mcs_free_zspmat(mcs_zspmat** A);
+
 #endif
@@ -0,0 +1,478 @@
+/*
+ * Implementation for:
+ * Tuned sparse matrix-vector products by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "spmv_plan.h"
+
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Row length and row of one row, for sorting the rows of a sell window.
+ */
+typedef struct _mcs_spmv_row{
+    long len;
+    long row;
+} mcs_spmv_row;
+
+/*
+ * Compressed rows of the pattern of A with repeated coordinates merged.
+ * rp has A->r_len+1 entries, ci has one entry per distinct coordinate,
+ * and slot[k] is the position in ci of coordinate entry k. Columns are
+ * sorted within each row.
+ */
+void mcs_spmv_csr_pattern(mcs_spmat* A, long** rp, long** ci, long** slot);
+
+/*
+ * Fill perm with the rows of a sell format sorted by length within each
+ * window, and ptr with the start of every chunk. perm has room for every
+ * chunk, and lanes past the last row are -1. Returns the stored length.
+ */
+long mcs_spmv_sell_perm(long n, long* rp, long* perm, long* ptr);
+
+/*
+ * Fill ptr with the first block of every block row of a bcsr format.
+ * If idx is not NULL, also fill idx with the block columns, and write
+ * to pos[s] the position in val of entry s of the compressed rows.
+ * Returns the number of blocks.
+ */
+long mcs_spmv_bcsr_blocks(long n, long m, long* rp, long* ci, long* ptr,
+                          long* idx, long* pos);
+
+/*
+ * Sort rows by decreasing length, keeping the row order of equal lengths.
+ */
+int mcs_spmv_row_cmp(const void* a, const void* b);
+
+/*
+ * Fill P with the storage of A in the format fmt, which is not a choice.
+ */
+void mcs_spmv_build(mcs_spmat* A, enum MCS_SPMV_FORMAT fmt, mcs_spmv* P);
+
+/*
+ * Compute the rows of y = A*x in rows lo to hi-1 for csr, in chunks lo to
+ * hi-1 for sell, or in block rows lo to hi-1 for bcsr. coo computes all
+ * of y. x is already padded for bcsr.
+ */
+void mcs_spmv_range(mcs_spmv* P, double* x, double* y, long lo, long hi);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Names of the formats, indexed by format.
+ */
+static const char* mcs_spmv_names[MCS_SPMV_NUM_FORMAT] = {
+    "coo", "csr", "sell", "bcsr"
+};
+
+/*
+ * Function Implementations:
+ */
+
+void mcs_spmv_csr_pattern(mcs_spmat* A, long** rp, long** ci, long** slot){
+    long n = A->r_len, m = A->c_len;
+    long *cnt, *by_col, *by_row;
+    long i, k, p, s;
+    //two stable bucket passes sort the entries by row, then column
+    cnt = (long*) calloc(((n > m) ? n : m)+1,sizeof(long));
+    by_col = (long*) malloc(sizeof(long)*(A->nnz+1));
+    by_row = (long*) malloc(sizeof(long)*(A->nnz+1));
+    for(k=0;k<A->nnz;k++){
+        cnt[A->c[k]+1]++;
+    }
+    for(i=0;i<m;i++){
+        cnt[i+1] += cnt[i];
+    }
+    for(k=0;k<A->nnz;k++){
+        by_col[cnt[A->c[k]]++] = k;
+    }
+    for(i=0;i<=n;i++){
+        cnt[i] = 0;
+    }
+    for(k=0;k<A->nnz;k++){
+        cnt[A->r[k]+1]++;
+    }
+    for(i=0;i<n;i++){
+        cnt[i+1] += cnt[i];
+    }
+    for(p=0;p<A->nnz;p++){
+        k = by_col[p];
+        by_row[cnt[A->r[k]]++] = k;
+    }
+    *rp = (long*) malloc(sizeof(long)*(n+1));
+    *ci = (long*) malloc(sizeof(long)*(A->nnz+1));
+    *slot = (long*) malloc(sizeof(long)*(A->nnz+1));
+    (*rp)[0] = 0;
+    s = -1;
+    p = 0;
+    for(i=0;i<n;i++){
+        for(;p<A->nnz && A->r[by_row[p]] == i;p++){
+            k = by_row[p];
+            if(s < (*rp)[i] || (*ci)[s] != A->c[k]){
+                s++;
+                (*ci)[s] = A->c[k];
+            }
+            (*slot)[k] = s;
+        }
+        (*rp)[i+1] = s+1;
+    }
+    free(by_row);
+    free(by_col);
+    free(cnt);
+}
+
+int mcs_spmv_row_cmp(const void* a, const void* b){
+    const mcs_spmv_row* u = (const mcs_spmv_row*) a;
+    const mcs_spmv_row* v = (const mcs_spmv_row*) b;
+    if(u->len != v->len){
+        return (u->len > v->len) ? -1 : 1;
+    }
+    return (u->row > v->row) - (u->row < v->row);
+}
+
+long mcs_spmv_sell_perm(long n, long* rp, long* perm, long* ptr){
+    long num_chunk = (n+MCS_SELL_C-1)/MCS_SELL_C;
+    long i, w, h, l, len, width;
+    mcs_spmv_row* rows;
+    rows = (mcs_spmv_row*) malloc(sizeof(mcs_spmv_row)*(MCS_SELL_SIGMA+1));
+    for(w=0;w<n;w+=MCS_SELL_SIGMA){
+        len = (n-w < MCS_SELL_SIGMA) ? n-w : MCS_SELL_SIGMA;
+        for(i=0;i<len;i++){
+            rows[i].len = rp[w+i+1]-rp[w+i];
+            rows[i].row = w+i;
+        }
+        qsort(rows,len,sizeof(mcs_spmv_row),mcs_spmv_row_cmp);
+        for(i=0;i<len;i++){
+            perm[w+i] = rows[i].row;
+        }
+    }
+    for(i=n;i<num_chunk*MCS_SELL_C;i++){
+        perm[i] = -1;
+    }
+    ptr[0] = 0;
+    for(h=0;h<num_chunk;h++){
+        width = 0;
+        for(l=0;l<MCS_SELL_C && h*MCS_SELL_C+l<n;l++){
+            i = perm[h*MCS_SELL_C+l];
+            if(rp[i+1]-rp[i] > width){
+                width = rp[i+1]-rp[i];
+            }
+        }
+        ptr[h+1] = ptr[h] + MCS_SELL_C*width;
+    }
+    free(rows);
+    return ptr[num_chunk];
+}
+
+long mcs_spmv_bcsr_blocks(long n, long m, long* rp, long* ci, long* ptr,
+                          long* idx, long* pos){
+    long nb = (n+1)/2, mb = (m+1)/2;
+    long *mark, *blk;
+    long I, i, s, J, num_blk = 0;
+    mark = (long*) malloc(sizeof(long)*(mb+1));
+    blk = (long*) malloc(sizeof(long)*(mb+1));
+    for(J=0;J<mb;J++){
+        mark[J] = -1;
+    }
+    ptr[0] = 0;
+    for(I=0;I<nb;I++){
+        for(i=2*I;i<2*I+2 && i<n;i++){
+            for(s=rp[i];s<rp[i+1];s++){
+                J = ci[s]/2;
+                if(mark[J] != I){
+                    mark[J] = I;
+                    blk[J] = num_blk++;
+                    if(idx != NULL){
+                        idx[blk[J]] = J;
+                    }
+                }
+                if(pos != NULL){
+                    pos[s] = 4*blk[J] + 2*(i%2) + ci[s]%2;
+                }
+            }
+        }
+        ptr[I+1] = num_blk;
+    }
+    free(blk);
+    free(mark);
+    return num_blk;
+}
+
+void mcs_spmv_build(mcs_spmat* A, enum MCS_SPMV_FORMAT fmt, mcs_spmv* P){
+    long *rp, *ci, *slot, *pos = NULL;
+    long n = A->r_len, i, k, q, h, l, num_chunk;
+    P->fmt = fmt;
+    P->n = n;
+    P->m = A->c_len;
+    P->nnz = A->nnz;
+    P->map = (long*) malloc(sizeof(long)*(A->nnz+1));
+    P->ptr = NULL;
+    P->perm = NULL;
+    P->x_pad = NULL;
+    if(fmt == MCS_SPMV_COO){
+        P->len = A->nnz;
+        P->perm = (long*) malloc(sizeof(long)*(A->nnz+1));
+        P->idx = (long*) malloc(sizeof(long)*(A->nnz+1));
+        for(k=0;k<A->nnz;k++){
+            P->map[k] = k;
+            P->perm[k] = A->r[k];
+            P->idx[k] = A->c[k];
+        }
+        P->val = (double*) malloc(sizeof(double)*(P->len+1));
+        return;
+    }
+    mcs_spmv_csr_pattern(A,&rp,&ci,&slot);
+    if(fmt == MCS_SPMV_CSR){
+        P->len = rp[n];
+        P->ptr = rp;
+        P->idx = ci;
+        for(k=0;k<A->nnz;k++){
+            P->map[k] = slot[k];
+        }
+        P->val = (double*) malloc(sizeof(double)*(P->len+1));
+        free(slot);
+        return;
+    }
+    pos = (long*) malloc(sizeof(long)*(rp[n]+1));
+    if(fmt == MCS_SPMV_SELL){
+        num_chunk = (n+MCS_SELL_C-1)/MCS_SELL_C;
+        P->perm = (long*) malloc(sizeof(long)*(num_chunk*MCS_SELL_C+1));
+        P->ptr = (long*) malloc(sizeof(long)*(num_chunk+1));
+        P->len = mcs_spmv_sell_perm(n,rp,P->perm,P->ptr);
+        //padding multiplies a zero by the first entry of x
+        P->idx = (long*) calloc(P->len+1,sizeof(long));
+        for(h=0;h<num_chunk;h++){
+            for(l=0;l<MCS_SELL_C && h*MCS_SELL_C+l<n;l++){
+                i = P->perm[h*MCS_SELL_C+l];
+                for(q=0;q<rp[i+1]-rp[i];q++){
+                    pos[rp[i]+q] = P->ptr[h] + q*MCS_SELL_C + l;
+                    P->idx[pos[rp[i]+q]] = ci[rp[i]+q];
+                }
+            }
+        }
+    }else{
+        P->ptr = (long*) malloc(sizeof(long)*((n+1)/2+1));
+        P->len = 4*mcs_spmv_bcsr_blocks(n,P->m,rp,ci,P->ptr,NULL,NULL);
+        P->idx = (long*) malloc(sizeof(long)*(P->len/4+1));
+        mcs_spmv_bcsr_blocks(n,P->m,rp,ci,P->ptr,P->idx,pos);
+        if(P->m % 2 == 1){
+            P->x_pad = (double*) malloc(sizeof(double)*(P->m+1));
+            P->x_pad[P->m] = 0.0;
+        }
+    }
+    for(k=0;k<A->nnz;k++){
+        P->map[k] = pos[slot[k]];
+    }
+    P->val = (double*) malloc(sizeof(double)*(P->len+1));
+    free(pos);
+    free(slot);
+    free(ci);
+    free(rp);
+}
+
+enum MCS_SPMV_FORMAT mcs_spmv_choose(mcs_spmat* A){
+    long *rp, *ci, *slot, *perm, *ptr;
+    long n = A->r_len, num_chunk = (n+MCS_SELL_C-1)/MCS_SELL_C;
+    double b_csr, b_sell, b_bcsr;
+    if(n == 0 || A->c_len == 0 || A->nnz == 0){
+        return MCS_SPMV_CSR;
+    }
+    mcs_spmv_csr_pattern(A,&rp,&ci,&slot);
+    perm = (long*) malloc(sizeof(long)*(num_chunk*MCS_SELL_C+1));
+    //ptr is long enough for both the chunks and the block rows
+    ptr = (long*) malloc(sizeof(long)*(n+2));
+    //bytes of values, indices, and row pointers read by one product
+    b_csr = 16.0*rp[n] + 8.0*n;
+    b_sell = 16.0*mcs_spmv_sell_perm(n,rp,perm,ptr) + 8.0*(n+num_chunk);
+    b_bcsr = 40.0*mcs_spmv_bcsr_blocks(n,A->c_len,rp,ci,ptr,NULL,NULL)
+             + 4.0*n;
+    free(ptr);
+    free(perm);
+    free(slot);
+    free(ci);
+    free(rp);
+    if(b_bcsr < MCS_SPMV_GAIN*b_csr && b_bcsr <= b_sell){
+        return MCS_SPMV_BCSR;
+    }
+    if(b_sell < MCS_SPMV_GAIN*b_csr){
+        return MCS_SPMV_SELL;
+    }
+    return MCS_SPMV_CSR;
+}
+
+void mcs_alloc_spmv(mcs_spmat* A, enum MCS_SPMV_FORMAT fmt, mcs_spmv** P){
+    mcs_spmv* Q;
+    double *x, *y;
+    double t0, t, t_best = -1.0;
+    long i, k;
+    int f;
+    if(fmt == MCS_SPMV_AUTO){
+        fmt = mcs_spmv_choose(A);
+    }
+    if(fmt != MCS_SPMV_TRIAL){
+        *P = (mcs_spmv*) malloc(sizeof(mcs_spmv));
+        mcs_spmv_build(A,fmt,*P);
+        mcs_spmv_load(*P,A->dat);
+        return;
+    }
+    //time every format with the values of A and keep the fastest
+    x = (double*) malloc(sizeof(double)*(A->c_len+1));
+    y = (double*) malloc(sizeof(double)*(A->r_len+1));
+    for(i=0;i<A->c_len;i++){
+        x[i] = 1.0;
+    }
+    *P = NULL;
+    for(f=0;f<MCS_SPMV_NUM_FORMAT;f++){
+        mcs_alloc_spmv(A,(enum MCS_SPMV_FORMAT) f,&Q);
+        mcs_spmv_apply(Q,x,y);
+        t0 = mcs_prof_now();
+        for(k=0;k<MCS_SPMV_TRIAL_REPS;k++){
+            mcs_spmv_apply(Q,x,y);
+        }
+        t = mcs_prof_now() - t0;
+        if(t_best < 0.0 || t < t_best){
+            t_best = t;
+            if(*P != NULL){
+                mcs_free_spmv(P);
+            }
+            *P = Q;
+        }else{
+            mcs_free_spmv(&Q);
+        }
+    }
+    free(y);
+    free(x);
+}
+
+void mcs_free_spmv(mcs_spmv** P){
+    free((*P)->map);
+    free((*P)->val);
+    free((*P)->ptr);
+    free((*P)->idx);
+    free((*P)->perm);
+    free((*P)->x_pad);
+    free(*P);
+    *P = NULL;
+}
+
+void mcs_spmv_load(mcs_spmv* P, double* dat){
+    long k;
+    for(k=0;k<P->len;k++){
+        P->val[k] = 0.0;
+    }
+    for(k=0;k<P->nnz;k++){
+        P->val[P->map[k]] += dat[k];
+    }
+}
+
+void mcs_spmv_range(mcs_spmv* P, double* x, double* y, long lo, long hi){
+    long i, k, h, l, J;
+    double s, y0, y1;
+    double lane[MCS_SELL_C];
+    double* b;
+    switch(P->fmt){
+        case MCS_SPMV_CSR:
+            for(i=lo;i<hi;i++){
+                s = 0.0;
+                for(k=P->ptr[i];k<P->ptr[i+1];k++){
+                    s += P->val[k]*x[P->idx[k]];
+                }
+                y[i] = s;
+            }
+            break;
+        case MCS_SPMV_SELL:
+            for(h=lo;h<hi;h++){
+                for(l=0;l<MCS_SELL_C;l++){
+                    lane[l] = 0.0;
+                }
+                for(k=P->ptr[h];k<P->ptr[h+1];k+=MCS_SELL_C){
+                    for(l=0;l<MCS_SELL_C;l++){
+                        lane[l] += P->val[k+l]*x[P->idx[k+l]];
+                    }
+                }
+                for(l=0;l<MCS_SELL_C;l++){
+                    i = P->perm[h*MCS_SELL_C+l];
+                    if(i >= 0){
+                        y[i] = lane[l];
+                    }
+                }
+            }
+            break;
+        case MCS_SPMV_BCSR:
+            for(i=lo;i<hi;i++){
+                y0 = 0.0;
+                y1 = 0.0;
+                for(k=P->ptr[i];k<P->ptr[i+1];k++){
+                    b = &(P->val[4*k]);
+                    J = 2*P->idx[k];
+                    y0 += b[0]*x[J] + b[1]*x[J+1];
+                    y1 += b[2]*x[J] + b[3]*x[J+1];
+                }
+                y[2*i] = y0;
+                if(2*i+1 < P->n){
+                    y[2*i+1] = y1;
+                }
+            }
+            break;
+        default:
+            for(i=0;i<P->n;i++){
+                y[i] = 0.0;
+            }
+            for(k=0;k<P->nnz;k++){
+                y[P->perm[k]] += P->val[k]*x[P->idx[k]];
+            }
+            break;
+    }
+}
+
+void mcs_spmv_apply(mcs_spmv* P, double* x, double* y){
+    long i, t, num_unit;
+    MCS_PROF_START(t_mv);
+    if(P->x_pad != NULL){
+        for(i=0;i<P->m;i++){
+            P->x_pad[i] = x[i];
+        }
+        x = P->x_pad;
+    }
+    switch(P->fmt){
+        case MCS_SPMV_CSR:
+            num_unit = P->n;
+            break;
+        case MCS_SPMV_SELL:
+            num_unit = (P->n+MCS_SELL_C-1)/MCS_SELL_C;
+            break;
+        case MCS_SPMV_BCSR:
+            num_unit = (P->n+1)/2;
+            break;
+        default:
+            //the coordinate format scatters into y, so runs serially
+            num_unit = 0;
+            break;
+    }
+    if(num_unit == 0 || P->n < MCS_SPMV_OMP_ROWS){
+        mcs_spmv_range(P,x,y,0,num_unit);
+    }else{
+        #pragma omp parallel for schedule(static)
+        for(t=0;t<MCS_SPMV_SLICES;t++){
+            mcs_spmv_range(P,x,y,(t*num_unit)/MCS_SPMV_SLICES,
+                                 ((t+1)*num_unit)/MCS_SPMV_SLICES);
+        }
+    }
+    MCS_PROF_COUNT(MCS_PROF_MATVECS,1);
+    MCS_PROF_STOP(MCS_PROF_SPMATVEC,t_mv);
+}
+
+const char* mcs_spmv_name(enum MCS_SPMV_FORMAT fmt){
+    if(fmt < 0 || fmt >= MCS_SPMV_NUM_FORMAT){
+        return "auto";
+    }
+    return mcs_spmv_names[fmt];
+}
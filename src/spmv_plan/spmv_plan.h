@@ -0,0 +1,147 @@
+#ifndef MCS_SPMV_PLAN_H
+#define MCS_SPMV_PLAN_H
+
+/*
+ * Tuned sparse matrix-vector products by Bram Rodgers.
+ *
+ * The coordinate format of mcs_spmat is easy to stamp, but a product with
+ * it scatters into y and cannot run in parallel. A plan copies the matrix
+ * into the storage format which suits its structure best:
+ * ->coo:   the coordinate format itself, as in mcs_spmatvec.
+ * ->csr:   compressed rows, with repeated coordinates summed.
+ * ->sell:  sliced ELLPACK (SELL-C-sigma). Rows are sorted by length
+ *          within windows of MCS_SELL_SIGMA rows, then stored in chunks
+ *          of MCS_SELL_C rows padded to the longest row of the chunk.
+ *          The rows of a chunk are multiplied together, column by column.
+ * ->bcsr:  compressed rows of dense 2 by 2 blocks, which halves the
+ *          column indices read when entries come in small dense groups,
+ *          such as the stamps of transistors.
+ *
+ * The format is either chosen from the row lengths of the matrix, or by
+ * timing a few products in every format. The plan keeps its format for
+ * the rest of the run, and new values with the same sparsity pattern are
+ * copied in with mcs_spmv_load, so the choice is paid for once.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../profiling/profiling.h"
+
+/*
+ * Rows per chunk and rows per sorting window of the sell format.
+ */
+#define MCS_SELL_C      8
+#define MCS_SELL_SIGMA  256
+
+/*
+ * MCS_SPMV_AUTO estimates the bytes each format reads per product from
+ * the row lengths and block structure, and only picks sell or bcsr over
+ * csr if it reads less than MCS_SPMV_GAIN times as much.
+ */
+#define MCS_SPMV_GAIN       0.9
+
+/*
+ * Fewest rows for which products run in parallel, and the number of
+ * equal slices of rows they are then split into.
+ */
+#define MCS_SPMV_OMP_ROWS   10000
+#define MCS_SPMV_SLICES     64
+
+/*
+ * Products timed per format by MCS_SPMV_TRIAL.
+ */
+#define MCS_SPMV_TRIAL_REPS 5
+
+/*
+ * Object and Struct Definitions:
+ */
+
+enum MCS_SPMV_FORMAT{
+    MCS_SPMV_AUTO   = -2,   /*Choose from the row lengths*/
+    MCS_SPMV_TRIAL  = -1,   /*Choose by timing every format*/
+    MCS_SPMV_COO    =  0,
+    MCS_SPMV_CSR    =  1,
+    MCS_SPMV_SELL   =  2,
+    MCS_SPMV_BCSR   =  3
+};
+
+/*
+ * Number of storage formats, which are numbered from 0.
+ */
+#define MCS_SPMV_NUM_FORMAT 4
+
+/*
+ * A matrix stored for fast products y = A*x. The meaning of ptr, idx,
+ * and perm depends on the format:
+ * ->coo:   perm and idx are the row and column of each entry.
+ * ->csr:   row i is val[ptr[i]] to val[ptr[i+1]-1], with columns idx.
+ * ->sell:  chunk h is val[ptr[h]] to val[ptr[h+1]-1], column by column,
+ *          with columns idx. Row perm[h*MCS_SELL_C+l] is lane l.
+ * ->bcsr:  block row I is blocks ptr[I] to ptr[I+1]-1, where block k
+ *          is val[4*k] to val[4*k+3] in row order, at block column idx[k].
+ */
+typedef struct _mcs_spmv{
+    enum MCS_SPMV_FORMAT fmt;
+    long n;         /*Number of rows*/
+    long m;         /*Number of columns*/
+    long nnz;       /*Number of coordinate entries of the source matrix*/
+    long len;       /*Number of entries of val, including padding*/
+    long* map;      /*Coordinate entry k is summed into val[map[k]]*/
+    double* val;
+    long* ptr;
+    long* idx;
+    long* perm;
+    double* x_pad;  /*bcsr copy of x with an even length, or NULL*/
+} mcs_spmv;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Build a plan for products with A in the format fmt, or in the format
+ * chosen by MCS_SPMV_AUTO or MCS_SPMV_TRIAL. The values of A are loaded,
+ * and A is not referenced after this returns.
+ */
+void mcs_alloc_spmv(mcs_spmat* A, enum MCS_SPMV_FORMAT fmt, mcs_spmv** P);
+
+/*
+ * Free a plan.
+ */
+void mcs_free_spmv(mcs_spmv** P);
+
+/*
+ * Load new values into P. dat has P->nnz entries, in the coordinate
+ * order of the matrix P was built from.
+ */
+void mcs_spmv_load(mcs_spmv* P, double* dat);
+
+/*
+ * y = A*x, where A is the matrix loaded into P. Large products run in
+ * parallel. Products with one plan must not run at the same time from
+ * different threads, since bcsr pads x inside P.
+ */
+void mcs_spmv_apply(mcs_spmv* P, double* x, double* y);
+
+/*
+ * Return the format MCS_SPMV_AUTO picks for A.
+ */
+enum MCS_SPMV_FORMAT mcs_spmv_choose(mcs_spmat* A);
+
+/*
+ * Return the name of the format fmt, such as "sell". The string is static
+ * and must not be freed.
+ */
+const char* mcs_spmv_name(enum MCS_SPMV_FORMAT fmt);
+
+#endif
@@ -0,0 +1,440 @@
+/*
+ * Implementation for:
+ * Netlist specialized stamping code by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "stamp_codegen.h"
+#include<string.h>
+#include<unistd.h>
+#include<dlfcn.h>
+#include<sys/stat.h>
+#include<sys/wait.h>
+
+/*
+ * Text of the device models of mna_system.h, with every parameter macro
+ * replaced by its value, for the generated source.
+ */
+#define MCS_CODEGEN_QUOTE(...)  #__VA_ARGS__
+#define MCS_CODEGEN_XQUOTE(...) MCS_CODEGEN_QUOTE(__VA_ARGS__)
+#define MCS_CODEGEN_MODELS      MCS_CODEGEN_XQUOTE(MCS_MNA_MODELS)
+
+/*
+ * Locally used helper functions:
+ */
+
+/*
+ * Fold len bytes at p into the FNV-1a hash h and return it.
+ */
+unsigned long mcs_codegen_fnv(unsigned long h, const void* p, size_t len);
+
+/*
+ * Write the C expression for the voltage of unknown i into s.
+ */
+void mcs_codegen_volt(char* s, long i);
+
+/*
+ * Write one entry of G, skipping those in a ground row or column
+ * as mcs_mna_put does.
+ */
+void mcs_codegen_put(FILE* out, long row, long col, const char* v, long* nz);
+
+/*
+ * Write the stamping code of the element at position k of M->dev.
+ * Returns 0, or 1 if the element has no generated stamp.
+ */
+int mcs_codegen_element(FILE* out, mcs_mna* M, long k);
+
+/*
+ * dlopen the shared object at path and check that it was generated for
+ * a circuit with the hash and sizes of P->M. Returns 0 on success.
+ */
+int mcs_codegen_load(mcs_codegen* P, const char* path);
+
+/*
+ * Return 0 if path is a directory, or a regular file if is_dir is 0,
+ * which is owned by the user and which the group and others may not
+ * write. Symbolic links are refused.
+ */
+int mcs_codegen_private(const char* path, int is_dir);
+
+/*
+ * Write the cache directory into dir, which has MCS_CODEGEN_DIR_LEN
+ * bytes, creating it with mode 0700 if it does not exist. Returns 0 if
+ * it is private to the user.
+ */
+int mcs_codegen_dir(char* dir);
+
+/*
+ * Write the source of P->M into dir and compile it into the shared
+ * object path. Both are created with mkstemp and the object is renamed
+ * to path when done, so processes sharing a cache never load a half
+ * written file. Returns 0 on success.
+ */
+int mcs_codegen_compile(mcs_codegen* P, const char* dir, const char* path);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+unsigned long mcs_codegen_fnv(unsigned long h, const void* p, size_t len){
+    const unsigned char* c = (const unsigned char*) p;
+    size_t i;
+    for(i=0;i<len;i++){
+        h ^= (unsigned long) c[i];
+        h *= 1099511628211UL;
+    }
+    return h;
+}
+
+unsigned long mcs_codegen_hash(mcs_mna* M){
+    unsigned long h = 14695981039346656037UL;
+    long k, head[4];
+    char sym[2];
+    double par[9] = {MCS_VT, MCS_EXP_LIM, MCS_DIODE_IS,
+                     MCS_BJT_IS, MCS_BJT_BF, MCS_BJT_BR,
+                     MCS_MOS_K, MCS_MOS_VTH, MCS_MOS_LAMBDA};
+    head[0] = MCS_CODEGEN_VERSION;
+    head[1] = M->num_dev;
+    head[2] = M->num_nodes;
+    head[3] = M->dim;
+    h = mcs_codegen_fnv(h,head,sizeof(head));
+    //a cached object is stale once the device models change
+    h = mcs_codegen_fnv(h,par,sizeof(par));
+    h = mcs_codegen_fnv(h,MCS_CODEGEN_MODELS,strlen(MCS_CODEGEN_MODELS));
+    for(k=0;k<M->num_dev;k++){
+        sym[0] = M->dev[k]->elem.symbol;
+        sym[1] = (sym[0] == 'Q' || sym[0] == 'M') ? M->dev[k]->QN.dope : 0;
+        h = mcs_codegen_fnv(h,sym,sizeof(sym));
+        h = mcs_codegen_fnv(h,&(M->term[3*k]),3*sizeof(long));
+        h = mcs_codegen_fnv(h,&(M->branch[k]),sizeof(long));
+    }
+    return h;
+}
+
+void mcs_codegen_volt(char* s, long i){
+    if(i < 0){
+        strcpy(s,"0.0");
+    }else{
+        sprintf(s,"x[%ld]",i);
+    }
+}
+
+void mcs_codegen_put(FILE* out, long row, long col, const char* v, long* nz){
+    if(row < 0 || col < 0){
+        return;
+    }
+    fprintf(out,"    G[%ld] = %s;\n",*nz,v);
+    (*nz)++;
+}
+
+int mcs_codegen_element(FILE* out, mcs_mna* M, long k){
+    long t, u, nz = M->G_off[k];
+    long* term = &(M->term[3*k]);
+    long p = term[0], n = term[1], br = M->branch[k];
+    char v[3][32], J[16];
+    const char* s;
+    for(t=0;t<3;t++){
+        mcs_codegen_volt(v[t],term[t]);
+    }
+    switch(M->dev[k]->elem.symbol){
+        case 'V':
+            mcs_codegen_put(out,p,br,"1.0",&nz);
+            mcs_codegen_put(out,n,br,"-1.0",&nz);
+            mcs_codegen_put(out,br,p,"1.0",&nz);
+            mcs_codegen_put(out,br,n,"-1.0",&nz);
+            fprintf(out,"    b[%ld] += val[%ld];\n",br,k);
+            break;
+        case 'I':
+            if(p >= 0){
+                fprintf(out,"    b[%ld] -= val[%ld];\n",p,k);
+            }
+            if(n >= 0){
+                fprintf(out,"    b[%ld] += val[%ld];\n",n,k);
+            }
+            break;
+        case 'R':
+            fprintf(out,"    g = 1.0/val[%ld];\n",k);
+            mcs_codegen_put(out,p,p,"g",&nz);
+            mcs_codegen_put(out,p,n,"-g",&nz);
+            mcs_codegen_put(out,n,p,"-g",&nz);
+            mcs_codegen_put(out,n,n,"g",&nz);
+            break;
+        case 'C':
+            break;
+        case 'L':
+            mcs_codegen_put(out,p,br,"1.0",&nz);
+            mcs_codegen_put(out,n,br,"-1.0",&nz);
+            mcs_codegen_put(out,br,p,"1.0",&nz);
+            mcs_codegen_put(out,br,n,"-1.0",&nz);
+            break;
+        case 'D':
+            fprintf(out,"    vd = %s - %s;\n",v[0],v[1]);
+            fprintf(out,"    mcs_mna_junction(MCS_DIODE_IS,vd,&id,&g);\n");
+            mcs_codegen_put(out,p,p,"g",&nz);
+            mcs_codegen_put(out,p,n,"-g",&nz);
+            mcs_codegen_put(out,n,p,"-g",&nz);
+            mcs_codegen_put(out,n,n,"g",&nz);
+            fprintf(out,"    id -= g*vd;\n");
+            if(p >= 0){
+                fprintf(out,"    b[%ld] -= id;\n",p);
+            }
+            if(n >= 0){
+                fprintf(out,"    b[%ld] += id;\n",n);
+            }
+            break;
+        case 'Q':
+            s = (M->dev[k]->QN.dope == 'N') ? "1.0" : "-1.0";
+            fprintf(out,"    v[0] = %s;\n    v[1] = %s;\n    v[2] = %s;\n",
+                        v[0],v[1],v[2]);
+            fprintf(out,"    mcs_mna_bjt(%s,v,cur,J);\n",s);
+            for(t=0;t<3;t++){
+                for(u=0;u<3;u++){
+                    sprintf(J,"J[%ld][%ld]",t,u);
+                    mcs_codegen_put(out,term[t],term[u],J,&nz);
+                    if(term[u] >= 0){
+                        fprintf(out,"    cur[%ld] -= J[%ld][%ld]*v[%ld];\n",
+                                    t,t,u,u);
+                    }
+                }
+                if(term[t] >= 0){
+                    fprintf(out,"    b[%ld] -= cur[%ld];\n",term[t],t);
+                }
+            }
+            break;
+        case 'M':
+            s = (M->dev[k]->MN.dope == 'N') ? "1.0" : "-1.0";
+            fprintf(out,"    v[0] = %s;\n    v[1] = %s;\n    v[2] = %s;\n",
+                        v[0],v[1],v[2]);
+            fprintf(out,"    mcs_mna_mosfet(%s,v,cur,Jm);\n",s);
+            for(t=0;t<2;t++){
+                for(u=0;u<3;u++){
+                    sprintf(J,"Jm[%ld][%ld]",t,u);
+                    mcs_codegen_put(out,term[2*t],term[u],J,&nz);
+                    if(term[u] >= 0){
+                        fprintf(out,"    cur[%ld] -= Jm[%ld][%ld]*v[%ld];\n",
+                                    t,t,u,u);
+                    }
+                }
+                if(term[2*t] >= 0){
+                    fprintf(out,"    b[%ld] -= cur[%ld];\n",term[2*t],t);
+                }
+            }
+            break;
+        default:
+            return 1;
+    }
+    return 0;
+}
+
+int mcs_codegen_write(FILE* out, mcs_mna* M){
+    long k, c, num_chunk;
+    num_chunk = (M->num_dev + MCS_CODEGEN_CHUNK - 1)/MCS_CODEGEN_CHUNK;
+    fprintf(out,"/*\n * Stamping code generated by MicroCircSim for a circuit"
+                " of %ld elements.\n * Do not edit.\n */\n",M->num_dev);
+    fprintf(out,"#include<math.h>\n\n");
+    fprintf(out,"#define MCS_VT          %.17g\n",MCS_VT);
+    fprintf(out,"#define MCS_EXP_LIM     %.17g\n",MCS_EXP_LIM);
+    fprintf(out,"#define MCS_DIODE_IS    %.17g\n",MCS_DIODE_IS);
+    fprintf(out,"#define MCS_BJT_IS      %.17g\n",MCS_BJT_IS);
+    fprintf(out,"#define MCS_BJT_BF      %.17g\n",MCS_BJT_BF);
+    fprintf(out,"#define MCS_BJT_BR      %.17g\n",MCS_BJT_BR);
+    fprintf(out,"#define MCS_MOS_K       %.17g\n",MCS_MOS_K);
+    fprintf(out,"#define MCS_MOS_VTH     %.17g\n",MCS_MOS_VTH);
+    fprintf(out,"#define MCS_MOS_LAMBDA  %.17g\n\n",MCS_MOS_LAMBDA);
+    fprintf(out,"const unsigned long mcs_gen_hash = %luUL;\n",
+                mcs_codegen_hash(M));
+    fprintf(out,"const long mcs_gen_dim = %ld;\n",M->dim);
+    fprintf(out,"const long mcs_gen_nnz_G = %ld;\n\n",M->nnz_G);
+    fprintf(out,"%s\n\n",MCS_CODEGEN_MODELS);
+    for(c=0;c<num_chunk;c++){
+        fprintf(out,"static void mcs_gen_part_%ld(const double* val, "
+                    "const double* x,\n        double* G, double* b){\n",c);
+        fprintf(out,"    double g, vd, id, v[3], cur[3], J[3][3], Jm[2][3];\n");
+        for(k=c*MCS_CODEGEN_CHUNK;
+            k<(c+1)*MCS_CODEGEN_CHUNK && k<M->num_dev;k++){
+            if(mcs_codegen_element(out,M,k)){
+                return 1;
+            }
+        }
+        fprintf(out,"    (void) g; (void) vd; (void) id; (void) v;\n"
+                    "    (void) cur; (void) J; (void) Jm;\n}\n\n");
+    }
+    fprintf(out,"void mcs_gen_stamp_G(const double* val, double gmin, "
+                "const double* x,\n        double* G, double* b){\n");
+    fprintf(out,"    long i;\n");
+    fprintf(out,"    for(i=0;i<%ld;i++){\n        b[i] = 0.0;\n    }\n",
+                M->dim);
+    for(c=0;c<num_chunk;c++){
+        fprintf(out,"    mcs_gen_part_%ld(val,x,G,b);\n",c);
+    }
+    fprintf(out,"    for(i=0;i<%ld;i++){\n        G[%ld+i] = gmin;\n    }\n}\n",
+                M->num_nodes,M->G_off[M->num_dev]);
+    return 0;
+}
+
+int mcs_codegen_load(mcs_codegen* P, const char* path){
+    const unsigned long* h;
+    const long *dim, *nnz;
+    P->handle = dlopen(path,RTLD_NOW | RTLD_LOCAL);
+    if(P->handle == NULL){
+        return 1;
+    }
+    h = (const unsigned long*) dlsym(P->handle,"mcs_gen_hash");
+    dim = (const long*) dlsym(P->handle,"mcs_gen_dim");
+    nnz = (const long*) dlsym(P->handle,"mcs_gen_nnz_G");
+    P->stamp_G = (mcs_mna_gen) dlsym(P->handle,"mcs_gen_stamp_G");
+    if(h == NULL || dim == NULL || nnz == NULL || P->stamp_G == NULL
+       || *h != P->hash || *dim != P->M->dim || *nnz != P->M->nnz_G){
+        dlclose(P->handle);
+        P->handle = NULL;
+        return 1;
+    }
+    return 0;
+}
+
+int mcs_codegen_private(const char* path, int is_dir){
+    struct stat sb;
+    if(lstat(path,&sb) != 0){
+        return 1;
+    }
+    if(is_dir ? !S_ISDIR(sb.st_mode) : !S_ISREG(sb.st_mode)){
+        return 1;
+    }
+    if(sb.st_uid != getuid() || (sb.st_mode & (S_IWGRP | S_IWOTH))){
+        return 1;
+    }
+    return 0;
+}
+
+int mcs_codegen_dir(char* dir){
+    char base[MCS_CODEGEN_DIR_LEN];
+    const char* env = getenv("MCS_CODEGEN_DIR");
+    const char* home = getenv("HOME");
+    int len;
+    if(env != NULL && env[0] != '\0'){
+        len = snprintf(dir,MCS_CODEGEN_DIR_LEN,"%s",env);
+    }else{
+        env = getenv("XDG_CACHE_HOME");
+        if(env != NULL && env[0] == '/'){
+            len = snprintf(base,MCS_CODEGEN_DIR_LEN,"%s",env);
+        }else if(home != NULL && home[0] != '\0'){
+            len = snprintf(base,MCS_CODEGEN_DIR_LEN,"%s/.cache",home);
+        }else{
+            return 1;
+        }
+        if(len < 0 || len >= MCS_CODEGEN_DIR_LEN){
+            return 1;
+        }
+        mkdir(base,0700);
+        len = snprintf(dir,MCS_CODEGEN_DIR_LEN,"%s/%s",
+                       base,MCS_CODEGEN_SUBDIR);
+    }
+    if(len < 0 || len >= MCS_CODEGEN_DIR_LEN){
+        return 1;
+    }
+    mkdir(dir,0700);
+    return mcs_codegen_private(dir,1);
+}
+
+int mcs_codegen_compile(mcs_codegen* P, const char* dir, const char* path){
+    char src[MCS_CODEGEN_PATH_LEN], tmp[MCS_CODEGEN_PATH_LEN];
+    char* argv[9];
+    const char* cc = getenv("MCS_CC");
+    FILE* out;
+    pid_t pid;
+    int fd, status;
+    int err;
+    if(cc == NULL || cc[0] == '\0'){
+        cc = MCS_CODEGEN_CC;
+    }
+    snprintf(src,MCS_CODEGEN_PATH_LEN,"%s/mcs_stamp_XXXXXX.c",dir);
+    snprintf(tmp,MCS_CODEGEN_PATH_LEN,"%s/mcs_stamp_XXXXXX",dir);
+    fd = mkstemps(src,2);
+    if(fd < 0){
+        return 1;
+    }
+    out = fdopen(fd,"w");
+    if(out == NULL){
+        close(fd);
+        remove(src);
+        return 1;
+    }
+    err = mcs_codegen_write(out,P->M);
+    err = (fclose(out) != 0) || err;
+    fd = err ? -1 : mkstemp(tmp);
+    if(fd < 0){
+        remove(src);
+        return 1;
+    }
+    close(fd);
+    argv[0] = (char*) cc;
+    argv[1] = "-O2";
+    argv[2] = "-fPIC";
+    argv[3] = "-shared";
+    argv[4] = "-o";
+    argv[5] = tmp;
+    argv[6] = src;
+    argv[7] = "-lm";
+    argv[8] = NULL;
+    pid = fork();
+    if(pid == 0){
+        execvp(cc,argv);
+        _exit(127);
+    }
+    err = (pid < 0 || waitpid(pid,&status,0) != pid
+           || !WIFEXITED(status) || WEXITSTATUS(status) != 0);
+    //the linker may have made the object with the umask of the user
+    if(!err){
+        err = (chmod(tmp,0700) != 0);
+    }
+    if(!err){
+        err = (rename(tmp,path) != 0);
+    }
+    remove(src);
+    remove(tmp);
+    return err;
+}
+
+int mcs_alloc_codegen(mcs_mna* M, mcs_codegen** P, mcs_status* st){
+    char dir[MCS_CODEGEN_DIR_LEN], path[MCS_CODEGEN_PATH_LEN];
+    mcs_codegen* Q;
+    *P = NULL;
+    if(mcs_codegen_dir(dir)){
+        return mcs_raise(st,MCS_CODEGEN);
+    }
+    Q = (mcs_codegen*) malloc(sizeof(mcs_codegen));
+    Q->M = M;
+    Q->hash = mcs_codegen_hash(M);
+    Q->handle = NULL;
+    Q->stamp_G = NULL;
+    Q->cached = 1;
+    snprintf(path,MCS_CODEGEN_PATH_LEN,"%s/mcs_stamp_%016lx.so",dir,Q->hash);
+    if(mcs_codegen_private(path,0) || mcs_codegen_load(Q,path)){
+        Q->cached = 0;
+        if(mcs_codegen_compile(Q,dir,path) || mcs_codegen_private(path,0)
+           || mcs_codegen_load(Q,path)){
+            free(Q);
+            return mcs_raise(st,MCS_CODEGEN);
+        }
+    }
+    M->gen_G = Q->stamp_G;
+    *P = Q;
+    return 0;
+}
+
+void mcs_free_codegen(mcs_codegen** P){
+    if((*P)->M->gen_G == (*P)->stamp_G){
+        (*P)->M->gen_G = NULL;
+    }
+    dlclose((*P)->handle);
+    free(*P);
+    *P = NULL;
+}
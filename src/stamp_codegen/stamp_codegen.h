@@ -0,0 +1,118 @@
+#ifndef MCS_STAMP_CODEGEN_H
+#define MCS_STAMP_CODEGEN_H
+
+/*
+ * Netlist specialized stamping code by Bram Rodgers.
+ *
+ * mcs_mna_stamp_G walks the elements of a circuit, switching on the
+ * symbol of each and looking up its terminals and entries of G. For a
+ * circuit which is stamped many times that lookup is pure overhead, so
+ * this module writes C source for one circuit, in which:
+ * ->every element is straight line code with its unknowns, offsets
+ *   into G, and device model written in as constants,
+ * ->element values are still read from M->val and gmin from M->gmin,
+ *   so sweeps and continuation work as before.
+ *
+ * The source is compiled with the system compiler into a shared object,
+ * which is loaded with dlopen and attached to M as M->gen_G. From then on
+ * mcs_mna_stamp_G calls the generated code, and results are the same as
+ * those of the generic code.
+ *
+ * Shared objects are cached under a 64 bit FNV-1a hash of the circuit
+ * structure, in the directory named by the environment variable
+ * MCS_CODEGEN_DIR, or else MCS_CODEGEN_SUBDIR of $XDG_CACHE_HOME or of
+ * $HOME/.cache. A circuit which was seen before, by this process or
+ * another, is loaded without compiling. The compiler is the environment
+ * variable MCS_CC if set, or else MCS_CODEGEN_CC, and is run directly
+ * rather than through the shell.
+ *
+ * Loading a shared object runs its code, so the cache must be private.
+ * A missing directory is created with mode 0700, and a directory or
+ * cached object which is not owned by the user, or which the group or
+ * others may write, is refused. Source and object files are created
+ * with mkstemp under names no other process can predict.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include<stdio.h>
+#include"../mna_system/mna_system.h"
+#include"../error_handling/error_handling.h"
+
+/*
+ * Version of the generated code. Part of the hash, so changing the
+ * generator must increase it. The device models of mna_system.h and
+ * their parameters are hashed as well, so they need no new version.
+ */
+#define MCS_CODEGEN_VERSION     1
+
+/*
+ * Default compiler, and cache directory under the user cache directory.
+ */
+#define MCS_CODEGEN_CC          "cc"
+#define MCS_CODEGEN_SUBDIR      "mcs"
+
+/*
+ * Elements per generated function. Compilers slow down badly on very
+ * long functions, so the straight line code is split into pieces.
+ */
+#define MCS_CODEGEN_CHUNK       256
+
+/*
+ * Longest path of a cached file, and of the cache directory, which
+ * leaves room for the file names in it.
+ */
+#define MCS_CODEGEN_PATH_LEN    1024
+#define MCS_CODEGEN_DIR_LEN     (MCS_CODEGEN_PATH_LEN - 64)
+
+/*
+ * Object and Struct Definitions:
+ */
+
+typedef struct _mcs_codegen{
+    mcs_mna* M;             /*The circuit the code is attached to*/
+    unsigned long hash;     /*Hash of the circuit structure*/
+    void* handle;           /*dlopen handle of the shared object*/
+    mcs_mna_gen stamp_G;    /*The generated stamping function*/
+    int cached;             /*1 if the shared object was not compiled*/
+} mcs_codegen;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Return the hash of the structure of M: the symbol and doping of every
+ * element with its unknowns, but not its value, along with the device
+ * models and their parameters.
+ */
+unsigned long mcs_codegen_hash(mcs_mna* M);
+
+/*
+ * Write the generated C source for M to out. Returns 0, or 1 if M holds
+ * an element with no generated stamp, in which case out is incomplete.
+ */
+int mcs_codegen_write(FILE* out, mcs_mna* M);
+
+/*
+ * Load the generated stamping code of M, compiling it first if it is
+ * not in the cache, and attach it to M. Returns 0 on success, or 1 after
+ * recording MCS_CODEGEN in st, in which case M is unchanged.
+ */
+int mcs_alloc_codegen(mcs_mna* M, mcs_codegen** P, mcs_status* st);
+
+/*
+ * Detach the generated code from its circuit and unload it. Must be
+ * called before the circuit is freed.
+ */
+void mcs_free_codegen(mcs_codegen** P);
+
+#endif
@@ -0,0 +1,679 @@
+/*
+ * Implementation for:
+ * Mixed mode transient analysis with switch level CMOS logic
+ * for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "switch_level.h"
+
+/*
+ * Rail reachability flags of a node. A definite path implies a possible
+ * path, so the definite flags are always set along with the possible ones.
+ */
+#define MCS_SWL_DEF_VDD 1
+#define MCS_SWL_POS_VDD 2
+#define MCS_SWL_DEF_GND 4
+#define MCS_SWL_POS_GND 8
+
+/*
+ * Locally used helper functions:
+ */
+
+long mcs_swl_root(long* uf, long i);
+int mcs_swl_rail(mcs_swl* S, long i);
+double mcs_swl_level(mcs_swl* S, char v);
+void mcs_swl_push(mcs_swl* S, double t, long node, long ver);
+void mcs_swl_pop(mcs_swl* S, mcs_swl_event* e);
+void mcs_swl_schedule(mcs_swl* S, long i, char v, double t);
+long mcs_swl_eval(mcs_swl* S, long c, double t, int settle);
+void mcs_swl_fill(mcs_swl* S);
+double mcs_swl_wave(mcs_mna* Ma, long k, double t, void* data);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Union find root of i, halving the path along the way.
+ */
+long mcs_swl_root(long* uf, long i){
+    while(uf[i] != i){
+        uf[i] = uf[uf[i]];
+        i = uf[i];
+    }
+    return i;
+}
+
+/*
+ * Return 1 if unknown i is ground or the supply rail.
+ */
+int mcs_swl_rail(mcs_swl* S, long i){
+    return (i < 0 || i == S->vdd_node);
+}
+
+/*
+ * Voltage of the logic value v.
+ */
+double mcs_swl_level(mcs_swl* S, char v){
+    if(v == MCS_SWL_1){
+        return S->vdd;
+    }else if(v == MCS_SWL_0){
+        return 0.0;
+    }
+    return 0.5*S->vdd;
+}
+
+void mcs_swl_push(mcs_swl* S, double t, long node, long ver){
+    long i, up;
+    mcs_swl_event e;
+    if(S->num_ev == S->cap_ev){
+        S->cap_ev *= 2;
+        S->ev = (mcs_swl_event*) realloc(S->ev,
+                                         sizeof(mcs_swl_event)*S->cap_ev);
+    }
+    e.t = t;
+    e.node = node;
+    e.ver = ver;
+    i = S->num_ev++;
+    while(i > 0){
+        up = (i-1)/2;
+        if(S->ev[up].t <= t){
+            break;
+        }
+        S->ev[i] = S->ev[up];
+        i = up;
+    }
+    S->ev[i] = e;
+}
+
+void mcs_swl_pop(mcs_swl* S, mcs_swl_event* e){
+    long i, dn;
+    mcs_swl_event last;
+    *e = S->ev[0];
+    last = S->ev[--S->num_ev];
+    i = 0;
+    while(2*i+1 < S->num_ev){
+        dn = 2*i+1;
+        if(dn+1 < S->num_ev && S->ev[dn+1].t < S->ev[dn].t){
+            dn++;
+        }
+        if(last.t <= S->ev[dn].t){
+            break;
+        }
+        S->ev[i] = S->ev[dn];
+        i = dn;
+    }
+    S->ev[i] = last;
+}
+
+/*
+ * Send node i towards the value v starting at time t. Any event of the
+ * node which has not happened yet is cancelled.
+ */
+void mcs_swl_schedule(mcs_swl* S, long i, char v, double t){
+    double d = log(2.0)*S->r_on*S->cap[i];
+    S->v_from[i] = mcs_swl_volt(S,i,t);
+    S->t_from[i] = t;
+    S->tgt[i] = v;
+    S->ver[i]++;
+    if(v == S->val[i]){
+        //the pending change was cancelled, so the node swings back
+        S->t_rise[i] = d;
+        return;
+    }
+    S->t_rise[i] = 2.0*d;
+    mcs_swl_push(S,t+d,i,S->ver[i]);
+}
+
+/*
+ * Evaluate gate c at time t and schedule its changed outputs. If settle
+ * is 1 the outputs change immediately instead.
+ * Returns the number of outputs which changed.
+ */
+long mcs_swl_eval(mcs_swl* S, long c, double t, int settle){
+    long p, k, e, i, g, n_chg = 0;
+    long* term;
+    char gv, on, v, mask, flg[2];
+    int changed;
+    for(p=S->ccc_p[c];p<S->ccc_p[c+1];p++){
+        term = &(S->M->term[3*S->mos[p]]);
+        for(e=0;e<=2;e+=2){
+            if(!mcs_swl_rail(S,term[e])){
+                S->reach[term[e]] = 0;
+            }
+        }
+    }
+    //spread the rail flags through on and unknown transistors
+    do{
+        changed = 0;
+        for(p=S->ccc_p[c];p<S->ccc_p[c+1];p++){
+            k = S->mos[p];
+            term = &(S->M->term[3*k]);
+            g = term[1];
+            if(g < 0){
+                gv = MCS_SWL_0;
+            }else if(g == S->vdd_node){
+                gv = MCS_SWL_1;
+            }else{
+                gv = S->val[g];
+            }
+            if(gv == MCS_SWL_X){
+                on = MCS_SWL_X;
+            }else if(S->M->dev[k]->MN.dope == 'N'){
+                on = gv;
+            }else{
+                on = 1 - gv;
+            }
+            if(on == MCS_SWL_0){
+                continue;
+            }
+            mask = MCS_SWL_POS_VDD | MCS_SWL_POS_GND;
+            if(on == MCS_SWL_1){
+                mask |= MCS_SWL_DEF_VDD | MCS_SWL_DEF_GND;
+            }
+            for(e=0;e<2;e++){
+                i = term[2*e];
+                if(i < 0){
+                    flg[e] = MCS_SWL_DEF_GND | MCS_SWL_POS_GND;
+                }else if(i == S->vdd_node){
+                    flg[e] = MCS_SWL_DEF_VDD | MCS_SWL_POS_VDD;
+                }else{
+                    flg[e] = S->reach[i];
+                }
+            }
+            for(e=0;e<2;e++){
+                i = term[2*e];
+                v = flg[1-e] & mask;
+                if(!mcs_swl_rail(S,i) && (S->reach[i] | v) != S->reach[i]){
+                    S->reach[i] |= v;
+                    changed = 1;
+                }
+            }
+        }
+    }while(changed);
+    for(p=S->ccc_p[c];p<S->ccc_p[c+1];p++){
+        term = &(S->M->term[3*S->mos[p]]);
+        for(e=0;e<=2;e+=2){
+            i = term[e];
+            if(mcs_swl_rail(S,i)){
+                continue;
+            }
+            if((S->reach[i] & MCS_SWL_DEF_VDD) &&
+               !(S->reach[i] & MCS_SWL_POS_GND)){
+                v = MCS_SWL_1;
+            }else if((S->reach[i] & MCS_SWL_DEF_GND) &&
+                     !(S->reach[i] & MCS_SWL_POS_VDD)){
+                v = MCS_SWL_0;
+            }else if(!(S->reach[i] & (MCS_SWL_POS_VDD | MCS_SWL_POS_GND))){
+                //no path to either rail, so the node holds its charge
+                v = S->tgt[i];
+            }else{
+                v = MCS_SWL_X;
+            }
+            if(v == S->tgt[i]){
+                continue;
+            }
+            if(settle){
+                S->val[i] = v;
+                S->tgt[i] = v;
+            }else{
+                mcs_swl_schedule(S,i,v,t);
+            }
+            n_chg++;
+        }
+    }
+    return n_chg;
+}
+
+/*
+ * Write the solution of the full circuit at the current time into S->x.
+ */
+void mcs_swl_fill(mcs_swl* S){
+    long i, k;
+    for(i=0;i<S->M->dim;i++){
+        S->x[i] = 0.0;
+    }
+    for(i=0;i<S->M->num_nodes;i++){
+        if(S->node_ccc[i] >= 0){
+            S->x[i] = mcs_swl_volt(S,i,S->T->t);
+        }else if(i < S->Ma->num_nodes){
+            S->x[i] = S->T->x[i];
+        }
+    }
+    for(k=0;k<S->Ma->num_dev;k++){
+        if(S->a_src[k] >= 0 && S->Ma->branch[k] >= 0){
+            S->x[S->M->branch[S->a_src[k]]] = S->T->x[S->Ma->branch[k]];
+        }
+    }
+}
+
+/*
+ * Source waveform of the analog part. Gate outputs follow their ramps and
+ * the other sources are those of the full circuit.
+ */
+double mcs_swl_wave(mcs_mna* Ma, long k, double t, void* data){
+    mcs_swl* S = (mcs_swl*) data;
+    if(S->a_node[k] >= 0){
+        return mcs_swl_volt(S,S->a_node[k],t);
+    }
+    if(S->wave != NULL){
+        return S->wave(S->M,S->a_src[k],t,S->wave_data);
+    }
+    return Ma->val[k];
+}
+
+int mcs_alloc_swl(mcs_swl** S, mcs_mna* M, double h, double* x0,
+                  mcs_status* st){
+    mcs_swl* W = (mcs_swl*) malloc(sizeof(mcs_swl));
+    long n = M->num_nodes;
+    long i, j, k, c, p, r, a, b, num_mos, num_keep;
+    long* uf = (long*) malloc(sizeof(long)*(n+1));
+    long* cid = (long*) malloc(sizeof(long)*(n+1));
+    long* comp = (long*) malloc(sizeof(long)*(M->num_dev+1));
+    long* mark = (long*) malloc(sizeof(long)*(n+1));
+    char* flag = (char*) calloc(n+1,sizeof(char));
+    char* keep = (char*) malloc(sizeof(char)*(M->num_dev+1));
+    char* touched = (char*) calloc(n+1,sizeof(char));
+    unsigned long max_v = 0;
+    char sym;
+    long* term;
+    double* xa;
+    mcs_netlist** link;
+    mcs_netlist* prev = NULL;
+    W->M = M;
+    //the supply is the highest voltage source to ground
+    W->vdd = 0.0;
+    W->vdd_node = -1;
+    for(k=0;k<M->num_dev;k++){
+        if(M->dev[k]->elem.symbol != 'V'){
+            continue;
+        }
+        if(M->dev[k]->V.idx > max_v){
+            max_v = M->dev[k]->V.idx;
+        }
+        a = M->term[3*k];
+        b = M->term[3*k+1];
+        if(a >= 0 && b < 0 && M->val[k] > W->vdd){
+            W->vdd = M->val[k];
+            W->vdd_node = a;
+        }else if(a < 0 && b >= 0 && -M->val[k] > W->vdd){
+            W->vdd = -M->val[k];
+            W->vdd_node = b;
+        }
+    }
+    //average resistance of a saturated transistor discharging a node
+    W->r_on = 0.75*W->vdd/(0.5*MCS_MOS_K*(W->vdd - MCS_MOS_VTH)
+                                        *(W->vdd - MCS_MOS_VTH));
+    //join the channel nodes of every MOSFET
+    for(i=0;i<n;i++){
+        uf[i] = i;
+    }
+    for(k=0;k<M->num_dev;k++){
+        term = &(M->term[3*k]);
+        if(M->dev[k]->elem.symbol == 'M' &&
+           !mcs_swl_rail(W,term[0]) && !mcs_swl_rail(W,term[2])){
+            uf[mcs_swl_root(uf,term[0])] = mcs_swl_root(uf,term[2]);
+        }
+    }
+    //flag 1 for n-channel, 2 for p-channel, 4 if not a static CMOS gate
+    for(k=0;k<M->num_dev;k++){
+        term = &(M->term[3*k]);
+        sym = M->dev[k]->elem.symbol;
+        comp[k] = -1;
+        if(sym == 'M'){
+            if(!mcs_swl_rail(W,term[0])){
+                comp[k] = mcs_swl_root(uf,term[0]);
+            }else if(!mcs_swl_rail(W,term[2])){
+                comp[k] = mcs_swl_root(uf,term[2]);
+            }
+            if(comp[k] < 0){
+                continue;
+            }
+            if(M->dev[k]->MN.dope == 'N'){
+                flag[comp[k]] |= 1;
+                if(term[0] == W->vdd_node || term[2] == W->vdd_node){
+                    flag[comp[k]] |= 4;
+                }
+            }else{
+                flag[comp[k]] |= 2;
+                if(term[0] < 0 || term[2] < 0){
+                    flag[comp[k]] |= 4;
+                }
+            }
+        }else if(sym == 'V' || sym == 'L'){
+            for(j=0;j<2;j++){
+                if(term[j] >= 0){
+                    flag[mcs_swl_root(uf,term[j])] |= 4;
+                }
+            }
+        }
+    }
+    if(W->vdd <= MCS_MOS_VTH){
+        //transistors never turn on, so there is no logic
+        for(i=0;i<n;i++){
+            flag[i] = 0;
+        }
+    }
+    //number the gates in the order of their first transistor
+    W->num_ccc = 0;
+    num_mos = 0;
+    for(i=0;i<n;i++){
+        cid[i] = -1;
+    }
+    for(k=0;k<M->num_dev;k++){
+        if(comp[k] >= 0 && flag[comp[k]] == 3){
+            if(cid[comp[k]] < 0){
+                cid[comp[k]] = W->num_ccc++;
+            }
+            num_mos++;
+        }
+    }
+    W->ccc_p = (long*) calloc(W->num_ccc+2,sizeof(long));
+    W->mos = (long*) malloc(sizeof(long)*(num_mos+1));
+    for(k=0;k<M->num_dev;k++){
+        if(comp[k] >= 0 && cid[comp[k]] >= 0){
+            W->ccc_p[cid[comp[k]]+2]++;
+        }
+    }
+    for(c=0;c<W->num_ccc;c++){
+        W->ccc_p[c+2] += W->ccc_p[c+1];
+    }
+    for(k=0;k<M->num_dev;k++){
+        if(comp[k] >= 0 && cid[comp[k]] >= 0){
+            W->mos[W->ccc_p[cid[comp[k]]+1]++] = k;
+        }
+    }
+    W->node_ccc = (long*) malloc(sizeof(long)*(n+1));
+    W->cap = (double*) malloc(sizeof(double)*(n+1));
+    for(i=0;i<n;i++){
+        W->node_ccc[i] = -1;
+        if(!mcs_swl_rail(W,i)){
+            W->node_ccc[i] = cid[mcs_swl_root(uf,i)];
+        }
+        W->cap[i] = MCS_SWL_CMIN;
+    }
+    //capacitors among gate outputs and rails are loads of the gates
+    num_keep = 0;
+    for(k=0;k<M->num_dev;k++){
+        term = &(M->term[3*k]);
+        sym = M->dev[k]->elem.symbol;
+        keep[k] = 1;
+        if(sym == 'M' && comp[k] >= 0 && cid[comp[k]] >= 0){
+            keep[k] = 0;
+        }else if(sym == 'C'){
+            a = (!mcs_swl_rail(W,term[0]) && W->node_ccc[term[0]] >= 0);
+            b = (!mcs_swl_rail(W,term[1]) && W->node_ccc[term[1]] >= 0);
+            if(a){
+                W->cap[term[0]] += M->val[k];
+            }
+            if(b){
+                W->cap[term[1]] += M->val[k];
+            }
+            if((a || b) && (a || mcs_swl_rail(W,term[0])) &&
+                           (b || mcs_swl_rail(W,term[1]))){
+                keep[k] = 0;
+            }
+        }
+        if(keep[k]){
+            num_keep++;
+            for(j=0;j<3;j++){
+                if(term[j] >= 0){
+                    touched[term[j]] = 1;
+                }
+            }
+        }
+    }
+    //analog inputs of the gates, and the gates driven by every node
+    W->num_in = 0;
+    W->in = (long*) malloc(sizeof(long)*(n+1));
+    W->fan_p = (long*) calloc(n+2,sizeof(long));
+    for(i=0;i<n;i++){
+        mark[i] = -1;
+    }
+    for(c=0;c<W->num_ccc;c++){
+        for(p=W->ccc_p[c];p<W->ccc_p[c+1];p++){
+            i = M->term[3*W->mos[p]+1];
+            if(mcs_swl_rail(W,i) || mark[i] == c){
+                continue;
+            }
+            if(mark[i] < 0 && W->node_ccc[i] < 0 && touched[i]){
+                W->in[W->num_in++] = i;
+            }
+            mark[i] = c;
+            W->fan_p[i+2]++;
+        }
+    }
+    for(i=0;i<n;i++){
+        W->fan_p[i+2] += W->fan_p[i+1];
+        mark[i] = -1;
+    }
+    W->fan = (long*) malloc(sizeof(long)*(W->fan_p[n+1]+1));
+    for(c=0;c<W->num_ccc;c++){
+        for(p=W->ccc_p[c];p<W->ccc_p[c+1];p++){
+            i = M->term[3*W->mos[p]+1];
+            if(mcs_swl_rail(W,i) || mark[i] == c){
+                continue;
+            }
+            mark[i] = c;
+            W->fan[W->fan_p[i+1]++] = c;
+        }
+    }
+    //the analog part, with a source at every gate output it touches
+    for(i=0;i<n;i++){
+        if(W->node_ccc[i] >= 0 && touched[i]){
+            num_keep++;
+        }
+    }
+    W->a_src = (long*) malloc(sizeof(long)*(num_keep+1));
+    W->a_node = (long*) malloc(sizeof(long)*(num_keep+1));
+    W->nl_a = NULL;
+    link = &(W->nl_a);
+    j = 0;
+    for(k=0;k<M->num_dev+n;k++){
+        if(k < M->num_dev){
+            if(!keep[k]){
+                continue;
+            }
+            mcs_alloc_netlist(link);
+            mcs_mna_flat_element(M,k,(*link)->dev);
+            W->a_src[j] = k;
+            W->a_node[j] = -1;
+        }else{
+            i = k - M->num_dev;
+            if(W->node_ccc[i] < 0 || !touched[i]){
+                continue;
+            }
+            mcs_alloc_netlist(link);
+            mcs_init_voltage(&((*link)->dev->V),++max_v,
+                             (unsigned long) (i+1),0,0.0);
+            W->a_src[j] = -1;
+            W->a_node[j] = i;
+        }
+        (*link)->prev = prev;
+        prev = *link;
+        link = &((*link)->next);
+        j++;
+    }
+    mcs_alloc_mna(&(W->Ma),W->nl_a);
+    //settle the gates on the inputs at x0
+    W->val = (char*) malloc(sizeof(char)*(n+1));
+    W->tgt = (char*) malloc(sizeof(char)*(n+1));
+    W->ver = (long*) calloc(n+1,sizeof(long));
+    W->t_from = (double*) calloc(n+1,sizeof(double));
+    W->t_rise = (double*) calloc(n+1,sizeof(double));
+    W->v_from = (double*) calloc(n+1,sizeof(double));
+    W->reach = (char*) calloc(n+1,sizeof(char));
+    for(i=0;i<n;i++){
+        W->val[i] = MCS_SWL_X;
+    }
+    for(j=0;j<W->num_in;j++){
+        i = W->in[j];
+        W->val[i] = MCS_SWL_0;
+        if(x0 != NULL && x0[i] >= 0.5*W->vdd){
+            W->val[i] = MCS_SWL_1;
+        }
+    }
+    for(i=0;i<n;i++){
+        W->tgt[i] = W->val[i];
+    }
+    for(r=0;r<=W->num_ccc;r++){
+        a = 0;
+        for(c=0;c<W->num_ccc;c++){
+            a += mcs_swl_eval(W,c,0.0,1);
+        }
+        if(a == 0){
+            break;
+        }
+    }
+    W->num_ev = 0;
+    W->cap_ev = 64;
+    W->ev = (mcs_swl_event*) malloc(sizeof(mcs_swl_event)*W->cap_ev);
+    W->num_events = 0;
+    W->wave = NULL;
+    W->wave_data = NULL;
+    //start the analog part from x0 with the gate outputs at their levels
+    xa = (double*) malloc(sizeof(double)*(W->Ma->dim+1));
+    for(i=0;i<W->Ma->dim;i++){
+        xa[i] = 0.0;
+    }
+    for(i=0;i<W->Ma->num_nodes;i++){
+        if(W->node_ccc[i] >= 0){
+            xa[i] = mcs_swl_level(W,W->val[i]);
+        }else if(x0 != NULL){
+            xa[i] = x0[i];
+        }
+    }
+    for(k=0;k<W->Ma->num_dev;k++){
+        if(x0 != NULL && W->a_src[k] >= 0 && W->Ma->branch[k] >= 0){
+            xa[W->Ma->branch[k]] = x0[M->branch[W->a_src[k]]];
+        }
+    }
+    W->x = NULL;
+    if(mcs_alloc_tran(&(W->T),W->Ma,h,xa,st)){
+        //the analog part is singular, so there is nothing to simulate
+        mcs_free_swl(&W);
+    }else{
+        mcs_tran_set_wave(W->T,&mcs_swl_wave,W);
+        W->x = (double*) malloc(sizeof(double)*(M->dim+1));
+        mcs_swl_fill(W);
+    }
+    free(xa);
+    free(uf);
+    free(cid);
+    free(comp);
+    free(mark);
+    free(flag);
+    free(keep);
+    free(touched);
+    *S = W;
+    return (W == NULL);
+}
+
+void mcs_free_swl(mcs_swl** S){
+    mcs_swl* W = *S;
+    if(W->T != NULL){
+        mcs_free_tran(&(W->T));
+    }
+    mcs_free_mna(&(W->Ma));
+    mcs_free_netlist(&(W->nl_a));
+    free(W->ccc_p);
+    free(W->mos);
+    free(W->node_ccc);
+    free(W->fan_p);
+    free(W->fan);
+    free(W->in);
+    free(W->val);
+    free(W->tgt);
+    free(W->ver);
+    free(W->cap);
+    free(W->t_from);
+    free(W->t_rise);
+    free(W->v_from);
+    free(W->reach);
+    free(W->ev);
+    free(W->a_src);
+    free(W->a_node);
+    free(W->x);
+    free(W);
+    *S = NULL;
+}
+
+void mcs_swl_set_wave(mcs_swl* S, mcs_source_wave wave, void* data){
+    S->wave = wave;
+    S->wave_data = data;
+}
+
+double mcs_swl_volt(mcs_swl* S, long i, double t){
+    double v = mcs_swl_level(S,S->tgt[i]);
+    if(S->t_rise[i] > 0.0 && t < S->t_from[i] + S->t_rise[i]){
+        v = S->v_from[i] + (v - S->v_from[i])*(t - S->t_from[i])
+                                             /S->t_rise[i];
+    }
+    return v;
+}
+
+long mcs_swl_step(mcs_swl* S){
+    double t_new = S->T->t + S->T->h;
+    mcs_swl_event e;
+    long iter, i, j, f;
+    char v;
+    while(S->num_ev > 0 && S->ev[0].t <= t_new){
+        mcs_swl_pop(S,&e);
+        if(e.ver != S->ver[e.node]){
+            continue;
+        }
+        S->val[e.node] = S->tgt[e.node];
+        S->num_events++;
+        for(f=S->fan_p[e.node];f<S->fan_p[e.node+1];f++){
+            mcs_swl_eval(S,S->fan[f],e.t,0);
+        }
+    }
+    iter = mcs_tran_step(S->T);
+    if(iter < 0){
+        return -1;
+    }
+    for(j=0;j<S->num_in;j++){
+        i = S->in[j];
+        v = S->val[i];
+        if(S->T->x[i] >= MCS_SWL_HI*S->vdd){
+            v = MCS_SWL_1;
+        }else if(S->T->x[i] <= MCS_SWL_LO*S->vdd){
+            v = MCS_SWL_0;
+        }
+        if(v != S->val[i]){
+            S->val[i] = v;
+            S->tgt[i] = v;
+            S->num_events++;
+            for(f=S->fan_p[i];f<S->fan_p[i+1];f++){
+                mcs_swl_eval(S,S->fan[f],t_new,0);
+            }
+        }
+    }
+    mcs_swl_fill(S);
+    return iter;
+}
+
+long mcs_swl_run(mcs_swl* S, double t_stop, mcs_wave* W){
+    long n = 0;
+    if(W != NULL){
+        mcs_wave_write(W,S->T->t,S->x);
+    }
+    while(S->T->t < t_stop - 0.5*S->T->h){
+        if(mcs_swl_step(S) < 0){
+            return -1;
+        }
+        n++;
+        if(W != NULL){
+            mcs_wave_write(W,S->T->t,S->x);
+        }
+    }
+    return n;
+}
@@ -0,0 +1,174 @@
+#ifndef MCS_SWITCH_LEVEL_H
+#define MCS_SWITCH_LEVEL_H
+
+/*
+ * Mixed mode transient analysis with switch level CMOS logic
+ * for MicroCircSim by Bram Rodgers.
+ *
+ * The MOSFETs of a circuit are split into channel connected components,
+ * which are the groups of transistors joined through their drains and
+ * sources, not counting the ground and supply rails. A component is a
+ * static CMOS gate when it has both n-channel and p-channel devices, no
+ * n-channel device touches the supply, no p-channel device touches
+ * ground, and none of its nodes touch a voltage source or an inductor.
+ *
+ * Those gates are simulated event driven at switch level:
+ * ->Every node of a gate has the logic value 0, 1, or X. A transistor is
+ *   on, off, or unknown depending on the value of its gate node.
+ * ->A node is 1 when it has a path of on transistors to the supply and
+ *   no possible path to ground, 0 in the opposite case, keeps its value
+ *   when it has no possible path to either, and is X otherwise.
+ * ->When a node's value changes, the gates it drives are re-evaluated and
+ *   any changed outputs are scheduled after a delay of ln(2)*R_on*C.
+ *   C is the capacitance hanging on the output node and
+ *   R_on = 0.75*VDD/I_sat is the average resistance of one transistor
+ *   switching the node with its gate at the rail.
+ *   A later evaluation cancels an event which has not happened yet.
+ *
+ * Everything else is simulated by the analog transient engine:
+ * ->A gate output touched by an analog element is driven into the analog
+ *   circuit by a voltage source, which ramps between the rails over twice
+ *   the delay of each transition.
+ * ->An analog node driving a gate input is sampled after every time step.
+ *   It becomes 1 above MCS_SWL_HI times the supply voltage and 0 below
+ *   MCS_SWL_LO times the supply voltage, and keeps its value in between.
+ *
+ * The supply rail is the node held at the largest positive voltage by a
+ * voltage source to ground, using its DC value.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../netlist_parser/netlist_parser.h"
+#include"../mna_system/mna_system.h"
+#include"../transient_analysis/transient_analysis.h"
+#include"../waveform_writer/waveform_writer.h"
+
+/*
+ * Logic values. MCS_SWL_X is unknown or contested.
+ */
+#define MCS_SWL_0       0
+#define MCS_SWL_1       1
+#define MCS_SWL_X       2
+
+/*
+ * Input thresholds as fractions of the supply voltage.
+ */
+#define MCS_SWL_HI      0.6
+#define MCS_SWL_LO      0.4
+
+/*
+ * Capacitance added to every gate output node, in Farads, so that a node
+ * with no capacitors still has a nonzero delay.
+ */
+#define MCS_SWL_CMIN    1.0e-15
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * A scheduled change of a node. Stale events have a version number which
+ * no longer matches that of their node.
+ */
+typedef struct _mcs_swl_event{
+    double t;   /*Time at which the node takes its target value*/
+    long node;  /*Unknown index of the node*/
+    long ver;   /*Version of the node when the event was scheduled*/
+} mcs_swl_event;
+
+typedef struct _mcs_swl{
+    mcs_mna* M;             /*The full circuit*/
+    double vdd;             /*Supply voltage*/
+    long vdd_node;          /*Unknown index of the supply rail, or -1*/
+    double r_on;            /*On resistance of one transistor*/
+    long num_ccc;           /*Number of switch level gates*/
+    long* ccc_p;            /*Gate c holds mos[ccc_p[c]] to ccc_p[c+1]-1*/
+    long* mos;              /*Position in M->dev of each gate transistor*/
+    long* node_ccc;         /*Gate driving each node, or -1 if analog*/
+    long* fan_p;            /*Node i drives fan[fan_p[i]] to fan_p[i+1]-1*/
+    long* fan;              /*Gates with a transistor gated by each node*/
+    long num_in;            /*Number of analog nodes driving gates*/
+    long* in;               /*Unknown index of each of those nodes*/
+    char* val;              /*Logic value of each node*/
+    char* tgt;              /*Value each node is heading to*/
+    long* ver;              /*Version of each node's latest event*/
+    double* cap;            /*Load capacitance of each gate output*/
+    double* t_from;         /*Start time of each node's last ramp*/
+    double* t_rise;         /*Duration of each node's last ramp*/
+    double* v_from;         /*Voltage of each node at the ramp start*/
+    char* reach;            /*Rail reachability flags used in evaluation*/
+    long num_ev;            /*Number of queued events*/
+    long cap_ev;            /*Allocated length of ev*/
+    mcs_swl_event* ev;      /*Binary heap of events ordered by time*/
+    long num_events;        /*Number of node changes simulated*/
+    mcs_netlist* nl_a;      /*Netlist of the analog part*/
+    mcs_mna* Ma;            /*MNA description of the analog part*/
+    long* a_src;            /*Position in M->dev of each element of Ma*/
+    long* a_node;           /*Gate output driven by each element of Ma*/
+    mcs_tran* T;            /*Transient analysis of Ma*/
+    mcs_source_wave wave;   /*Source waveforms of M, or NULL*/
+    void* wave_data;        /*Passed to wave*/
+    double* x;              /*Solution of the full circuit at T->t*/
+} mcs_swl;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Split M into switch level gates and an analog part, and set up a mixed
+ * mode transient analysis with time step h starting at time 0 from x0.
+ * If x0 is NULL the circuit starts from x = 0. The gates are settled to
+ * the logic values implied by their inputs at x0 before the first step.
+ * M must outlive S.
+ *
+ * Returns 0. If the analog part has no pivot order at x0, then returns 1
+ * with *S set to NULL after recording MCS_SINGULAR_MATRIX in st. If st is
+ * NULL then mcs_error is called instead.
+ */
+int mcs_alloc_swl(mcs_swl** S, mcs_mna* M, double h, double* x0,
+                  mcs_status* st);
+
+/*
+ * Free a mixed mode transient analysis. The circuit is not freed.
+ */
+void mcs_free_swl(mcs_swl** S);
+
+/*
+ * Use the waveform function wave for all sources of M, as in
+ * mcs_tran_set_wave. The supply rail keeps its DC value in the gates.
+ */
+void mcs_swl_set_wave(mcs_swl* S, mcs_source_wave wave, void* data);
+
+/*
+ * Return the voltage of unknown i of M at time t, for a node driven
+ * by a gate. This follows the ramp of the node's last transition.
+ */
+double mcs_swl_volt(mcs_swl* S, long i, double t);
+
+/*
+ * Advance S by one time step: events up to the new time are processed,
+ * the analog part takes one step, and its gate inputs are sampled.
+ * S->x holds the full solution afterwards. Returns the number of Newton
+ * iterations of the analog step, or -1 if it did not converge.
+ */
+long mcs_swl_step(mcs_swl* S);
+
+/*
+ * Step S until t_stop. If W is not NULL, the starting point and every
+ * step of the full solution are written to W, which is opened for S->M.
+ * Returns the number of steps taken, or -1 if a step did not converge.
+ */
+long mcs_swl_run(mcs_swl* S, double t_stop, mcs_wave* W);
+
+#endif
@@ -0,0 +1,374 @@
+/*
+ * Implementation for:
+ * Fixed step transient analysis for MicroCircSim by Bram Rodgers.
+ * Based on Chapter 4 of the textbook
+ * ``Circuit Simulation'' by Farid N. Najm.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "transient_analysis.h"
+/*
+ * Locally used helper functions:
+ */
+
+void mcs_tran_sources(mcs_tran* T, double t);
+int mcs_tran_factor(mcs_tran* T);
+void mcs_tran_wake(mcs_tran* T, double* x, int force);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Write the source values at time t into T->Mt.val.
+ */
+void mcs_tran_sources(mcs_tran* T, double t){
+    long j, k;
+    for(j=0;j<T->num_src;j++){
+        k = T->src[j];
+        if(T->wave != NULL){
+            T->Mt.val[k] = T->wave(T->M,k,t,T->wave_data);
+        }else{
+            T->Mt.val[k] = T->M->val[k];
+        }
+    }
+}
+
+/*
+ * Factor T->A, replacing the symbolic analysis if its pivot order
+ * is unstable for the current values. Returns 0, or 1 if A is singular,
+ * in which case T->N holds no usable factors.
+ */
+int mcs_tran_factor(mcs_tran* T){
+    mcs_splu_symbolic* S;
+    T->num_factor++;
+    if(mcs_splu_factor(T->N,T->A->dat) == 0){
+        return 0;
+    }
+    if(mcs_splu_analyze_r(T->A,&S)){
+        return 1;
+    }
+    mcs_free_splu(&(T->N));
+    mcs_free_splu_symbolic(&(T->S));
+    T->S = S;
+    mcs_alloc_splu(T->S,&(T->N));
+    return mcs_splu_factor(T->N,T->A->dat);
+}
+
+/*
+ * Evaluate the devices of every latency group which is awake at x, or of
+ * every group if force is 1. Their entries of G are written into T->A
+ * and their right hand sides into T->rhs.
+ */
+void mcs_tran_wake(mcs_tran* T, double* x, int force){
+    long g, p, k, t;
+    long* term;
+    int awake;
+    for(g=0;g<T->num_grp;g++){
+        awake = force;
+        for(p=T->grp_p[g];p<T->grp_p[g+1] && !awake;p++){
+            k = T->grp_dev[p];
+            term = &(T->M->term[3*k]);
+            for(t=0;t<3;t++){
+                if(term[t] >= 0 &&
+                   fabs(x[term[t]] - T->v_ref[3*k+t]) > T->lat_tol){
+                    awake = 1;
+                }
+            }
+        }
+        if(!awake){
+            continue;
+        }
+        for(p=T->grp_p[g];p<T->grp_p[g+1];p++){
+            k = T->grp_dev[p];
+            term = &(T->M->term[3*k]);
+            for(t=0;t<3;t++){
+                T->v_ref[3*k+t] = (term[t] >= 0) ? x[term[t]] : 0.0;
+            }
+            mcs_mna_stamp_element(&(T->Mt),k,x,T->A->dat,&(T->rhs[4*k]));
+            T->num_eval++;
+        }
+        T->dirty = 1;
+    }
+}
+
+int mcs_alloc_tran(mcs_tran** T, mcs_mna* M, double h, double* x0,
+                   mcs_status* st){
+    mcs_tran* R;
+    mcs_spmat* G;
+    long i, j;
+    char sym;
+    R = (mcs_tran*) malloc(sizeof(mcs_tran));
+    R->M = M;
+    R->Mt = *M;
+    R->Mt.val = (double*) malloc(sizeof(double)*(M->num_dev+1));
+    R->num_src = 0;
+    R->src = (long*) malloc(sizeof(long)*(M->num_dev+1));
+    for(i=0;i<M->num_dev;i++){
+        R->Mt.val[i] = M->val[i];
+        sym = M->dev[i]->elem.symbol;
+        if(sym == 'V' || sym == 'I'){
+            R->src[R->num_src++] = i;
+        }
+    }
+    R->h = h;
+    R->t = 0.0;
+    R->x = (double*) malloc(sizeof(double)*(M->dim+1));
+    for(i=0;i<M->dim;i++){
+        R->x[i] = (x0 == NULL) ? 0.0 : x0[i];
+    }
+    R->wave = NULL;
+    R->wave_data = NULL;
+    R->work = (double*) malloc(sizeof(double)*(3*M->dim+1));
+    R->tol = MCS_DC_TOL;
+    R->max_iter = MCS_DC_MAX_ITER;
+    R->num_steps = 0;
+    R->num_factor = 0;
+    R->linear = mcs_mna_is_linear(M);
+    R->num_grp = 0;
+    R->grp_p = (long*) malloc(sizeof(long)*(M->num_dev+2));
+    R->grp_dev = (long*) malloc(sizeof(long)*(M->num_dev+1));
+    R->v_ref = (double*) malloc(sizeof(double)*(3*M->num_dev+1));
+    R->rhs = (double*) calloc(4*M->num_dev+1,sizeof(double));
+    R->lat_tol = 0.0;
+    R->dirty = 1;
+    R->num_eval = 0;
+    //A stacks the coordinates of G and C/h
+    mcs_mna_alloc_G(M,&G);
+    mcs_mna_stamp_G(M,R->x,G->dat,NULL);
+    mcs_mna_alloc_C(M,&(R->C));
+    mcs_spmat_scale(1.0/h,R->C);
+    mcs_alloc_spmv(R->C,MCS_SPMV_AUTO,&(R->Cv));
+    mcs_alloc_spmat(&(R->A),G->nnz+R->C->nnz,M->dim,M->dim);
+    for(j=0;j<G->nnz;j++){
+        R->A->r[j] = G->r[j];
+        R->A->c[j] = G->c[j];
+        R->A->dat[j] = G->dat[j];
+    }
+    for(j=0;j<R->C->nnz;j++){
+        R->A->r[G->nnz+j] = R->C->r[j];
+        R->A->c[G->nnz+j] = R->C->c[j];
+        R->A->dat[G->nnz+j] = R->C->dat[j];
+    }
+    mcs_free_spmat(&G);
+    if(mcs_splu_analyze_r(R->A,&(R->S))){
+        mcs_free_spmat(&(R->A));
+        mcs_free_spmat(&(R->C));
+        mcs_free_spmv(&(R->Cv));
+        free(R->rhs);
+        free(R->v_ref);
+        free(R->grp_dev);
+        free(R->grp_p);
+        free(R->work);
+        free(R->x);
+        free(R->src);
+        free(R->Mt.val);
+        free(R);
+        *T = NULL;
+        return mcs_raise(st,MCS_SINGULAR_MATRIX);
+    }
+    mcs_alloc_splu(R->S,&(R->N));
+    if(R->linear){
+        //G + C/h never changes, so this is the only factorization.
+        R->dirty = mcs_tran_factor(R);
+    }else{
+        mcs_tran_set_latency(R,0.0,0);
+    }
+    *T = R;
+    return 0;
+}
+
+void mcs_free_tran(mcs_tran** T){
+    mcs_free_splu(&((*T)->N));
+    mcs_free_splu_symbolic(&((*T)->S));
+    mcs_free_spmat(&((*T)->A));
+    mcs_free_spmat(&((*T)->C));
+    mcs_free_spmv(&((*T)->Cv));
+    free((*T)->rhs);
+    free((*T)->v_ref);
+    free((*T)->grp_dev);
+    free((*T)->grp_p);
+    free((*T)->work);
+    free((*T)->x);
+    free((*T)->src);
+    free((*T)->Mt.val);
+    free(*T);
+}
+
+void mcs_tran_set_wave(mcs_tran* T, mcs_source_wave wave, void* data){
+    T->wave = wave;
+    T->wave_data = data;
+}
+
+void mcs_tran_set_latency(mcs_tran* T, double lat_tol, long num_grp){
+    mcs_mna* M = T->M;
+    long* part = NULL;
+    long *cnt, *grp;
+    long g, k, t;
+    char sym;
+    T->lat_tol = lat_tol;
+    if(T->linear){
+        return;
+    }
+    if(num_grp > 0){
+        part = (long*) malloc(sizeof(long)*(M->dim+1));
+        mcs_dd_partition(T->A,num_grp,part);
+        T->num_grp = num_grp+1;
+    }else{
+        T->num_grp = M->num_dev;
+    }
+    cnt = (long*) calloc(T->num_grp+1,sizeof(long));
+    grp = (long*) malloc(sizeof(long)*(M->num_dev+1));
+    //group of each nonlinear device, or -1 for linear elements
+    for(k=0;k<M->num_dev;k++){
+        sym = M->dev[k]->elem.symbol;
+        grp[k] = -1;
+        if(sym != 'D' && sym != 'Q' && sym != 'M'){
+            continue;
+        }
+        g = k;
+        if(part != NULL){
+            g = num_grp;
+            for(t=2;t>=0;t--){
+                if(M->term[3*k+t] >= 0){
+                    g = part[M->term[3*k+t]];
+                }
+            }
+        }
+        grp[k] = g;
+        cnt[g+1]++;
+    }
+    for(g=0;g<T->num_grp;g++){
+        cnt[g+1] += cnt[g];
+        T->grp_p[g] = cnt[g];
+    }
+    T->grp_p[T->num_grp] = cnt[T->num_grp];
+    for(k=0;k<M->num_dev;k++){
+        g = grp[k];
+        if(g >= 0){
+            T->grp_dev[cnt[g]++] = k;
+        }
+    }
+    //start with every device evaluated at the current state
+    mcs_tran_wake(T,T->x,1);
+    free(grp);
+    free(cnt);
+    free(part);
+}
+
+long mcs_tran_step(mcs_tran* T){
+    long dim = T->M->dim;
+    double* b = T->work;
+    double* hist = &(T->work[dim]);
+    double* x_new = &(T->work[2*dim]);
+    long i, j, k, t, iter;
+    long* term;
+    int converged;
+    mcs_tran_sources(T,T->t + T->h);
+    //history term (C/h)*x(t)
+    mcs_spmv_apply(T->Cv,T->x,hist);
+    if(T->linear){
+        if(T->dirty && mcs_tran_factor(T)){
+            return -1;
+        }
+        T->dirty = 0;
+        for(j=0;j<T->num_src;j++){
+            mcs_mna_add_source(&(T->Mt),T->src[j],T->Mt.val[T->src[j]],hist);
+        }
+        mcs_splu_solve(T->N,hist,T->x);
+        T->t += T->h;
+        T->num_steps++;
+        return 1;
+    }
+    for(i=0;i<dim;i++){
+        x_new[i] = T->x[i];
+    }
+    for(iter=1;iter<=T->max_iter;iter++){
+        //only the G entries of awake devices depend on x
+        mcs_tran_wake(T,x_new,0);
+        for(i=0;i<dim;i++){
+            b[i] = hist[i];
+        }
+        for(j=0;j<T->num_src;j++){
+            mcs_mna_add_source(&(T->Mt),T->src[j],T->Mt.val[T->src[j]],b);
+        }
+        for(j=0;j<T->grp_p[T->num_grp];j++){
+            k = T->grp_dev[j];
+            term = &(T->M->term[3*k]);
+            for(t=0;t<3;t++){
+                if(term[t] >= 0){
+                    b[term[t]] += T->rhs[4*k+t];
+                }
+            }
+        }
+        if(T->dirty){
+            if(mcs_tran_factor(T)){
+                return -1;
+            }
+            T->dirty = 0;
+        }
+        mcs_splu_solve(T->N,b,b);
+        converged = 1;
+        for(i=0;i<dim;i++){
+            if(fabs(b[i]-x_new[i]) > T->tol*(1.0+fabs(b[i]))){
+                converged = 0;
+            }
+            x_new[i] = b[i];
+        }
+        if(converged){
+            for(i=0;i<dim;i++){
+                T->x[i] = x_new[i];
+            }
+            T->t += T->h;
+            T->num_steps++;
+            return iter;
+        }
+    }
+    return -1;
+}
+
+void mcs_tran_set_step(mcs_tran* T, double h){
+    long nnz_G = T->A->nnz - T->C->nnz;
+    long j;
+    mcs_spmat_scale(T->h/h,T->C);
+    mcs_spmv_load(T->Cv,T->C->dat);
+    for(j=0;j<T->C->nnz;j++){
+        T->A->dat[nnz_G+j] = T->C->dat[j];
+    }
+    T->h = h;
+    if(T->linear){
+        T->dirty = mcs_tran_factor(T);
+    }else{
+        T->dirty = 1;
+    }
+}
+
+void mcs_tran_linearize(mcs_tran* T){
+    if(!T->linear){
+        mcs_tran_wake(T,T->x,1);
+    }
+}
+
+long mcs_tran_run(mcs_tran* T, double t_stop, mcs_wave* W){
+    long n = 0;
+    if(W != NULL){
+        mcs_wave_write(W,T->t,T->x);
+    }
+    while(T->t < t_stop - 0.5*T->h){
+        if(mcs_tran_step(T) < 0){
+            return -1;
+        }
+        n++;
+        if(W != NULL){
+            mcs_wave_write(W,T->t,T->x);
+        }
+    }
+    return n;
+}
@@ -0,0 +1,149 @@
+#ifndef MCS_TRANSIENT_ANALYSIS_H
+#define MCS_TRANSIENT_ANALYSIS_H
+
+/*
+ * Fixed step transient analysis for MicroCircSim by Bram Rodgers.
+ * Based on Chapter 4 of the textbook
+ * ``Circuit Simulation'' by Farid N. Najm.
+ *
+ * The system G*x + C*(d/dt)x = b(t) is integrated with backward Euler,
+ *      (G + C/h)*x(t+h) = b(t+h) + (C/h)*x(t),
+ * solving each step with Newton's method.
+ *
+ * Circuits made only of V, I, R, C, and L elements have a constant
+ * matrix G + C/h. For those the matrix is factored once when the
+ * transient is set up, and each step is only a right hand side update
+ * and a pair of triangular solves.
+ *
+ * Nonlinear devices are split into latency groups. A group whose
+ * terminal voltages all stay within lat_tol of the voltages of its last
+ * evaluation is latent: its devices are not evaluated and their cached
+ * entries of G and right hand side are reused. A group wakes as soon as
+ * any of its terminal voltages moves further than lat_tol. While every
+ * group is latent the matrix is unchanged, so Newton iterations and
+ * whole time steps reuse the last factorization. With lat_tol = 0 only
+ * devices whose voltages are exactly unchanged are skipped.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include"math.h"
+#include"../mna_system/mna_system.h"
+#include"../sparse_matrix/sparse_matrix.h"
+#include"../sparse_lu/sparse_lu.h"
+#include"../dc_analysis/dc_analysis.h"
+#include"../waveform_writer/waveform_writer.h"
+#include"../domain_decomp/domain_decomp.h"
+#include"../spmv_plan/spmv_plan.h"
+
+/*
+ * Object and Struct Definitions:
+ */
+
+/*
+ * A source waveform. Returns the value of the voltage or current source
+ * at position k of M->dev at time t. data is passed through unchanged.
+ */
+typedef double (*mcs_source_wave)(mcs_mna* M, long k, double t, void* data);
+
+typedef struct _mcs_tran{
+    mcs_mna* M;             /*The circuit being simulated*/
+    mcs_mna Mt;             /*Copy of *M holding the source values at t*/
+    double h;               /*Time step*/
+    double t;               /*Current time*/
+    double* x;              /*Solution at time t*/
+    int linear;             /*1 if G + C/h is factored once*/
+    long num_src;           /*Number of voltage and current sources*/
+    long* src;              /*Position in M->dev of each source*/
+    mcs_source_wave wave;   /*Source waveforms, or NULL for DC sources*/
+    void* wave_data;        /*Passed to wave*/
+    mcs_spmat* A;           /*Coordinates of G followed by those of C/h*/
+    mcs_spmat* C;           /*C/h*/
+    mcs_spmv* Cv;           /*C/h stored for fast products*/
+    mcs_splu_symbolic* S;   /*Symbolic analysis of A*/
+    mcs_splu_numeric* N;    /*Numeric factors of A*/
+    double* work;           /*Workspace of 3*M->dim entries*/
+    double tol;             /*Newton tolerance, as in mcs_dc_op*/
+    long max_iter;          /*Newton iteration limit per step*/
+    long num_steps;         /*Number of steps taken*/
+    long num_factor;        /*Number of numeric factorizations*/
+    long num_grp;           /*Number of latency groups*/
+    long* grp_p;            /*Group g holds grp_dev[grp_p[g]] to grp_p[g+1]-1*/
+    long* grp_dev;          /*Nonlinear devices sorted by latency group*/
+    double* v_ref;          /*Terminal voltages at each device's evaluation*/
+    double* rhs;            /*Right hand side of each device, 4 per device*/
+    double lat_tol;         /*Voltage change which wakes a latent group*/
+    int dirty;              /*1 if A changed or failed to factor since
+                              the last factorization*/
+    long num_eval;          /*Number of nonlinear device evaluations*/
+} mcs_tran;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Set up a transient analysis of M with time step h, starting at time 0
+ * from the state x0. If x0 is NULL the circuit starts from x = 0.
+ * Linear circuits are factored here.
+ *
+ * Returns 0. If no pivot order exists for G + C/h at x0, then returns 1
+ * with *T set to NULL after recording MCS_SINGULAR_MATRIX in st. If st is
+ * NULL then mcs_error is called instead.
+ */
+int mcs_alloc_tran(mcs_tran** T, mcs_mna* M, double h, double* x0,
+                   mcs_status* st);
+
+/*
+ * Free a transient analysis. The circuit is not freed.
+ */
+void mcs_free_tran(mcs_tran** T);
+
+/*
+ * Use the waveform function wave for all sources. NULL restores the
+ * DC values of M->val.
+ */
+void mcs_tran_set_wave(mcs_tran* T, mcs_source_wave wave, void* data);
+
+/*
+ * Set the latency tolerance of T to lat_tol Volts and regroup the
+ * nonlinear devices. If num_grp > 0 the circuit is split into num_grp
+ * partitions with mcs_dd_partition plus one group for the partition
+ * interface, and each device joins the group of its first terminal which
+ * is not ground. If num_grp <= 0 every device is its own group.
+ */
+void mcs_tran_set_latency(mcs_tran* T, double lat_tol, long num_grp);
+
+/*
+ * Advance T by one time step. Returns the number of Newton iterations,
+ * or -1 if the step did not converge, in which case T is unchanged.
+ */
+long mcs_tran_step(mcs_tran* T);
+
+/*
+ * Change the time step of T to h. Linear circuits are refactored here.
+ */
+void mcs_tran_set_step(mcs_tran* T, double h);
+
+/*
+ * Evaluate every device at T->x, so that T->A holds G + C/h linearized
+ * at the current state, which is the Jacobian of the last step taken.
+ */
+void mcs_tran_linearize(mcs_tran* T);
+
+/*
+ * Step T until t_stop. If W is not NULL, the starting point and every
+ * step are written to W. Returns the number of steps taken, or -1 if a
+ * step did not converge.
+ */
+long mcs_tran_run(mcs_tran* T, double t_stop, mcs_wave* W);
+
+#endif
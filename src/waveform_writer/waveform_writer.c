@@ -0,0 +1,357 @@
+/*
+ * Implementation for:
+ * Streaming binary waveform output for MicroCircSim by Bram Rodgers.
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Macros and Includes go here: (Some common ones included)
+ */
+#include "waveform_writer.h"
+#include <string.h>
+/*
+ * Locally used helper functions:
+ */
+
+void mcs_wave_put(FILE* f, unsigned long long v, int num_bytes);
+unsigned long long mcs_wave_get(FILE* f, int num_bytes);
+long mcs_wave_encode(mcs_wave* W, double* buf, long n);
+void* mcs_wave_writer(void* arg);
+void mcs_wave_flush(mcs_wave* W);
+
+/*
+ * Static Local Variables:
+ */
+
+/*
+ * Function Implementations:
+ */
+
+/*
+ * Write the low num_bytes bytes of v to f in little endian order.
+ */
+void mcs_wave_put(FILE* f, unsigned long long v, int num_bytes){
+    int i;
+    for(i=0;i<num_bytes;i++){
+        fputc((int) ((v >> (8*i)) & 0xFF), f);
+    }
+}
+
+/*
+ * Read a little endian integer of num_bytes bytes from f.
+ */
+unsigned long long mcs_wave_get(FILE* f, int num_bytes){
+    unsigned long long v = 0;
+    int i, c;
+    for(i=0;i<num_bytes;i++){
+        c = fgetc(f);
+        if(c == EOF){
+            return 0;
+        }
+        v |= ((unsigned long long) c) << (8*i);
+    }
+    return v;
+}
+
+/*
+ * Encode n samples of buf into W->enc. Returns the number of bytes.
+ */
+long mcs_wave_encode(mcs_wave* W, double* buf, long n){
+    long cols = W->num_sig + 1;
+    long i, pos = 0;
+    unsigned long long bits, d;
+    int b, nb;
+    for(i=0;i<n*cols;i++){
+        memcpy(&bits,&(buf[i]),sizeof(double));
+        if(W->flags[i % cols] & MCS_WAVE_DELTA){
+            d = bits ^ W->prev[i % cols];
+            W->prev[i % cols] = bits;
+            nb = 0;
+            while(nb < 8 && (d >> (8*nb)) != 0){
+                nb++;
+            }
+            W->enc[pos++] = (unsigned char) nb;
+        }else{
+            d = bits;
+            nb = 8;
+        }
+        for(b=0;b<nb;b++){
+            W->enc[pos++] = (unsigned char) ((d >> (8*b)) & 0xFF);
+        }
+    }
+    return pos;
+}
+
+/*
+ * Body of the writer thread. Waits for a full buffer, encodes it, and
+ * writes it out until the file is closed.
+ */
+void* mcs_wave_writer(void* arg){
+    mcs_wave* W = (mcs_wave*) arg;
+    long nbytes;
+    int idx;
+    pthread_mutex_lock(&(W->lock));
+    while(1){
+        while(!W->pending && !W->done){
+            pthread_cond_wait(&(W->cond),&(W->lock));
+        }
+        if(!W->pending){
+            break;
+        }
+        idx = 1 - W->active;
+        pthread_mutex_unlock(&(W->lock));
+        //The solver never touches buffer idx while pending is set.
+        //Only this thread sets err until mcs_wave_close joins it.
+        if(!W->err){
+            nbytes = mcs_wave_encode(W,W->buf[idx],W->fill[idx]);
+            mcs_wave_put(W->out,(unsigned long long) W->fill[idx],4);
+            mcs_wave_put(W->out,(unsigned long long) nbytes,4);
+            if(fwrite(W->enc,1,nbytes,W->out) != (size_t) nbytes ||
+               ferror(W->out)){
+                W->err = 1;
+            }
+        }
+        pthread_mutex_lock(&(W->lock));
+        W->fill[idx] = 0;
+        W->pending = 0;
+        pthread_cond_broadcast(&(W->cond));
+    }
+    pthread_mutex_unlock(&(W->lock));
+    return NULL;
+}
+
+/*
+ * Hand the active buffer to the writer thread and switch to the other one.
+ */
+void mcs_wave_flush(mcs_wave* W){
+    pthread_mutex_lock(&(W->lock));
+    while(W->pending){
+        pthread_cond_wait(&(W->cond),&(W->lock));
+    }
+    W->active = 1 - W->active;
+    W->pending = 1;
+    pthread_cond_broadcast(&(W->cond));
+    pthread_mutex_unlock(&(W->lock));
+}
+
+int mcs_wave_open(mcs_wave** W,
+                  const char* filename,
+                  mcs_mna* M,
+                  long num_sig,
+                  long* sig,
+                  int flags,
+                  int* sig_flags,
+                  long buf_len,
+                  mcs_status* st){
+    static const char w_only[3] = "wb";
+    char name[MCS_NETLIST_LINE_LEN+1];
+    mcs_wave* T;
+    long j, len;
+    FILE* out = fopen(filename,w_only);
+    *W = NULL;
+    if(out == NULL){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    T = (mcs_wave*) malloc(sizeof(mcs_wave));
+    T->out = out;
+    if(sig == NULL){
+        num_sig = M->dim;
+    }
+    if(buf_len <= 0){
+        buf_len = MCS_WAVE_BUF_LEN;
+    }
+    T->num_sig = num_sig;
+    T->sig = (long*) malloc(sizeof(long)*(num_sig+1));
+    for(j=0;j<num_sig;j++){
+        T->sig[j] = (sig == NULL) ? j : sig[j];
+    }
+    T->flags = (int*) malloc(sizeof(int)*(num_sig+1));
+    T->flags[0] = flags;
+    for(j=0;j<num_sig;j++){
+        T->flags[j+1] = (sig_flags == NULL) ? flags : sig_flags[j];
+    }
+    T->buf_len = buf_len;
+    T->buf[0] = (double*) malloc(sizeof(double)*(num_sig+1)*buf_len);
+    T->buf[1] = (double*) malloc(sizeof(double)*(num_sig+1)*buf_len);
+    T->fill[0] = 0;
+    T->fill[1] = 0;
+    T->active = 0;
+    T->pending = 0;
+    T->done = 0;
+    T->prev = (unsigned long long*)
+                    malloc(sizeof(unsigned long long)*(num_sig+1));
+    for(j=0;j<=num_sig;j++){
+        T->prev[j] = 0;
+    }
+    T->enc = (unsigned char*) malloc(9*(num_sig+1)*buf_len);
+    //header
+    fwrite(MCS_WAVE_MAGIC,1,8,T->out);
+    mcs_wave_put(T->out,MCS_WAVE_VERSION,4);
+    mcs_wave_put(T->out,(unsigned long long) flags,4);
+    mcs_wave_put(T->out,(unsigned long long) num_sig,8);
+    for(j=0;j<num_sig;j++){
+        mcs_mna_unknown_name(M,T->sig[j],name);
+        len = strlen(name);
+        mcs_wave_put(T->out,(unsigned long long) len,1);
+        fwrite(name,1,len,T->out);
+        mcs_wave_put(T->out,(unsigned long long) T->flags[j+1],1);
+    }
+    T->err = ferror(T->out) ? 1 : 0;
+    pthread_mutex_init(&(T->lock),NULL);
+    pthread_cond_init(&(T->cond),NULL);
+    pthread_create(&(T->writer),NULL,&mcs_wave_writer,T);
+    *W = T;
+    return 0;
+}
+
+void mcs_wave_write(mcs_wave* W, double t, double* x){
+    double* row;
+    long j;
+    row = &(W->buf[W->active][(W->num_sig+1)*W->fill[W->active]]);
+    row[0] = t;
+    for(j=0;j<W->num_sig;j++){
+        row[j+1] = x[W->sig[j]];
+    }
+    W->fill[W->active]++;
+    if(W->fill[W->active] == W->buf_len){
+        mcs_wave_flush(W);
+    }
+}
+
+int mcs_wave_close(mcs_wave** W, mcs_status* st){
+    mcs_wave* T = *W;
+    int err;
+    if(T->fill[T->active] > 0){
+        mcs_wave_flush(T);
+    }
+    pthread_mutex_lock(&(T->lock));
+    T->done = 1;
+    pthread_cond_broadcast(&(T->cond));
+    pthread_mutex_unlock(&(T->lock));
+    pthread_join(T->writer,NULL);
+    pthread_cond_destroy(&(T->cond));
+    pthread_mutex_destroy(&(T->lock));
+    err = T->err;
+    if(fclose(T->out) != 0){
+        err = 1;
+    }
+    free(T->enc);
+    free(T->prev);
+    free(T->buf[1]);
+    free(T->buf[0]);
+    free(T->flags);
+    free(T->sig);
+    free(T);
+    *W = NULL;
+    if(err){
+        return mcs_raise(st,MCS_FILE_WRITE);
+    }
+    return 0;
+}
+
+void mcs_wave_load(const char* filename,
+                   long* num_sig,
+                   long* num_samples,
+                   double** data){
+    mcs_wave_load_r(filename,num_sig,num_samples,data,NULL);
+}
+
+int mcs_wave_load_r(const char* filename,
+                    long* num_sig,
+                    long* num_samples,
+                    double** data,
+                    mcs_status* st){
+    static const char r_only[3] = "rb";
+    char magic[8];
+    unsigned long long bits, d;
+    unsigned long long* prev;
+    int* flags;
+    long cols, cap, n, i, nb, b, size, nbytes, start;
+    int c, err = 0;
+    FILE* in = fopen(filename,r_only);
+    *data = NULL;
+    if(in == NULL){
+        return mcs_raise(st,FILE_READ_ONLY);
+    }
+    fseek(in,0,SEEK_END);
+    size = ftell(in);
+    rewind(in);
+    if(fread(magic,1,8,in) != 8 || memcmp(magic,MCS_WAVE_MAGIC,8) != 0 ||
+       mcs_wave_get(in,4) != MCS_WAVE_VERSION){
+        fclose(in);
+        return mcs_raise(st,MCS_WAVE_FMT);
+    }
+    c = (int) mcs_wave_get(in,4);
+    *num_sig = (long) mcs_wave_get(in,8);
+    //every signal takes at least two bytes of the header
+    if(*num_sig < 0 || *num_sig > size/2){
+        fclose(in);
+        return mcs_raise(st,MCS_WAVE_FMT);
+    }
+    cols = *num_sig + 1;
+    flags = (int*) malloc(sizeof(int)*cols);
+    flags[0] = c;
+    for(i=0;i<*num_sig;i++){
+        fseek(in,(long) mcs_wave_get(in,1),SEEK_CUR);
+        flags[i+1] = fgetc(in);
+    }
+    if(ftell(in) > size || (cols > 1 && flags[cols-1] == EOF)){
+        free(flags);
+        fclose(in);
+        return mcs_raise(st,MCS_WAVE_FMT);
+    }
+    prev = (unsigned long long*) malloc(sizeof(unsigned long long)*cols);
+    for(i=0;i<cols;i++){
+        prev[i] = 0;
+    }
+    cap = MCS_WAVE_BUF_LEN;
+    *data = (double*) malloc(sizeof(double)*cols*cap);
+    *num_samples = 0;
+    while(!err && (n = (long) mcs_wave_get(in,4)) > 0){
+        nbytes = (long) mcs_wave_get(in,4);
+        start = ftell(in);
+        //every value takes at least one byte of the payload
+        if(nbytes > size-start || n > nbytes/cols){
+            err = 1;
+            break;
+        }
+        while(*num_samples + n > cap){
+            cap *= 2;
+            *data = (double*) realloc(*data,sizeof(double)*cols*cap);
+        }
+        for(i=0;i<n*cols && !err;i++){
+            nb = (flags[i % cols] & MCS_WAVE_DELTA) ? fgetc(in) : 8;
+            if(nb < 0 || nb > 8){
+                err = 1;
+            }
+            d = 0;
+            for(b=0;b<nb && !err;b++){
+                c = fgetc(in);
+                if(c == EOF){
+                    err = 1;
+                }
+                d |= ((unsigned long long) c) << (8*b);
+            }
+            if(flags[i % cols] & MCS_WAVE_DELTA){
+                bits = d ^ prev[i % cols];
+                prev[i % cols] = bits;
+            }else{
+                bits = d;
+            }
+            memcpy(&((*data)[(*num_samples)*cols + i]),&bits,sizeof(double));
+        }
+        if(ftell(in) != start+nbytes){
+            err = 1;
+        }
+        *num_samples += n;
+    }
+    free(prev);
+    free(flags);
+    fclose(in);
+    if(err){
+        free(*data);
+        *data = NULL;
+        return mcs_raise(st,MCS_WAVE_FMT);
+    }
+    return 0;
+}
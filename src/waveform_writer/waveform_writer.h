@@ -0,0 +1,142 @@
+#ifndef MCS_WAVEFORM_WRITER_H
+#define MCS_WAVEFORM_WRITER_H
+
+/*
+ * Streaming binary waveform output for MicroCircSim by Bram Rodgers.
+ *
+ * A solver hands each time point to mcs_wave_write, which only copies the
+ * recorded signals into one of two buffers. When a buffer fills up it is
+ * handed to a background thread which encodes it and writes it to disk
+ * while the solver keeps filling the other buffer.
+ *
+ * File format, with all integers little endian:
+ * ->Header
+ *  |->8 bytes: MCS_WAVE_MAGIC
+ *  |->uint32: MCS_WAVE_VERSION
+ *  |->uint32: flags of the time column. Bit 0 set means it is delta
+ *  |          compressed.
+ *  |->uint64: number of signals, num_sig
+ *  |->For each signal, a uint8 name length followed by the name, then
+ *  |  a uint8 of flags for that signal, with the same bits.
+ * ->Any number of blocks
+ *  |->uint32: number of samples in the block
+ *  |->uint32: number of payload bytes in the block
+ *  |->Payload. Each sample is the time followed by the num_sig signals.
+ *
+ * An uncompressed column stores every value as a little endian double.
+ * A delta compressed column stores every value as the exclusive or of
+ * its bits with the bits of the previous value in the same column. The
+ * result is written as a count byte followed by that many of its low
+ * order bytes, so slowly changing signals take few bytes, while noisy
+ * signals are better left uncompressed. Compression is lossless. The
+ * previous values are zero at the start of the file.
+ *
+ * Original Draft Dated: 19, Oct 2026
+ */
+
+/*
+ * Header File Body:
+ */
+
+/*
+ * Macros and Includes go here.
+ */
+#include<stdlib.h>
+#include<stdio.h>
+#include<pthread.h>
+#include"../mna_system/mna_system.h"
+#include"../error_handling/error_handling.h"
+
+#define MCS_WAVE_MAGIC      "MCSWAVE"
+#define MCS_WAVE_VERSION    2
+#define MCS_WAVE_DELTA      1     /*Flag bit for delta compression*/
+#define MCS_WAVE_BUF_LEN    4096  /*Default number of samples per buffer*/
+
+/*
+ * Object and Struct Definitions:
+ */
+
+typedef struct _mcs_wave{
+    FILE* out;                  /*The open waveform file*/
+    long num_sig;               /*Number of recorded signals*/
+    long* sig;                  /*Unknown index of each recorded signal*/
+    int* flags;                 /*Format flags of each column, time first*/
+    long buf_len;               /*Number of samples per buffer*/
+    double* buf[2];             /*Sample buffers, (num_sig+1)*buf_len each*/
+    long fill[2];               /*Number of samples in each buffer*/
+    int active;                 /*Buffer which mcs_wave_write fills*/
+    int pending;                /*1 while the other buffer awaits writing*/
+    int done;                   /*1 once the file is being closed*/
+    int err;                    /*1 once a write to out has failed*/
+    unsigned long long* prev;   /*Previous bits of each column*/
+    unsigned char* enc;         /*Encoded block, owned by the writer*/
+    pthread_t writer;           /*Background writer thread*/
+    pthread_mutex_t lock;       /*Guards pending and done*/
+    pthread_cond_t cond;        /*Signals changes of pending and done*/
+} mcs_wave;
+
+/*
+ * Function Declarations:
+ */
+
+/*
+ * Open a waveform file and start its writer thread.
+ *
+ * sig lists the num_sig unknowns of M which are recorded. If sig is NULL
+ * then all M->dim unknowns are recorded. Names come from
+ * mcs_mna_unknown_name. flags is 0 or MCS_WAVE_DELTA, and applies to the
+ * time column. sig_flags[j] are the flags of signal j, or if sig_flags
+ * is NULL every signal has flags. buf_len is the number of samples per
+ * buffer, or 0 for MCS_WAVE_BUF_LEN.
+ *
+ * Returns 0. If the file can not be opened, then returns 1 with *W set
+ * to NULL after recording MCS_FILE_WRITE in st. If st is NULL then
+ * mcs_error is called instead.
+ */
+int mcs_wave_open(mcs_wave** W,
+                  const char* filename,
+                  mcs_mna* M,
+                  long num_sig,
+                  long* sig,
+                  int flags,
+                  int* sig_flags,
+                  long buf_len,
+                  mcs_status* st);
+
+/*
+ * Record the signals of the solution x at time t. Only blocks if both
+ * buffers are full, meaning the disk is slower than the solver.
+ */
+void mcs_wave_write(mcs_wave* W, double t, double* x);
+
+/*
+ * Write any buffered samples, stop the writer thread, and close the file.
+ * *W is freed either way. Returns 0, or 1 after recording MCS_FILE_WRITE
+ * in st if any write to the file or closing it failed. If st is NULL then
+ * mcs_error is called instead.
+ */
+int mcs_wave_close(mcs_wave** W, mcs_status* st);
+
+/*
+ * Read a whole waveform file. On exit *data holds num_samples rows of
+ * (num_sig+1) doubles, each row being the time followed by the signals.
+ * *data is allocated with malloc and must be freed by the caller.
+ * Exits the process if the file can not be read.
+ */
+void mcs_wave_load(const char* filename,
+                   long* num_sig,
+                   long* num_samples,
+                   double** data);
+
+/*
+ * Version of mcs_wave_load which returns 0 on success, or 1 with *data
+ * set to NULL after recording FILE_READ_ONLY or MCS_WAVE_FMT in st. A
+ * file which ends inside a block is an error.
+ */
+int mcs_wave_load_r(const char* filename,
+                    long* num_sig,
+                    long* num_samples,
+                    double** data,
+                    mcs_status* st);
+
+#endif